@@ -9,11 +9,11 @@ layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
 
 void main()
 {
-	// Compute the coordinates of the current ray
-	const ivec2 rayGridCoord = ivec2(gl_GlobalInvocationID.xy);
+	// Compute the coordinates of the current ray (the grid is traced in bands of rows, starting at entry iGridStartID)
+	const ivec2 rayGridCoord = ivec2(gl_GlobalInvocationID.xy) + ivec2(0, sGhostParameters.iGridStartID / sGhostParameters.iRayCount);
 
-	// Skip if we are outside the actual image
-	if (any(greaterThanEqual(rayGridCoord, ivec2(sGhostParameters.iRayCount))))
+	// Skip if we are outside the actual image, or past the last row of the band (the output buffer only holds the band)
+	if (any(greaterThanEqual(rayGridCoord, ivec2(sGhostParameters.iRayCount))) || int(gl_GlobalInvocationID.y) >= sGhostParameters.iNumGridRows)
 		return;
 
 	// Spawn a ray on the input ray grid for this shader invocation
@@ -57,6 +57,6 @@ void main()
 	result.fClipFactor = tracedRay.clipFactor;
 
 	// Store the result in the output buffer
-	const int outputBufferID = rayGridCoord.y * sGhostParameters.iRayCount + rayGridCoord.x;
+	const int outputBufferID = int(gl_GlobalInvocationID.y) * sGhostParameters.iRayCount + rayGridCoord.x;
 	sGhostGeometryData.sGhostGeometries[outputBufferID] = result;
 }
\ No newline at end of file
@@ -40,7 +40,7 @@ void main()
         discard;
     
     // Write out the final color
-    const vec3 color = lambda2RGB(sLensFlareLensData.vWavelengths[sGhostParameters.iChannelID].x, 1.0); 
+    const vec3 color = lambda2RGB(sLensFlareLensData.vWavelengths[sGhostParameters.iChannelID].x, 1.0) * sLensFlareLensData.vWavelengths[sGhostParameters.iChannelID].y; 
     colorBuffer.rgb = color * intensity * sLensFlareLensData.vColor;
     colorBuffer.a = 1.0;
 
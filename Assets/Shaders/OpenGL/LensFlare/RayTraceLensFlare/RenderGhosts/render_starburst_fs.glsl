@@ -0,0 +1,33 @@
+#version 440
+
+// Includes
+#include <Shaders/OpenGL/Common/common.glsl>
+
+// Starburst parameters
+layout (location = 2) uniform vec3 vColor;
+
+// Aperture diffraction texture
+layout (binding = TEXTURE_POST_PROCESS_2) uniform sampler2D sApertureFFT;
+
+// Inputs
+in vec2 vUv;
+
+// Framebuffer
+out vec4 colorBuffer;
+
+// Size of the diffraction pattern of each channel, relative to green; the pattern scales with the wavelength
+const vec3 WAVELENGTH_SCALES = vec3(650.0, 550.0, 450.0) / 550.0;
+
+void main()
+{
+    // Sample the diffraction pattern for each channel
+    vec3 starburst;
+    for (int channel = 0; channel < 3; ++channel)
+        starburst[channel] = texture(sApertureFFT, (vUv - 0.5) / WAVELENGTH_SCALES[channel] + 0.5).r;
+
+    // Fade out towards the edges of the quad
+    const float falloff = smoothstep(1.0, 0.8, length(vUv * 2.0 - 1.0));
+
+    // Write out the final color
+    colorBuffer = vec4(starburst * falloff * vColor, 1.0);
+}
\ No newline at end of file
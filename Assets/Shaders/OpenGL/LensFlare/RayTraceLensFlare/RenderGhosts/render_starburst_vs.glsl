@@ -0,0 +1,22 @@
+#version 440
+
+// Includes
+#include <Shaders/OpenGL/Common/common.glsl>
+
+// Starburst parameters
+layout (location = 0) uniform vec2 vCenter;
+layout (location = 1) uniform vec2 vHalfSize;
+
+// Outputs
+out vec2 vUv;
+
+void main()
+{
+    // Corners of the two triangles making up the quad
+    const vec2 corners[6] = vec2[](vec2(-1, -1), vec2(1, -1), vec2(1, 1), vec2(-1, -1), vec2(1, 1), vec2(-1, 1));
+    const vec2 corner = corners[gl_VertexID];
+
+    // Write out the output values
+    vUv = corner * 0.5 + 0.5;
+    gl_Position = vec4(vCenter + corner * vHalfSize, 0, 1);
+}
\ No newline at end of file
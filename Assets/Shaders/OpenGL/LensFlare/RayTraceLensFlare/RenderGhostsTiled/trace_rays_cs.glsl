@@ -144,7 +144,7 @@ GhostSinglePrimitive createPrimitive(const ivec4 vertIds)
         result.vSensorPos[i] = groupRays[vertIds[i]].vSensorPos;
         result.vSensorValues[i] = vec2(groupRays[vertIds[i]].fIntensity, groupRays[vertIds[i]].fClipFactor);
     }
-    result.vColor = lambda2RGB(sLensFlareLensData.vWavelengths[sGhostParameters.iChannelID].x, 1.0) * sLensFlareLensData.vColor;
+    result.vColor = lambda2RGB(sLensFlareLensData.vWavelengths[sGhostParameters.iChannelID].x, 1.0) * sLensFlareLensData.vWavelengths[sGhostParameters.iChannelID].y * sLensFlareLensData.vColor;
     return result;
 }
 
@@ -65,10 +65,87 @@ Intersection intersectSphere(const Lens lens, const Ray ray)
     return i;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Maximum number of Newton iterations for aspheric surfaces
+#ifndef ASPHERIC_MAX_ITERATIONS
+#define ASPHERIC_MAX_ITERATIONS 8
+#endif
+
+// Maximum allowed distance from the aspheric surface along the optical axis
+#ifndef ASPHERIC_TOLERANCE
+#define ASPHERIC_TOLERANCE 1e-5
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Whether the lens has an aspheric profile
+bool isAspheric(const Lens lens)
+{
+    return lens.conic != 0.0 || any(notEqual(lens.aspheric, vec4(0.0)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Evaluates the sag of an aspheric surface (x) and its derivative (y) with respect to the squared radial distance
+vec2 asphericSag(const Lens lens, const float r2)
+{
+    const float c = lens.radius == 0.0 ? 0.0 : 1.0 / lens.radius;
+    const float q = sqrt(max(1.0 - (1.0 + lens.conic) * c * c * r2, 1e-8));
+    const vec4 r2n = vec4(r2 * r2, r2 * r2 * r2, r2 * r2 * r2 * r2, r2 * r2 * r2 * r2 * r2);
+    const vec4 dr2n = vec4(2.0 * r2, 3.0 * r2 * r2, 4.0 * r2 * r2 * r2, 5.0 * r2 * r2 * r2 * r2);
+    return vec2(
+        c * r2 / (1.0 + q) + dot(lens.aspheric, r2n),
+        c / (2.0 * q) + dot(lens.aspheric, dr2n));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Performs a ray-asphere intersection, refining the base sphere hit with Newton's method
+Intersection intersectAsphere(const Lens lens, const Ray ray)
+{
+    // Use the base sphere (or plane) as the initial guess
+    Intersection i = (lens.radius == 0.0) ? intersectPlane(lens, ray) : intersectSphere(lens, ray);
+    if (!i.hit) return i;
+    
+    // Vertex position along the optical axis
+    const float vertex = lens.center.z - lens.radius;
+    
+    // Refine the ray parameter
+    float t = dot(i.pos - ray.pos, ray.dir);
+    vec2 sag = vec2(0.0);
+    for (int iteration = 0; iteration < ASPHERIC_MAX_ITERATIONS; ++iteration)
+    {
+        const vec3 pos = ray.pos + t * ray.dir;
+        sag = asphericSag(lens, dot(pos.xy, pos.xy));
+        const float f = pos.z - vertex - sag.x;
+        if (abs(f) < ASPHERIC_TOLERANCE) break;
+        const float df = ray.dir.z - sag.y * 2.0 * dot(pos.xy, ray.dir.xy);
+        if (abs(df) < 1e-8) { i.hit = false; return i; }
+        t -= f / df;
+    }
+    
+    // Make sure the refined point lies on the surface and is within the conic's domain
+    i.pos = ray.pos + t * ray.dir;
+    const float r2 = dot(i.pos.xy, i.pos.xy);
+    const float c = lens.radius == 0.0 ? 0.0 : 1.0 / lens.radius;
+    if ((1.0 + lens.conic) * c * c * r2 >= 1.0 || abs(i.pos.z - vertex - asphericSag(lens, r2).x) > ASPHERIC_TOLERANCE * 100.0)
+    {
+        i.hit = false;
+        return i;
+    }
+    
+    // Surface normal from the gradient of the implicit surface, facing the incoming ray
+    sag = asphericSag(lens, r2);
+    i.normal = normalize(vec3(-2.0 * i.pos.xy * sag.y, 1.0));
+    if (dot(i.normal, ray.dir) > 0.0) i.normal = -i.normal;
+    i.theta = acos(dot(-ray.dir, i.normal));
+    i.hit = true;
+    
+    return i;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Perform the appropriate intersection with the lens
 Intersection intersectLens(const Lens lens, const Ray ray)
 {
+    if (isAspheric(lens)) return intersectAsphere(lens, ray);
     return (lens.radius == 0.0) ? intersectPlane(lens, ray) : intersectSphere(lens, ray);
 }
 
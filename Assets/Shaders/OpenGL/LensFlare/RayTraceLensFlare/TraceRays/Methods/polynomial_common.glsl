@@ -27,6 +27,7 @@
 #define POLYNOMIAL_INPUT_3 pupilCoordinatesPolarInverted.x
 #define POLYNOMIAL_INPUT_4 POLYNOMIAL_INPUT_ANGLE(angle)
 #define POLYNOMIAL_INPUT_5 wavelength * 1e-3
+#define POLYNOMIAL_INPUT_6 sLensFlareLensData.fZoomPosition
 
 #define POLYNOMIAL_INPUTS_1 { POLYNOMIAL_INPUT_0 }
 #define POLYNOMIAL_INPUTS_2 { POLYNOMIAL_INPUT_0, POLYNOMIAL_INPUT_1}
@@ -52,7 +53,7 @@
 #define POLYNOMIAL_TERMS_TO_BAKE_4(DEGREES) DEGREES[NUM_INPUT_VARIABLES_BAKED + 0], DEGREES[NUM_INPUT_VARIABLES_BAKED + 1], DEGREES[NUM_INPUT_VARIABLES_BAKED + 2], DEGREES[NUM_INPUT_VARIABLES_BAKED + 3]
 
 // Full, non-baked
-#define NUM_INPUT_VARIABLES_FULL 6
+#define NUM_INPUT_VARIABLES_FULL 7
 #define NUM_OUTPUT_VARIABLES_FULL 6
 #define NUM_WAVELENGTHS_FULL 3
 #define GHOST_TERMS_BUFFER_FULL sGhostWeightsBufferFull
@@ -62,13 +63,13 @@
 
 // Partial, baked
 #define NUM_INPUT_VARIABLES_BAKED 4
-#define NUM_INPUT_VARIABLES_TO_BAKE 2
+#define NUM_INPUT_VARIABLES_TO_BAKE 3
 #define NUM_OUTPUT_VARIABLES_BAKED NUM_OUTPUT_VARIABLES_FULL
 #define NUM_WAVELENGTHS_BAKED NUM_WAVELENGTHS_FULL
 #define GHOST_TERMS_BUFFER_BAKED sGhostWeightsBufferBaked
 #define GHOST_TERMS_START_ID_BUFFER_BAKED ((ghostId * NUM_WAVELENGTHS_BAKED + wavelengthId) * NUM_POLYNOMIAL_TERMS)
 #define MONOMIAL_TYPE_BAKED MonomialBaked
-#define POLYNOMIAL_INPUTS_BAKE { POLYNOMIAL_INPUT_ANGLE(sLensFlareLensData.fLightAngle), sLensFlareLensData.vWavelengths[wavelengthId].x * 1e-3 }
+#define POLYNOMIAL_INPUTS_BAKE { POLYNOMIAL_INPUT_ANGLE(sLensFlareLensData.fLightAngle), sLensFlareLensData.vWavelengths[wavelengthId].x * 1e-3, sLensFlareLensData.fZoomPosition }
 #define POLYNOMIAL_INPUT_BAKED CONCAT(POLYNOMIAL_INPUTS_, NUM_INPUT_VARIABLES_BAKED)
 #define POLYNOMIAL_TERMS_TO_BAKE CONCAT(POLYNOMIAL_TERMS_TO_BAKE_, NUM_INPUT_VARIABLES_TO_BAKE)
 
@@ -271,6 +272,7 @@ INSTANTIATE_SPOWPROD(3)
 INSTANTIATE_SPOWPROD(4)
 INSTANTIATE_SPOWPROD(5)
 INSTANTIATE_SPOWPROD(6)
+INSTANTIATE_SPOWPROD(7)
 
 ////////////////////////////////////////////////////////////////////////////////
 // Evaluation
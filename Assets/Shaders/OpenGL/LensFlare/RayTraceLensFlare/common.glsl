@@ -27,6 +27,12 @@ struct Lens
     
     // Aperture height
     float aperture;
+    
+    // Conic constant of aspheric surfaces
+    float conic;
+    
+    // 4th, 6th, 8th and 10th order aspheric deformation coefficients
+    vec4 aspheric;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -82,6 +88,7 @@ struct GhostParameters
     
     int iGridStartID;
     int iNumPolynomialTerms;
+    int iNumGridRows;
 };
 
 // Ghost geometry output buffer
@@ -117,8 +124,9 @@ layout (std140, binding = UNIFORM_BUFFER_GENERIC_2) uniform RayTraceLensFlareUni
     vec2 vFilmSize;
 
     int iNumLenses;
+    float fZoomPosition;
     
-    vec4 vWavelengths[MAX_CHANNELS];
+    vec4 vWavelengths[MAX_CHANNELS]; // x: wavelength, y: spectral weight
     Lens sLenses[MAX_CHANNELS][MAX_LENSES];
 } sLensFlareLensData;
 
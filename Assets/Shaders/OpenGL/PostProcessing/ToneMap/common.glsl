@@ -63,6 +63,24 @@ vec2 extractLuminance(const vec2 uv, const float mipLevel)
     return max(unpackLuminance(textureLodDR(sLuminance, uv, mipLevel).rg), sTonemapData.fMinAvgLuminance);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Histogram bin of a luminance value; bin 0 holds the (near) black pixels, the rest
+// cover the [fMinLogLuminance, fMinLogLuminance + fLogLuminanceRange] log2 luminance range
+uint getLuminanceHistogramBin(const float luminance, const float minLogLuminance, const float logLuminanceRange)
+{
+    if (luminance < 1e-5) return 0;
+    const float t = saturate((log2(luminance) - minLogLuminance) / logLuminanceRange);
+    return clamp(uint(t * float(LUMINANCE_HISTOGRAM_BINS - 1)) + 1u, 1u, uint(LUMINANCE_HISTOGRAM_BINS - 1));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Representative log2 luminance of a histogram bin
+float getLuminanceHistogramBinLogLuminance(const uint bin, const float minLogLuminance, const float logLuminanceRange)
+{
+    if (bin == 0) return minLogLuminance;
+    return minLogLuminance + (float(bin) - 0.5) / float(LUMINANCE_HISTOGRAM_BINS - 1) * logLuminanceRange;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Simple clamping fn.
 vec3 toneMapClamp(const vec3 color)
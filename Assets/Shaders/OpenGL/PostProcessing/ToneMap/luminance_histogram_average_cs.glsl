@@ -0,0 +1,67 @@
+#version 440
+
+// Includes
+#include <Shaders/OpenGL/Common/common.glsl>
+#include <Shaders/OpenGL/PostProcessing/ToneMap/common.glsl>
+
+layout (local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+
+// Input histogram
+UINT_ARRAY_BUFFER(std430, UNIFORM_BUFFER_GENERIC_2, sLuminanceHistogram_);
+#define sLuminanceHistogram sLuminanceHistogram_.sData
+
+// Output texture
+layout(binding = 0, rg16f) uniform writeonly image2D sLuminanceMip;
+
+// Histogram parameters
+layout (location = 0) uniform ivec2 vMipDimension;
+layout (location = 1) uniform uint uiMipLevel;
+layout (location = 2) uniform float fMinLogLuminance;
+layout (location = 3) uniform float fLogLuminanceRange;
+layout (location = 4) uniform float fLowPercentile;
+layout (location = 5) uniform float fHighPercentile;
+
+// Resulting (packed) average and max luminances
+shared vec2 sResult;
+
+void main()
+{
+    // Evaluate the histogram on a single thread; it only has a handful of bins
+    if (gl_LocalInvocationIndex == 0)
+    {
+        float numPixels = 0.0;
+        for (uint bin = 0; bin < LUMINANCE_HISTOGRAM_BINS; ++bin)
+            numPixels += float(sLuminanceHistogram[bin]);
+
+        // Average the log luminance of the pixels between the two percentiles
+        const float lowCount = numPixels * fLowPercentile;
+        const float highCount = numPixels * fHighPercentile;
+        float accumulated = 0.0;
+        float logLuminanceSum = 0.0;
+        float weightSum = 0.0;
+        float maxLogLuminance = fMinLogLuminance;
+        for (uint bin = 0; bin < LUMINANCE_HISTOGRAM_BINS; ++bin)
+        {
+            const float count = float(sLuminanceHistogram[bin]);
+            const float binLogLuminance = getLuminanceHistogramBinLogLuminance(bin, fMinLogLuminance, fLogLuminanceRange);
+            const float weight = max(min(accumulated + count, highCount) - max(accumulated, lowCount), 0.0);
+            logLuminanceSum += weight * binLogLuminance;
+            weightSum += weight;
+            if (count > 0.0 && accumulated < highCount) maxLogLuminance = binLogLuminance;
+            accumulated += count;
+        }
+        const float avgLuminance = exp2(weightSum > 0.0 ? logLuminanceSum / weightSum : fMinLogLuminance);
+        const float maxLuminance = exp2(maxLogLuminance);
+
+        // Adapt to the previous average luminance
+        const float lastLuminance = unpackLuminance(texelFetch(sLuminance, ivec2(0), int(uiMipLevel)).r);
+        sResult = vec2(computeAdaptedLuminance(avgLuminance, lastLuminance), packLuminance(maxLuminance));
+    }
+    memoryBarrierShared();
+    barrier();
+
+    // Write the result to every texel of the target mip level
+    const int numTexels = vMipDimension.x * vMipDimension.y;
+    for (int texelID = int(gl_LocalInvocationIndex); texelID < numTexels; texelID += int(gl_WorkGroupSize.x))
+        imageStore(sLuminanceMip, ivec2(texelID % vMipDimension.x, texelID / vMipDimension.x), vec4(sResult, 0.0, 0.0));
+}
\ No newline at end of file
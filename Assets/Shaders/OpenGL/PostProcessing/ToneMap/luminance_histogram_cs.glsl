@@ -0,0 +1,44 @@
+#version 440
+
+// Includes
+#include <Shaders/OpenGL/Common/common.glsl>
+#include <Shaders/OpenGL/PostProcessing/ToneMap/common.glsl>
+
+layout (local_size_x = 16, local_size_y = 16, local_size_z = 1) in;
+
+// Output histogram
+UINT_ARRAY_BUFFER(std430, UNIFORM_BUFFER_GENERIC_2, sLuminanceHistogram_);
+#define sLuminanceHistogram sLuminanceHistogram_.sData
+
+// Histogram parameters
+layout (location = 0) uniform ivec2 vResolution;
+layout (location = 1) uniform float fMinLogLuminance;
+layout (location = 2) uniform float fLogLuminanceRange;
+
+// Per-workgroup histogram
+shared uint sLocalHistogram[LUMINANCE_HISTOGRAM_BINS];
+
+void main()
+{
+    const uint numInvocations = gl_WorkGroupSize.x * gl_WorkGroupSize.y;
+
+    // Clear the local histogram
+    for (uint bin = gl_LocalInvocationIndex; bin < LUMINANCE_HISTOGRAM_BINS; bin += numInvocations)
+        sLocalHistogram[bin] = 0;
+    memoryBarrierShared();
+    barrier();
+
+    // Bin the luminance of the pixel
+    if (gl_GlobalInvocationID.x < vResolution.x && gl_GlobalInvocationID.y < vResolution.y)
+    {
+        const float luminance = max(computeLuminance(texelFetch(sScene, ivec3(gl_GlobalInvocationID.xy, 0), 0).rgb), 0.0);
+        atomicAdd(sLocalHistogram[getLuminanceHistogramBin(luminance, fMinLogLuminance, fLogLuminanceRange)], 1);
+    }
+    memoryBarrierShared();
+    barrier();
+
+    // Merge into the global histogram
+    for (uint bin = gl_LocalInvocationIndex; bin < LUMINANCE_HISTOGRAM_BINS; bin += numInvocations)
+        if (sLocalHistogram[bin] > 0)
+            atomicAdd(sLuminanceHistogram[bin], sLocalHistogram[bin]);
+}
\ No newline at end of file
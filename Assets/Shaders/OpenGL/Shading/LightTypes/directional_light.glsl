@@ -19,6 +19,11 @@ layout (std140, binding = UNIFORM_BUFFER_GENERIC_1) uniform LightData
     float fShadowMomentsBias;
     vec2 vShadowExponentialConstants;
     mat4 mLightTransform;
+    vec4 vLightUvTransform;
+    int iNumCascades;
+    vec4 vCascadeSplits;
+    mat4 mCascadeTransforms[MAX_SHADOW_CASCADES];
+    vec4 vCascadeUvTransforms[MAX_SHADOW_CASCADES];
 } sLightData;
 
 // Other base-pass related uniforms
@@ -31,13 +36,32 @@ vec4 computeDirectionalLight(const SurfaceInfo surface, const MaterialInfo mater
 {
     // Light-space position of the pixel
     const vec4 posLS = sLightData.mLightTransform * vec4(surface.position, 1.0);
-    const vec3 positionLS = ndcToScreen(posLS.xyz / posLS.w);
+    vec3 positionLS = ndcToScreen(posLS.xyz / posLS.w);
+    vec2 uv = sLightData.vLightUvTransform.xy + positionLS.xy * sLightData.vLightUvTransform.zw;
+    bool castsShadow = sLightData.fCastsShadow != 0.0;
+
+    // Select the cascade based on the view-space depth of the pixel
+    if (sLightData.iNumCascades > 0)
+    {
+        const float depthVS = -(sCameraData.mView * vec4(surface.position, 1.0)).z;
+        int cascadeId = 0;
+        while (cascadeId < sLightData.iNumCascades - 1 && depthVS > sLightData.vCascadeSplits[cascadeId])
+            ++cascadeId;
+
+        // Light-space position in the cascade
+        const vec4 posCS = sLightData.mCascadeTransforms[cascadeId] * vec4(surface.position, 1.0);
+        positionLS = ndcToScreen(clamp(posCS.xyz / posCS.w, vec3(-1.0), vec3(1.0)));
+        uv = sLightData.vCascadeUvTransforms[cascadeId].xy + positionLS.xy * sLightData.vCascadeUvTransforms[cascadeId].zw;
+
+        // Points beyond the last cascade are not covered by the shadow map
+        castsShadow = castsShadow && depthVS <= sLightData.vCascadeSplits[sLightData.iNumCascades - 1];
+    }
 
     // Shadow map parameters
     ShadowParameters shadowParameters;
-    shadowParameters.uv = positionLS.xy;
+    shadowParameters.uv = uv;
     shadowParameters.depth = positionLS.z;
-    shadowParameters.castsShadow = sLightData.fCastsShadow != 0.0;
+    shadowParameters.castsShadow = castsShadow;
     shadowParameters.algorithm = sLightData.uiShadowMapAlgorithm;
     shadowParameters.smPrecision = sLightData.uiShadowMapPrecision;
     shadowParameters.depthBias = sLightData.fShadowDepthBias;
@@ -409,8 +409,7 @@ namespace Debug
         m_name(name),
 		m_nameUpper(name),
         m_colorCode(m_colorCode),
-        m_devices(devices.begin(), devices.end()),
-        m_newLine(true)
+        m_devices(devices.begin(), devices.end())
     {
 		std::transform(m_nameUpper.begin(), m_nameUpper.end(), m_nameUpper.begin(), [](unsigned char ch) { return std::toupper(ch); });
 	}
@@ -418,170 +417,397 @@ namespace Debug
 	////////////////////////////////////////////////////////////////////////////////
 	LogOutputRef::LogOutputRef(LogOutput& output, LogMessageSource const& source) :
 		m_ref(output),
-		m_lock(output.m_mutex),
 		m_source(source)
 	{
 		output << source;
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
-	void putColorCodeSuffix(Device& device, std::string const& colorCode)
+	// Asynchronous log writer implementation
+	namespace log_writer_impl
 	{
-		switch (device.m_deviceType)
+		////////////////////////////////////////////////////////////////////////////////
+		/** A single, fully composed log line. */
+		struct LogRecord
+		{
+			LogOutput* m_output = nullptr;
+			LogMessageSource m_source{ "", 0, "" };
+			size_t m_threadId = 0;
+			std::string m_region;
+			time_t m_date = 0;
+			std::string m_message;
+			bool m_hasPrefix = false;
+			bool m_newLine = true;
+		};
+
+		////////////////////////////////////////////////////////////////////////////////
+		/** Intrusive node of the record queue. */
+		struct LogRecordNode
+		{
+			std::atomic<LogRecordNode*> m_next{ nullptr };
+			LogRecord m_record;
+		};
+
+		////////////////////////////////////////////////////////////////////////////////
+		/** Lock-free multi-producer, single-consumer record queue (Vyukov's intrusive MPSC queue).
+			Producers only perform an atomic exchange; the writer thread is the only consumer. */
+		struct LogRecordQueue
+		{
+			LogRecordQueue() :
+				m_head(&m_stub),
+				m_tail(&m_stub)
+			{}
+
+			// Enqueues the param node; safe to call from any thread
+			void push(LogRecordNode* node)
+			{
+				node->m_next.store(nullptr, std::memory_order_relaxed);
+				LogRecordNode* prev = m_head.exchange(node, std::memory_order_acq_rel);
+				prev->m_next.store(node, std::memory_order_release);
+			}
+
+			// Dequeues the oldest node, or nullptr if the queue is empty or a push is in flight
+			LogRecordNode* pop()
+			{
+				LogRecordNode* tail = m_tail;
+				LogRecordNode* next = tail->m_next.load(std::memory_order_acquire);
+
+				// Skip the stub node
+				if (tail == &m_stub)
+				{
+					if (next == nullptr) return nullptr;
+					m_tail = next;
+					tail = next;
+					next = next->m_next.load(std::memory_order_acquire);
+				}
+
+				// Regular case: the tail has a successor
+				if (next != nullptr)
+				{
+					m_tail = next;
+					return tail;
+				}
+
+				// A producer swapped the head but hasn't linked it in yet
+				if (tail != m_head.load(std::memory_order_acquire)) return nullptr;
+
+				// Last element; re-insert the stub so the tail can be handed out
+				push(&m_stub);
+				next = tail->m_next.load(std::memory_order_acquire);
+				if (next != nullptr)
+				{
+					m_tail = next;
+					return tail;
+				}
+				return nullptr;
+			}
+
+			std::atomic<LogRecordNode*> m_head;
+			LogRecordNode* m_tail;
+			LogRecordNode m_stub;
+		};
+
+		////////////////////////////////////////////////////////////////////////////////
+		/** State of the background writer. */
+		struct LogWriter
+		{
+			~LogWriter();
+
+			// The record queue
+			LogRecordQueue m_queue;
+
+			// Number of enqueued and written records
+			std::atomic<size_t> m_numEnqueued{ 0 };
+			std::atomic<size_t> m_numWritten{ 0 };
+
+			// Whether the writer thread is running
+			std::atomic<bool> m_running{ false };
+
+			// Wakeup signal for the writer thread
+			std::mutex m_wakeMutex;
+			std::condition_variable m_wakeCondition;
+
+			// Guards the devices (and the in-memory buffers) against concurrent access
+			std::mutex m_deviceMutex;
+
+			// The writer thread itself
+			std::thread m_thread;
+		};
+
+		////////////////////////////////////////////////////////////////////////////////
+		LogWriter& logWriter()
 		{
-		case Device::Console:
-			device.m_stream.get() << "\033[m";
-			break;
+			static LogWriter s_logWriter;
+			return s_logWriter;
 		}
-	}
 
-	////////////////////////////////////////////////////////////////////////////////
-	void putLinePrefixConsole(Device& device, LogOutput& log)
-	{
-		device.m_stream.get() 
-			<< "\033[" << log.m_colorCode << "m" 
-			<< "[" << DateTime::getDateStringUtf8(DateTime::timeFormatDisplay()) << "]" 
-			<< "[" << Threading::currentThreadId() << "]" 
-			<< "[" << log.m_nameUpper << "]"
-			<< s_region[Threading::currentThreadId()] 
-			<< ": ";
-	}
+		////////////////////////////////////////////////////////////////////////////////
+		/** A line that is still being composed by the current thread. */
+		struct PendingLine
+		{
+			LogRecord m_record;
+			std::ostringstream m_stream;
+		};
 
-	////////////////////////////////////////////////////////////////////////////////
-	void putLinePrefixFile(Device& device, LogOutput& log)
-	{
-		device.m_stream.get() 
-			<< "[" << DateTime::getDateStringUtf8(DateTime::timeFormatDisplay()) << "]"
-			<< "[" << Threading::currentThreadId() << "]"
-			<< "[" << log.m_nameUpper << "]"
-			<< s_region[Threading::currentThreadId()] 
-			<< ": ";
-	}
+		////////////////////////////////////////////////////////////////////////////////
+		/** Per-thread lines under construction, one for each log output. */
+		PendingLine& pendingLine(LogOutput& log)
+		{
+			thread_local std::unordered_map<LogOutput*, PendingLine> s_pendingLines;
+			PendingLine& line = s_pendingLines[&log];
+			line.m_record.m_output = &log;
+			return line;
+		}
 
-	////////////////////////////////////////////////////////////////////////////////
-	void putLinePrefixInMemory(Device& device, LogOutput& log)
-	{
-		InMemoryLogBuffer* buffer = (InMemoryLogBuffer*)(device.m_stream.get().rdbuf());
-		InMemoryLogEntry* entry = &buffer->m_messages[buffer->m_outMessageId];
+		////////////////////////////////////////////////////////////////////////////////
+		void putLinePrefixConsole(Device& device, LogRecord const& record)
+		{
+			device.m_stream.get()
+				<< "\033[" << record.m_output->m_colorCode << "m"
+				<< "[" << DateTime::getDateStringUtf8(record.m_date, DateTime::timeFormatDisplay()) << "]"
+				<< "[" << record.m_threadId << "]"
+				<< "[" << record.m_output->m_nameUpper << "]"
+				<< record.m_region
+				<< ": ";
+		}
 
-		entry->m_dateEpoch = time(nullptr);
-		entry->m_date = DateTime::getDateStringUtf8(DateTime::dateFormatDisplay());
-		entry->m_sourceLog = log.m_name;
-		entry->m_threadId = std::to_string(Threading::currentThreadId());
-		entry->m_region = s_region[Threading::currentThreadId()];
-	}
+		////////////////////////////////////////////////////////////////////////////////
+		void putLinePrefixFile(Device& device, LogRecord const& record)
+		{
+			device.m_stream.get()
+				<< "[" << DateTime::getDateStringUtf8(record.m_date, DateTime::timeFormatDisplay()) << "]"
+				<< "[" << record.m_threadId << "]"
+				<< "[" << record.m_output->m_nameUpper << "]"
+				<< record.m_region
+				<< ": ";
+		}
 
-	////////////////////////////////////////////////////////////////////////////////
-	void putLinePrefix(Device& device, LogOutput& log)
-	{
-		switch (device.m_deviceType)
+		////////////////////////////////////////////////////////////////////////////////
+		void putLinePrefixInMemory(Device& device, LogRecord const& record)
 		{
-		case Device::Console:  putLinePrefixConsole(device, log); break;
-		case Device::File:     putLinePrefixFile(device, log); break;
-		case Device::InMemory: putLinePrefixInMemory(device, log); break;
+			InMemoryLogBuffer* buffer = (InMemoryLogBuffer*)(device.m_stream.get().rdbuf());
+			InMemoryLogEntry* entry = &buffer->m_messages[buffer->m_outMessageId];
+
+			entry->m_dateEpoch = record.m_date;
+			entry->m_date = DateTime::getDateStringUtf8(record.m_date, DateTime::dateFormatDisplay());
+			entry->m_sourceLog = record.m_output->m_name;
+			entry->m_threadId = std::to_string(record.m_threadId);
+			entry->m_region = record.m_region;
 		}
-	}
 
-	////////////////////////////////////////////////////////////////////////////////
-	/**  Writes out a log line prefix */
-	LogOutput& putLinePrefix(LogOutput& log)
-	{
-		// Write out the logger name and the color code prefix
-		if (log.m_newLine)
+		////////////////////////////////////////////////////////////////////////////////
+		void putLinePrefix(Device& device, LogRecord const& record)
 		{
-			for (auto const& device : log.m_devices)
+			switch (device.m_deviceType)
 			{
-				putLinePrefix(device, log);
+			case Device::Console:  putLinePrefixConsole(device, record); break;
+			case Device::File:     putLinePrefixFile(device, record); break;
+			case Device::InMemory: putLinePrefixInMemory(device, record); break;
 			}
-			log.m_newLine = false;
 		}
 
-		return log;
-	}
+		////////////////////////////////////////////////////////////////////////////////
+		void putLineSuffixConsole(Device& device, LogRecord const& record)
+		{
+			device.m_stream.get() << "\033[0m";
+			if (record.m_newLine) device.m_stream.get() << std::endl;
+		}
 
-	////////////////////////////////////////////////////////////////////////////////
-	void putLineSuffixConsole(Device& device, LogOutput& log, bool newLine)
-	{
-		device.m_stream.get() << "\033[0m";
-		if (newLine) device.m_stream.get() << std::endl;
-	}
+		////////////////////////////////////////////////////////////////////////////////
+		void putLineSuffixFile(Device& device, LogRecord const& record)
+		{
+			if (record.m_newLine) device.m_stream.get() << std::endl;
+		}
 
-	////////////////////////////////////////////////////////////////////////////////
-	void putLineSuffixFile(Device& device, LogOutput& log, bool newLine)
-	{
-		if (newLine) device.m_stream.get() << std::endl;
-	}
+		////////////////////////////////////////////////////////////////////////////////
+		void putLineSuffixInMemory(Device& device, LogRecord const& record)
+		{
+			InMemoryLogBuffer* buffer = (InMemoryLogBuffer*)(device.m_stream.get().rdbuf());
+			buffer->advance();
+		}
 
-	////////////////////////////////////////////////////////////////////////////////
-	void putLineSuffixInMemory(Device& device, LogOutput& log, bool newLine)
-	{
-		InMemoryLogBuffer* buffer = (InMemoryLogBuffer*)(device.m_stream.get().rdbuf());
-		buffer->advance();
+		////////////////////////////////////////////////////////////////////////////////
+		void putLineSuffix(Device& device, LogRecord const& record)
+		{
+			switch (device.m_deviceType)
+			{
+			case Device::Console:  putLineSuffixConsole(device, record); break;
+			case Device::File:     putLineSuffixFile(device, record); break;
+			case Device::InMemory: putLineSuffixInMemory(device, record); break;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		void putLineSourceInMemory(Device& device, LogMessageSource const& source)
+		{
+			InMemoryLogBuffer* buffer = (InMemoryLogBuffer*)(device.m_stream.get().rdbuf());
+			InMemoryLogEntry* entry = &buffer->m_messages[buffer->m_outMessageId];
+
+			entry->m_sourceFile = source.m_file;
+			entry->m_sourceLine = std::to_string(source.m_line);
+			entry->m_sourceFunction = source.m_function;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		void putLineSource(Device& device, LogMessageSource const& source)
+		{
+			switch (device.m_deviceType)
+			{
+			case Device::InMemory: putLineSourceInMemory(device, source); break;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		/** Writes out a single record to all the devices of its output; needs the device lock. */
+		void writeRecord(LogRecord const& record)
+		{
+			for (auto const& device : record.m_output->m_devices)
+			{
+				putLineSource(device, record.m_source);
+				if (record.m_hasPrefix) putLinePrefix(device, record);
+				device.get().m_stream.get() << record.m_message;
+				putLineSuffix(device, record);
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		/** Writes out every record that is currently in the queue. */
+		void drainQueue(LogWriter& writer)
+		{
+			std::lock_guard<std::mutex> lock(writer.m_deviceMutex);
+			while (LogRecordNode* node = writer.m_queue.pop())
+			{
+				writeRecord(node->m_record);
+				delete node;
+				writer.m_numWritten.fetch_add(1, std::memory_order_release);
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		/** Main loop of the writer thread. */
+		void writerMain(LogWriter& writer)
+		{
+			while (true)
+			{
+				// Write out everything we have so far
+				drainQueue(writer);
+
+				// Stop once requested; a last drain picks up the stragglers
+				if (writer.m_running.load(std::memory_order_acquire) == false)
+				{
+					drainQueue(writer);
+					break;
+				}
+
+				// Sleep until new records arrive; the timeout covers pushes that were still in flight
+				std::unique_lock<std::mutex> lock(writer.m_wakeMutex);
+				writer.m_wakeCondition.wait_for(lock, std::chrono::milliseconds(10), [&]()
+				{
+					return writer.m_running.load(std::memory_order_acquire) == false ||
+						writer.m_numWritten.load(std::memory_order_acquire) < writer.m_numEnqueued.load(std::memory_order_acquire);
+				});
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		void startWriter()
+		{
+			LogWriter& writer = logWriter();
+			if (writer.m_running.exchange(true)) return;
+			writer.m_thread = std::thread(writerMain, std::ref(writer));
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		void stopWriter()
+		{
+			LogWriter& writer = logWriter();
+			if (writer.m_running.exchange(false) == false) return;
+			writer.m_wakeCondition.notify_one();
+			if (writer.m_thread.joinable()) writer.m_thread.join();
+
+			// Catch records that were pushed during the shutdown
+			drainQueue(writer);
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		LogWriter::~LogWriter()
+		{
+			stopWriter();
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		/** Hands the param record over to the writer. */
+		void enqueueRecord(LogRecord&& record)
+		{
+			LogWriter& writer = logWriter();
+
+			// Write synchronously if the writer isn't running (e.g., during shutdown)
+			if (writer.m_running.load(std::memory_order_acquire) == false)
+			{
+				std::lock_guard<std::mutex> lock(writer.m_deviceMutex);
+				writeRecord(record);
+				return;
+			}
+
+			LogRecordNode* node = new LogRecordNode;
+			node->m_record = std::move(record);
+			writer.m_queue.push(node);
+			writer.m_numEnqueued.fetch_add(1, std::memory_order_release);
+			writer.m_wakeCondition.notify_one();
+		}
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
-	void putLineSuffix(Device& device, LogOutput& log, bool newLine)
+	std::ostream& pendingLineStream(LogOutput& log)
 	{
-		switch (device.m_deviceType)
-		{
-		case Device::Console:  putLineSuffixConsole(device, log, newLine); break;
-		case Device::File:     putLineSuffixFile(device, log, newLine); break;
-		case Device::InMemory: putLineSuffixInMemory(device, log, newLine); break;
-		}
+		return log_writer_impl::pendingLine(log).m_stream;
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
-	/**  Writes out a log line suffix */
-	LogOutput& putLineSuffix(LogOutput& log, bool newLine)
+	/**  Writes out a log line prefix */
+	LogOutput& putLinePrefix(LogOutput& log)
 	{
-		for (auto device : log.m_devices)
+		log_writer_impl::PendingLine& line = log_writer_impl::pendingLine(log);
+
+		// Capture the prefix attributes when the line starts
+		if (line.m_record.m_hasPrefix == false)
 		{
-			putLineSuffix(device, log, newLine);
+			line.m_record.m_hasPrefix = true;
+			line.m_record.m_date = time(nullptr);
+			line.m_record.m_threadId = Threading::currentThreadId();
+			line.m_record.m_region = s_region[Threading::currentThreadId()];
 		}
-		log.m_newLine = true;
 
 		return log;
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
-	void putLineSourceConsole(Device& device, LogMessageSource const& source)
-	{}
-
-	////////////////////////////////////////////////////////////////////////////////
-	void putLineSourceInMemory(Device& device, LogMessageSource const& source)
+	/**  Writes out a log line suffix */
+	LogOutput& putLineSuffix(LogOutput& log, bool newLine)
 	{
-		InMemoryLogBuffer* buffer = (InMemoryLogBuffer*)(device.m_stream.get().rdbuf());
-		InMemoryLogEntry* entry = &buffer->m_messages[buffer->m_outMessageId];
+		log_writer_impl::PendingLine& line = log_writer_impl::pendingLine(log);
 
-		entry->m_sourceFile = source.m_file;
-		entry->m_sourceLine = std::to_string(source.m_line);
-		entry->m_sourceFunction = source.m_function;
-	}
+		// Finalize the record
+		log_writer_impl::LogRecord record = line.m_record;
+		record.m_message = line.m_stream.str();
+		record.m_newLine = newLine;
 
-	////////////////////////////////////////////////////////////////////////////////
-	void putLineSourceFile(Device& device, LogMessageSource const& source)
-	{}
+		// Start a new line
+		line.m_stream.str("");
+		line.m_record.m_hasPrefix = false;
 
-	////////////////////////////////////////////////////////////////////////////////
-	/**  Writes out a log line source */
-	void putLineSource(Device& device, LogMessageSource const& source)
-	{
-		switch (device.m_deviceType)
-		{
-		case Device::Console:  putLineSourceConsole(device, source); break;
-		case Device::File:     putLineSourceFile(device, source); break;
-		case Device::InMemory: putLineSourceInMemory(device, source); break;
-		}
+		// Pass it to the writer; lines of the null log are simply dropped
+		if (&log != &logger_impl::log_null)
+			log_writer_impl::enqueueRecord(std::move(record));
+
+		return log;
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
 	/**  Writes out a log line source */
 	LogOutput& putLineSource(LogOutput& log, LogMessageSource const& source)
 	{
-		for (auto device : log.m_devices)
-		{
-			putLineSource(device, source);
-		}
+		log_writer_impl::pendingLine(log).m_record.m_source = source;
 
 		return log;
 	}
@@ -632,6 +858,8 @@ namespace Debug
 	////////////////////////////////////////////////////////////////////////////////
 	void enableLogDevice(bool enabled, LogOutput& outputRef, std::reference_wrapper<Device> const& paramDevice)
 	{
+		std::lock_guard<std::mutex> lock(log_writer_impl::logWriter().m_deviceMutex);
+
 		auto deviceRef = findDevice(outputRef, paramDevice);
 
 		if (enabled && deviceRef == outputRef.m_devices.end())
@@ -825,6 +1053,30 @@ namespace Debug
 		memoryChannels.m_warning = true;
 		memoryChannels.m_error = true;
 		setFileLogging(fileChannels);
+
+		// Start the background writer, and make sure it's flushed before the devices go away
+		log_writer_impl::startWriter();
+		std::atexit(log_writer_impl::stopWriter);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	void flushLogs()
+	{
+		log_writer_impl::LogWriter& writer = log_writer_impl::logWriter();
+
+		// Wait until the writer catches up with everything enqueued before this call
+		const size_t target = writer.m_numEnqueued.load(std::memory_order_acquire);
+		while (writer.m_running.load(std::memory_order_acquire) && writer.m_numWritten.load(std::memory_order_acquire) < target)
+		{
+			writer.m_wakeCondition.notify_one();
+			std::this_thread::yield();
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	std::unique_lock<std::mutex> lockLogDevices()
+	{
+		return std::unique_lock<std::mutex>(log_writer_impl::logWriter().m_deviceMutex);
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
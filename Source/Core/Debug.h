@@ -131,12 +131,6 @@ namespace Debug
 
 		// Output devices
 		std::vector<std::reference_wrapper<Device>> m_devices;
-	
-		// Internals
-		bool m_newLine;
-
-		// For synchronization
-		std::mutex m_mutex;
 	};
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -148,10 +142,13 @@ namespace Debug
 		operator LogOutput&() const { return m_ref.get(); }
 
 		std::reference_wrapper<LogOutput> m_ref;
-		std::unique_lock<std::mutex> m_lock;
 		LogMessageSource m_source;
 	};
 
+	////////////////////////////////////////////////////////////////////////////////
+	/** Stream of the line the calling thread is currently composing for the param log. */
+	std::ostream& pendingLineStream(LogOutput& log);
+
 	////////////////////////////////////////////////////////////////////////////////
 	/**  Writes out a log line prefix */
 	LogOutput& putLinePrefix(LogOutput& log);
@@ -169,8 +166,7 @@ namespace Debug
 	template<typename T>
 	LogOutput& putMessage(LogOutput& log, T const& val)
 	{
-		for (auto device : log.m_devices) 
-			device.get().m_stream.get() << val;
+		pendingLineStream(log) << val;
 		return log;
 	}
 
@@ -410,6 +406,14 @@ namespace Debug
 	////////////////////////////////////////////////////////////////////////////////
 	void initLogDevices();
 
+	////////////////////////////////////////////////////////////////////////////////
+	/** Blocks until every log line enqueued so far is written out to the devices. */
+	void flushLogs();
+
+	////////////////////////////////////////////////////////////////////////////////
+	/** Locks the log devices; hold it while reading the in-memory buffers. */
+	std::unique_lock<std::mutex> lockLogDevices();
+
 	////////////////////////////////////////////////////////////////////////////////
 	std::string formatText(std::string str);
 
@@ -420,6 +424,7 @@ namespace Debug
 	{ \
 		auto logFn = Debug::logger_impl::CONCAT(make_log_, LOG); \
 		logFn(__FILE__, __LINE__, __FUNCTION__) << Debug::FormattedMessage(__VA_ARGS__) << Debug::end; \
+		Debug::flushLogs(); \
 		exit(-1); \
 	} \
 
@@ -550,15 +550,13 @@ namespace std
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
-	template<typename C>
-	C random_samples(C const& container, const size_t num_samples)
+	template<typename C, typename G>
+	C random_samples(C const& container, const size_t num_samples, G&& gen)
 	{
 		// Early out if we have less samples than needed
 		if (container.size() <= num_samples) return container;
 
 		// Make a random set of indices
-		random_device rd;
-		mt19937 gen(rd());
 		vector<size_t> ids = iota<size_t>(container.size(), 0);
 		shuffle(ids.begin(), ids.end(), gen);
 
@@ -567,4 +565,12 @@ namespace std
 		transform(ids.begin(), ids.begin() + num_samples, result.begin(), [&](const size_t idx) { return container[idx]; });
 		return result;
 	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	template<typename C>
+	C random_samples(C const& container, const size_t num_samples)
+	{
+		random_device rd;
+		return random_samples(container, num_samples, mt19937(rd()));
+	}
 }
\ No newline at end of file
@@ -37,6 +37,8 @@
 #include <future>
 #include <mutex>
 #include <shared_mutex>
+#include <condition_variable>
+#include <atomic>
 #include <variant>
 #include <any>
 #include <functional>
@@ -104,6 +106,7 @@
 #include "glm/gtc/matrix_inverse.hpp"
 #include "glm/gtc/type_ptr.hpp"
 #include "glm/gtc/type_aligned.hpp"
+#include "glm/gtc/packing.hpp"
 #include "glm/gtx/transform.hpp"
 
 ////////////////////////////////////////////////////////////////////////////////
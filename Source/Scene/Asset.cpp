@@ -126,56 +126,95 @@ namespace Asset
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
-	std::optional<std::ordered_pairs_in_blocks> loadPairsInBlocks(Scene::Scene& scene, const std::string& fileName)
+	namespace pairs_in_blocks_impl
 	{
-		Debug::log_trace() << "Loading pairs-in-blocks from file: " << fileName << Debug::end;
-
-		// Load the raw text file
-		auto textContents = loadTextFile(scene, fileName);
-		if (textContents.has_value() == false)
+		////////////////////////////////////////////////////////////////////////////////
+		inline bool isSpace(char c)
 		{
-			Debug::log_error() << "Unable to load pairs-in-blocks from file: " << fileName << ", reason: unable to open file." << Debug::end;
-
-			return std::optional<std::ordered_pairs_in_blocks>();
+			return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
 		}
 
-		// Make an input stream from the contents
-		std::istringstream iss(textContents.value());
+		////////////////////////////////////////////////////////////////////////////////
+		inline std::string_view trimLeft(std::string_view str)
+		{
+			size_t first = 0;
+			while (first < str.size() && isSpace(str[first])) ++first;
+			return str.substr(first);
+		}
 
-		// Result of the load
-		std::ordered_pairs_in_blocks result;
+		////////////////////////////////////////////////////////////////////////////////
+		inline std::string_view trimRight(std::string_view str)
+		{
+			size_t last = str.size();
+			while (last > 0 && isSpace(str[last - 1])) --last;
+			return str.substr(0, last);
+		}
 
-		// Contents of the current category
-		std::ordered_pairs_in_blocks::iterator currentCategory;
+		////////////////////////////////////////////////////////////////////////////////
+		/** Single-pass tokenizer for pairs-in-blocks data.
+			Header lines look like '[name]', content lines like 'key = value'; every other line is ignored.
+			Keys keep their leading whitespace and values their trailing whitespace (except for line breaks). */
+		std::ordered_pairs_in_blocks parsePairsInBlocks(std::string_view contents)
+		{
+			// Result of the parse
+			std::ordered_pairs_in_blocks result;
 
-		// Regex used for the search
-		static std::regex s_headerRegex = std::regex("[[:space:]]*\\[(.*?)\\][[:space:]]*");
-		static std::regex s_contentRegex = std::regex("(.*?)[[:space:]]*=[[:space:]]*(.*)");
+			// Contents of the current category
+			std::ordered_pairs_in_blocks::iterator currentCategory = result.end();
 
-		// Process each line
-		for (std::string line; std::getline(iss, line);)
-		{
-			// Try to match a header
-			std::smatch capture;
-			if (std::regex_match(line, capture, s_headerRegex))
+			// Process each line
+			for (size_t lineStart = 0; lineStart < contents.size();)
 			{
-				// Append a new category and set it as the current one
-				result[capture[1]] = {};
-				currentCategory = result.find(capture[1]);
+				// Extract the current line
+				size_t lineEnd = contents.find('\n', lineStart);
+				if (lineEnd == std::string_view::npos) lineEnd = contents.size();
+				std::string_view line = contents.substr(lineStart, lineEnd - lineStart);
+				lineStart = lineEnd + 1;
+
+				// Strip the carriage return of CRLF line endings
+				while (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+				// Try to match a header
+				std::string_view header = trimRight(trimLeft(line));
+				if (header.size() >= 2 && header.front() == '[' && header.back() == ']')
+				{
+					// Append a new category and set it as the current one
+					currentCategory = result.insert_or_assign(std::string(header.substr(1, header.size() - 2)), std::ordered_pairs_in_blocks::mapped_type{}).first;
+					continue;
+				}
 
-				//Debug::log_debug() << "Found category \"" << capture[1] << "\"" << Debug::end;
+				// Try to match a content line
+				const size_t separator = line.find('=');
+				if (separator != std::string_view::npos && currentCategory != result.end())
+				{
+					// Append the value
+					currentCategory->second.emplace_back(
+						std::string(trimRight(line.substr(0, separator))),
+						std::string(trimLeft(line.substr(separator + 1))));
+				}
 			}
 
-			// Try to match a content regex
-			else if (std::regex_search(line, capture, s_contentRegex))
-			{
-				// Append the value
-				currentCategory->second.push_back(std::make_pair(capture[1], capture[2]));
+			return result;
+		}
+	}
 
-				//Debug::log_debug() << "Adding to \"" << currentCategory->first << "\" row: \"" << capture[1] << "\"" << Debug::end;
-			}
+	////////////////////////////////////////////////////////////////////////////////
+	std::optional<std::ordered_pairs_in_blocks> loadPairsInBlocks(Scene::Scene& scene, const std::string& fileName)
+	{
+		Debug::log_trace() << "Loading pairs-in-blocks from file: " << fileName << Debug::end;
+
+		// Load the raw text file
+		auto textContents = loadTextFile(scene, fileName);
+		if (textContents.has_value() == false)
+		{
+			Debug::log_error() << "Unable to load pairs-in-blocks from file: " << fileName << ", reason: unable to open file." << Debug::end;
+
+			return std::optional<std::ordered_pairs_in_blocks>();
 		}
 
+		// Parse the file contents
+		std::ordered_pairs_in_blocks result = pairs_in_blocks_impl::parsePairsInBlocks(textContents.value().m_contents);
+
 		Debug::log_trace() << "Successfully loaded pairs-in-blocks to file: " << fileName << Debug::end;
 		Debug::log_debug() << "Full contents:" << Debug::end;
 		for (auto const& category : result)
@@ -649,159 +688,245 @@ namespace Asset
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
-	template<typename T>
-	void extractSubImage(T* pixels, int width, int height, int subWidth, int subHeight)
+	namespace image_write_impl
 	{
-		for (int y = 0; y < subHeight; ++y)
+		////////////////////////////////////////////////////////////////////////////////
+		// Maximum number of images that can be in flight before we block the caller
+		size_t maxPendingWrites()
 		{
-			for (int x = 0; x < subWidth; ++x)
-			{
-				const int offset = 4 * (x + y * subWidth);
-				const int id = 4 * (x + y * width);
+			return 2 * std::max(size_t(1), size_t(Threading::numThreads()));
+		}
 
-				pixels[offset + 0] = pixels[id + 0];
-				pixels[offset + 1] = pixels[id + 1];
-				pixels[offset + 2] = pixels[id + 2];
-				pixels[offset + 3] = pixels[id + 3];
-			}
+		////////////////////////////////////////////////////////////////////////////////
+		/** Quantizes a normalized value to an 8-bit channel value. */
+		inline unsigned char toUnorm8(unsigned char value)
+		{
+			return value;
 		}
-	}
 
-	////////////////////////////////////////////////////////////////////////////////
-	template<typename T>
-	void flipImageVertically(T* pixels, int width, int height, int channels = 4)
-	{
-		// Flip the image vertically
-		for (int y = 0; y < height / 2; ++y)
+		////////////////////////////////////////////////////////////////////////////////
+		/** Quantizes a normalized value to an 8-bit channel value. */
+		inline unsigned char toUnorm8(float value)
 		{
-			const int swapY = height - y - 1;
-			for (int x = 0; x < width; ++x)
-			{
-				const int offset = channels * (x + y * width);
-				const int swapOffset = channels * (x + swapY * width);
+			return (unsigned char)(std::min(std::max(value, 0.0f), 1.0f) * 255.0f);
+		}
 
-				// Swap the 2 pixels
-				for (int c = 0; c < channels; ++c)
-					std::swap(pixels[offset + c], pixels[swapOffset + c]);
-			}
+		////////////////////////////////////////////////////////////////////////////////
+		/** Quantizes a normalized value to an 8-bit channel value. */
+		inline unsigned char toUnorm8(double value)
+		{
+			return (unsigned char)(std::min(std::max(value, 0.0), 1.0) * 255.0);
 		}
-	}
 
-	////////////////////////////////////////////////////////////////////////////////
-	void linearizeDepthImage(unsigned char* pixels, int width, int height, float near, float far)
-	{
-		// Convert the float to unsigned bytes
-		for (int y = 0; y < height; ++y)
+		////////////////////////////////////////////////////////////////////////////////
+		/** Converts a single row of interleaved pixels with C channels to RGBA8.
+			Missing color channels replicate the last source channel, and alpha defaults to opaque. 
+			The channel count is a template parameter so the inner loop is branch-free and vectorizes. */
+		template<size_t C, typename T>
+		void convertRowRgba8(const T* __restrict src, unsigned char* __restrict dst, size_t width)
 		{
-			for (int x = 0; x < width; ++x)
+			// Matching layouts reduce to a plain copy
+			if constexpr (C == 4 && std::is_same<T, unsigned char>::value)
 			{
-				const int offset = 4 * (x + y * width);
-
-				float depth = (*(float*)&pixels[offset]);
-				float linearDepth = linearizeDepth(depth, near, far);
+				std::memcpy(dst, src, width * 4);
+				return;
+			}
 
-				pixels[offset + 0] = (unsigned char)(linearDepth * 255.0f);
-				pixels[offset + 1] = (unsigned char)(linearDepth * 255.0f);
-				pixels[offset + 2] = (unsigned char)(linearDepth * 255.0f);
-				pixels[offset + 3] = 255;
+			for (size_t x = 0; x < width; ++x)
+			{
+				dst[4 * x + 0] = toUnorm8(src[C * x + std::min(size_t(0), C - 1)]);
+				dst[4 * x + 1] = toUnorm8(src[C * x + std::min(size_t(1), C - 1)]);
+				dst[4 * x + 2] = toUnorm8(src[C * x + std::min(size_t(2), C - 1)]);
+				dst[4 * x + 3] = C == 4 ? toUnorm8(src[C * x + 3]) : 255;
 			}
 		}
-	}
 
-	////////////////////////////////////////////////////////////////////////////////
-	size_t imageIndex(size_t x, size_t y, size_t c, size_t width, size_t height, size_t channels, bool flipUD)
-	{
-		return flipUD ?
-			((height - y - 1) * width + x) * channels + c :
-			(y * width + x) * channels + c;
-	}
+		////////////////////////////////////////////////////////////////////////////////
+		template<typename T>
+		void convertRowRgba8(const T* src, unsigned char* dst, size_t width, size_t channels)
+		{
+			switch (channels)
+			{
+			case 1: convertRowRgba8<1>(src, dst, width); break;
+			case 2: convertRowRgba8<2>(src, dst, width); break;
+			case 3: convertRowRgba8<3>(src, dst, width); break;
+			case 4: convertRowRgba8<4>(src, dst, width); break;
+			}
+		}
 
-	////////////////////////////////////////////////////////////////////////////////
-	bool saveImage(Scene::Scene& scene, std::string filePath, size_t width, size_t height, size_t channels, unsigned char* pixels, bool flipUD)
-	{
-		Profiler::ScopedCpuPerfCounter perfCounter(scene, filePath);
+		////////////////////////////////////////////////////////////////////////////////
+		/** Converts a single row of a single-channel matrix image to grayscale RGBA8. */
+		template<typename M>
+		void convertMatrixRowRgba8(M const& image, size_t y, unsigned char* __restrict dst)
+		{
+			const size_t width = image.cols();
+			for (size_t x = 0; x < width; ++x)
+			{
+				const unsigned char value = toUnorm8(image(y, x));
+				dst[4 * x + 0] = value;
+				dst[4 * x + 1] = value;
+				dst[4 * x + 2] = value;
+				dst[4 * x + 3] = 255;
+			}
+		}
 
-		Debug::log_trace() << "Saving image: " << filePath << Debug::end;
+		////////////////////////////////////////////////////////////////////////////////
+		/** Converts a single row of raw depth values to linear depth, in RGBA8 format. */
+		void convertDepthRowRgba8(const float* __restrict src, unsigned char* __restrict dst, size_t width, float near, float far)
+		{
+			for (size_t x = 0; x < width; ++x)
+			{
+				const unsigned char value = (unsigned char)(linearizeDepth(src[x], near, far) * 255.0f);
+				dst[4 * x + 0] = value;
+				dst[4 * x + 1] = value;
+				dst[4 * x + 2] = value;
+				dst[4 * x + 3] = 255;
+			}
+		}
 
-		// Compute the full file name
-		std::string fullFileName = (EnginePaths::assetsFolder() / filePath).string();
+		////////////////////////////////////////////////////////////////////////////////
+		/** Runs the parameter row kernel for each row of a width x height RGBA8 image, distributed among the worker threads.
+			The kernel receives the source row index and a pointer to the (optionally flipped) destination row. */
+		template<typename Fn>
+		std::vector<unsigned char> convertImageRgba8(size_t width, size_t height, bool flipUD, Fn const& rowKernel)
+		{
+			std::vector<unsigned char> result(4 * width * height);
+			Threading::threadedExecuteIndices(Threading::numThreads(),
+				[&](Threading::ThreadedExecuteEnvironment const& environment, size_t y)
+				{
+					const size_t outY = flipUD ? height - y - 1 : y;
+					rowKernel(y, result.data() + 4 * width * outY);
+				},
+				height);
+			return result;
+		}
 
-		// Create the parent folder hierarchy
-		EnginePaths::makeDirectoryStructure(fullFileName, true);
+		////////////////////////////////////////////////////////////////////////////////
+		/** The pending write list is not synchronized, so image writes may only be issued from a single (the main) thread. */
+		void assertWriterThread()
+		{
+			static const std::thread::id s_writerThread = std::this_thread::get_id();
+			assert(std::this_thread::get_id() == s_writerThread);
+		}
 
-		// Convert the pixels to uchar
-		unsigned char* ucpixels = new unsigned char[4 * width * height];
+		////////////////////////////////////////////////////////////////////////////////
+		/** Waits for a single pending write and records its failure. */
+		void finishWrite(Scene::Scene& scene, std::future<bool>& write)
+		{
+			if (!write.get()) ++scene.m_numFailedImageWrites;
+		}
 
-		for (int y = 0; y < height; ++y)
-		for (int x = 0; x < width; ++x)
+		////////////////////////////////////////////////////////////////////////////////
+		/** Removes the already finished image writes from the pending list. */
+		void collectFinishedWrites(Scene::Scene& scene)
 		{
-			for (size_t c = 0; c < channels; ++c)
+			auto& pending = scene.m_pendingImageWrites;
+			pending.erase(std::remove_if(pending.begin(), pending.end(), [&](std::future<bool>& write)
 			{
-				size_t outIndex = imageIndex(x, y, c, width, height, 4, flipUD);
-				size_t inIndex = imageIndex(x, y, c, width, height, channels, false);
+				if (write.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return false;
+				finishWrite(scene, write);
+				return true;
+			}), pending.end());
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		/** Encodes and writes out an already converted RGBA8 image on a worker thread. Returns false if the write 
+			could not be started; failures of the write itself are reported by waitForImageWrites. */
+		bool writeImageAsync(Scene::Scene& scene, std::string const& filePath, size_t width, size_t height, std::vector<unsigned char>&& pixels)
+		{
+			assertWriterThread();
 
-				ucpixels[outIndex] = pixels[inIndex];
+			// Make sure there is something to write
+			if (width == 0 || height == 0 || pixels.size() != 4 * width * height)
+			{
+				Debug::log_error() << "Unable to save image: " << filePath << ", invalid image dimensions (" << width << "x" << height << ")" << Debug::end;
+				return false;
 			}
 
-			for (size_t c = channels; c < 4; ++c)
+			// Compute the full file name
+			std::string fullFileName = (EnginePaths::assetsFolder() / filePath).string();
+
+			// Create the parent folder hierarchy
+			if (!EnginePaths::makeDirectoryStructure(fullFileName, true))
 			{
-				size_t outIndex = imageIndex(x, y, c, width, height, 4, flipUD);
-				size_t inIndex = imageIndex(x, y, channels - 1, width, height, channels, false);
+				Debug::log_error() << "Unable to save image: " << filePath << ", cannot create the parent folder" << Debug::end;
+				return false;
+			}
 
-				ucpixels[outIndex] = (c == 3) ? 255 : pixels[inIndex];
+			// Drop the finished writes and throttle the caller if too many images are still in flight
+			collectFinishedWrites(scene);
+			while (scene.m_pendingImageWrites.size() >= maxPendingWrites())
+			{
+				finishWrite(scene, scene.m_pendingImageWrites.front());
+				scene.m_pendingImageWrites.erase(scene.m_pendingImageWrites.begin());
 			}
-		}
 
-		// Actually save the image
-		auto result = stbi_write_png(fullFileName.c_str(), width, height, 4, ucpixels, 0);
+			// Encode and write the image in the background
+			scene.m_pendingImageWrites.emplace_back(std::async(std::launch::async,
+				[filePath, fullFileName, width, height, pixels = std::move(pixels)]()
+				{
+					const bool result = stbi_write_png(fullFileName.c_str(), width, height, 4, pixels.data(), 0) != 0;
 
-		Debug::log_trace() << "Successfully saved image: " << filePath << Debug::end;
+					if (result) Debug::log_trace() << "Successfully saved image: " << filePath << Debug::end;
+					else        Debug::log_error() << "Unable to save image: " << filePath << Debug::end;
 
-		return false;
+					return result;
+				}));
+
+			return true;
+		}
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
-	bool saveImage(Scene::Scene& scene, std::string filePath, size_t width, size_t height, size_t channels, float* pixels, bool flipUD)
+	bool waitForImageWrites(Scene::Scene& scene)
 	{
-		Profiler::ScopedCpuPerfCounter perfCounter(scene, filePath);
+		image_write_impl::assertWriterThread();
 
-		Debug::log_trace() << "Saving image: " << filePath << Debug::end;
+		if (!scene.m_pendingImageWrites.empty())
+			Debug::log_trace() << "Waiting for " << scene.m_pendingImageWrites.size() << " pending image writes" << Debug::end;
 
-		// Compute the full file name
-		std::string fullFileName = (EnginePaths::assetsFolder() / filePath).string();
+		for (auto& write : scene.m_pendingImageWrites)
+			image_write_impl::finishWrite(scene, write);
+		scene.m_pendingImageWrites.clear();
 
-		// Create the parent folder hierarchy
-		EnginePaths::makeDirectoryStructure(fullFileName, true);
+		// Report and reset the failures since the last call
+		const bool result = scene.m_numFailedImageWrites == 0;
+		scene.m_numFailedImageWrites = 0;
+		return result;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	bool saveImage(Scene::Scene& scene, std::string filePath, size_t width, size_t height, size_t channels, unsigned char* pixels, bool flipUD)
+	{
+		Profiler::ScopedCpuPerfCounter perfCounter(scene, filePath);
 
-		// Convert the pixels to uchar
-		unsigned char* ucpixels = new unsigned char[4 * width * height];
+		Debug::log_trace() << "Saving image: " << filePath << Debug::end;
 
-		for (int y = 0; y < height; ++y)
-		for (int x = 0; x < width; ++x)
+		// Convert the pixels to RGBA
+		auto ucpixels = image_write_impl::convertImageRgba8(width, height, flipUD, [&](size_t y, unsigned char* dst)
 		{
-			for (size_t c = 0; c < channels; ++c)
-			{
-				size_t outIndex = imageIndex(x, y, c, width, height, 4, flipUD);
-				size_t inIndex = imageIndex(x, y, c, width, height, channels, false);
+			image_write_impl::convertRowRgba8(pixels + y * width * channels, dst, width, channels);
+		});
 
-				ucpixels[outIndex] = pixels[inIndex];
-			}
-
-			for (size_t c = channels; c < 4; ++c)
-			{
-				size_t outIndex = imageIndex(x, y, c, width, height, 4, flipUD);
-				size_t inIndex = imageIndex(x, y, channels - 1, width, height, channels, false);
+		// Actually save the image
+		return image_write_impl::writeImageAsync(scene, filePath, width, height, std::move(ucpixels));
+	}
 
-				ucpixels[outIndex] = (c == 3) ? 255 : pixels[inIndex];
-			}
-		}
+	////////////////////////////////////////////////////////////////////////////////
+	bool saveImage(Scene::Scene& scene, std::string filePath, size_t width, size_t height, size_t channels, float* pixels, bool flipUD)
+	{
+		Profiler::ScopedCpuPerfCounter perfCounter(scene, filePath);
 
-		// Actually save the image
-		auto result = stbi_write_png(fullFileName.c_str(), width, height, 4, ucpixels, 0);
+		Debug::log_trace() << "Saving image: " << filePath << Debug::end;
 
-		Debug::log_trace() << "Successfully saved image: " << filePath << Debug::end;
+		// Convert the pixels to RGBA
+		auto ucpixels = image_write_impl::convertImageRgba8(width, height, flipUD, [&](size_t y, unsigned char* dst)
+		{
+			image_write_impl::convertRowRgba8(pixels + y * width * channels, dst, width, channels);
+		});
 
-		return false;
+		// Actually save the image
+		return image_write_impl::writeImageAsync(scene, filePath, width, height, std::move(ucpixels));
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -811,29 +936,14 @@ namespace Asset
 
 		Debug::log_trace() << "Saving image: " << filePath << Debug::end;
 
-		// Compute the full file name
-		std::string fullFileName = (EnginePaths::assetsFolder() / filePath).string();
-
-		// Create the parent folder hierarchy
-		EnginePaths::makeDirectoryStructure(fullFileName, true);
-
-		// Convert the pixels to uchar
-		unsigned char* ucpixels = new unsigned char[4 * image.rows() * image.cols()];
-
-		for (size_t y = 0; y < image.rows(); ++y)
-		for (size_t x = 0; x < image.cols(); ++x)
-		for (size_t c = 0; c < 4; ++c)
+		// Convert the pixels to RGBA
+		auto ucpixels = image_write_impl::convertImageRgba8(image.cols(), image.rows(), flipUD, [&](size_t y, unsigned char* dst)
 		{
-			size_t outIndex = imageIndex(x, y, c, image.cols(), image.rows(), 4, flipUD);
-			ucpixels[outIndex] = c == 3 ? 255 : (unsigned char)(image(y, x) * 255.0f);
-		}
+			image_write_impl::convertMatrixRowRgba8(image, y, dst);
+		});
 
 		// Actually save the image
-		auto result = stbi_write_png(fullFileName.c_str(), image.cols(), image.rows(), 4, ucpixels, 0);
-
-		Debug::log_trace() << "Successfully saved image: " << filePath << Debug::end;
-
-		return false;
+		return image_write_impl::writeImageAsync(scene, filePath, image.cols(), image.rows(), std::move(ucpixels));
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -843,29 +953,14 @@ namespace Asset
 
 		Debug::log_trace() << "Saving image: " << filePath << Debug::end;
 
-		// Compute the full file name
-		std::string fullFileName = (EnginePaths::assetsFolder() / filePath).string();
-
-		// Create the parent folder hierarchy
-		EnginePaths::makeDirectoryStructure(fullFileName, true);
-
-		// Convert the pixels to uchar
-		unsigned char* ucpixels = new unsigned char[4 * image.rows() * image.cols()];
-
-		for (size_t y = 0; y < image.rows(); ++y)
-		for (size_t x = 0; x < image.cols(); ++x)
-		for (size_t c = 0; c < 4; ++c)
+		// Convert the pixels to RGBA
+		auto ucpixels = image_write_impl::convertImageRgba8(image.cols(), image.rows(), flipUD, [&](size_t y, unsigned char* dst)
 		{
-			size_t outIndex = imageIndex(x, y, c, image.cols(), image.rows(), 4, flipUD);
-			ucpixels[outIndex] = c == 3 ? 255 : (unsigned char)(image(y, x) * 255.0);
-		}
+			image_write_impl::convertMatrixRowRgba8(image, y, dst);
+		});
 
 		// Actually save the image
-		auto result = stbi_write_png(fullFileName.c_str(), image.cols(), image.rows(), 4, ucpixels, 0);
-
-		Debug::log_trace() << "Successfully saved image: " << filePath << Debug::end;
-
-		return false;
+		return image_write_impl::writeImageAsync(scene, filePath, image.cols(), image.rows(), std::move(ucpixels));
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -875,29 +970,14 @@ namespace Asset
 
 		Debug::log_trace() << "Saving image: " << filePath << Debug::end;
 
-		// Compute the full file name
-		std::string fullFileName = (EnginePaths::assetsFolder() / filePath).string();
-
-		// Create the parent folder hierarchy
-		EnginePaths::makeDirectoryStructure(fullFileName, true);
-
-		// Convert the pixels to uchar
-		unsigned char* ucpixels = new unsigned char[4 * image.rows() * image.cols()];
-
-		for (size_t y = 0; y < image.rows(); ++y)
-		for (size_t x = 0; x < image.cols(); ++x)
-		for (size_t c = 0; c < 4; ++c)
+		// Convert the pixels to RGBA
+		auto ucpixels = image_write_impl::convertImageRgba8(image.cols(), image.rows(), flipUD, [&](size_t y, unsigned char* dst)
 		{
-			size_t outIndex = imageIndex(x, y, c, image.cols(), image.rows(), 4, flipUD);
-			ucpixels[outIndex] = c == 3 ? 255 : image(y, x);
-		}
+			image_write_impl::convertMatrixRowRgba8(image, y, dst);
+		});
 
 		// Actually save the image
-		auto result = stbi_write_png(fullFileName.c_str(), image.cols(), image.rows(), 4, ucpixels, 0);
-
-		Debug::log_trace() << "Successfully saved image: " << filePath << Debug::end;
-
-		return false;
+		return image_write_impl::writeImageAsync(scene, filePath, image.cols(), image.rows(), std::move(ucpixels));
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -934,10 +1014,13 @@ namespace Asset
 		glBindTexture(GL_TEXTURE_2D, 0);
 
 		// Flip the image vertically
-		flipImageVertically(pixels, w, h);
+		auto flippedPixels = image_write_impl::convertImageRgba8(w, h, true, [&](size_t y, unsigned char* dst)
+		{
+			image_write_impl::convertRowRgba8(pixels + 4 * w * y, dst, w, 4);
+		});
 
 		// Now actually save the texture
-		auto result = stbi_write_png(fullFileName.c_str(), w, h, 4, pixels, 0);
+		auto result = stbi_write_png(fullFileName.c_str(), w, h, 4, flippedPixels.data(), 0);
 
 		// Free the pixels
 		delete pixels;
@@ -974,10 +1057,13 @@ namespace Asset
 		glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.get());
 
 		// Flip the image vertically
-		flipImageVertically(pixels.get(), width, height);
+		auto flippedPixels = image_write_impl::convertImageRgba8(width, height, true, [&](size_t y, unsigned char* dst)
+		{
+			image_write_impl::convertRowRgba8(pixels.get() + 4 * width * y, dst, width, 4);
+		});
 
 		// Now actually save the texture
-		auto result = stbi_write_png(fullFileName.c_str(), width, height, 4, pixels.get(), 0);
+		auto result = stbi_write_png(fullFileName.c_str(), width, height, 4, flippedPixels.data(), 0);
 
 		Debug::log_trace() << "Successfully saved default framebuffer to " << filePath << Debug::end;
 
@@ -993,12 +1079,6 @@ namespace Asset
 
 		Debug::log_trace() << "Saving gbuffer color channel to " << filePath << Debug::end;
 
-		// Compute the full file name
-		std::string fullFileName = (EnginePaths::assetsFolder() / filePath).string();
-
-		// Create the parent folder hierarchy
-		EnginePaths::makeDirectoryStructure(fullFileName, true);
-
 		// Make sure the texture has been updated
 		glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT);
 
@@ -1010,18 +1090,15 @@ namespace Asset
 		glPixelStorei(GL_PACK_ALIGNMENT, 1);
 		glGetTextureSubImage(scene.m_gbuffer[gbufferId].m_colorTextures[1 - scene.m_gbuffer[gbufferId].m_writeBuffer], 0, 0, 0, layerId, scene.m_gbuffer[gbufferId].m_width, scene.m_gbuffer[gbufferId].m_height, 1, GL_RGBA, GL_UNSIGNED_BYTE, bufSize, pixels.get());
 
-		// Extract the relevant subimage
-		extractSubImage(pixels.get(), scene.m_gbuffer[gbufferId].m_width, scene.m_gbuffer[gbufferId].m_height, width, height);
-
-		// Flip the image vertically
-		flipImageVertically(pixels.get(), width, height);
+		// Extract the relevant subimage and flip it vertically
+		const size_t bufferWidth = scene.m_gbuffer[gbufferId].m_width;
+		auto ucpixels = image_write_impl::convertImageRgba8(width, height, true, [&](size_t y, unsigned char* dst)
+		{
+			image_write_impl::convertRowRgba8(pixels.get() + 4 * bufferWidth * y, dst, width, 4);
+		});
 
 		// Now actually save the texture
-		auto result = stbi_write_png(fullFileName.c_str(), width, height, 4, pixels.get(), 0);
-
-		Debug::log_trace() << "Successfully saved gbuffer color channel to " << filePath << Debug::end;
-
-		return result == 0;
+		return image_write_impl::writeImageAsync(scene, filePath, width, height, std::move(ucpixels));
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -1033,12 +1110,6 @@ namespace Asset
 
 		Debug::log_trace() << "Saving gbuffer normal channel (in display format) to " << filePath << Debug::end;
 
-		// Compute the full file name
-		std::string fullFileName = (EnginePaths::assetsFolder() / filePath).string();
-
-		// Create the parent folder hierarchy
-		EnginePaths::makeDirectoryStructure(fullFileName, true);
-
 		// Make sure the texture has been updated
 		glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT);
 
@@ -1050,18 +1121,15 @@ namespace Asset
 		glPixelStorei(GL_PACK_ALIGNMENT, 1);
 		glGetTextureSubImage(scene.m_gbuffer[gbufferId].m_normalTexture, 0, 0, 0, layerId, scene.m_gbuffer[gbufferId].m_width, scene.m_gbuffer[gbufferId].m_height, 1, GL_RGBA, GL_UNSIGNED_BYTE, bufSize, pixels.get());
 
-		// Extract the relevant subimage
-		extractSubImage(pixels.get(), scene.m_gbuffer[gbufferId].m_width, scene.m_gbuffer[gbufferId].m_height, width, height);
-
-		// Flip the image vertically
-		flipImageVertically(pixels.get(), width, height);
+		// Extract the relevant subimage and flip it vertically
+		const size_t bufferWidth = scene.m_gbuffer[gbufferId].m_width;
+		auto ucpixels = image_write_impl::convertImageRgba8(width, height, true, [&](size_t y, unsigned char* dst)
+		{
+			image_write_impl::convertRowRgba8(pixels.get() + 4 * bufferWidth * y, dst, width, 4);
+		});
 
 		// Now actually save the texture
-		auto result = stbi_write_png(fullFileName.c_str(), width, height, 4, pixels.get(), 0);
-
-		Debug::log_trace() << "Successfully saved gbuffer normal channel to " << filePath << Debug::end;
-
-		return result == 0;
+		return image_write_impl::writeImageAsync(scene, filePath, width, height, std::move(ucpixels));
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -1073,12 +1141,6 @@ namespace Asset
 
 		Debug::log_trace() << "Saving gbuffer depth channel to " << filePath << Debug::end;
 
-		// Compute the full file name
-		std::string fullFileName = (EnginePaths::assetsFolder() / filePath).string();
-
-		// Create the parent folder hierarchy
-		EnginePaths::makeDirectoryStructure(fullFileName, true);
-
 		// Make sure the texture has been updated
 		glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT);
 
@@ -1090,21 +1152,15 @@ namespace Asset
 		glPixelStorei(GL_PACK_ALIGNMENT, 1);
 		glGetTextureSubImage(scene.m_gbuffer[gbufferId].m_depthTexture, 0, 0, 0, layerId, scene.m_gbuffer[gbufferId].m_width, scene.m_gbuffer[gbufferId].m_height, 1, GL_DEPTH_COMPONENT, GL_FLOAT, bufSize, pixels.get());
 
-		// Extract the relevant subimage
-		extractSubImage(pixels.get(), scene.m_gbuffer[gbufferId].m_width, scene.m_gbuffer[gbufferId].m_height, width, height);
-
-		// Flip the image vertically
-		flipImageVertically(pixels.get(), width, height);
-
-		// Linearize the depth image
-		linearizeDepthImage(pixels.get(), width, height, near, far);
+		// Extract the relevant subimage, flip it vertically and linearize the depth values
+		const size_t bufferWidth = scene.m_gbuffer[gbufferId].m_width;
+		auto ucpixels = image_write_impl::convertImageRgba8(width, height, true, [&](size_t y, unsigned char* dst)
+		{
+			image_write_impl::convertDepthRowRgba8((const float*)pixels.get() + bufferWidth * y, dst, width, near, far);
+		});
 
 		// Now actually save the texture
-		auto result = stbi_write_png(fullFileName.c_str(), width, height, 4, pixels.get(), 0);
-
-		Debug::log_trace() << "Successfully saved gbuffer depth channel to " << filePath << Debug::end;
-
-		return result == 0;
+		return image_write_impl::writeImageAsync(scene, filePath, width, height, std::move(ucpixels));
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
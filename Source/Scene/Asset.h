@@ -66,6 +66,12 @@ namespace Asset
 	bool loadCubeMap(Scene::Scene& scene, const std::string& textureName, const std::string& filePath, const std::string& leftName = "left.tga", const std::string& rightName = "right.tga",
 		const std::string& topName = "top.tga", const std::string& bottomName = "bottom.tga", const std::string& backName = "back.tga", const std::string& frontName = "front.tga");
 
+	////////////////////////////////////////////////////////////////////////////////
+	// Image saves are encoded and written in the background, and may only be issued from the main thread; the save
+	// functions return false if the write could not be started. Waits for the pending writes, and returns whether
+	// every write since the previous call succeeded.
+	bool waitForImageWrites(Scene::Scene& scene);
+
 	////////////////////////////////////////////////////////////////////////////////
 	bool saveImage(Scene::Scene& scene, std::string filePath, size_t width, size_t height, size_t channels, unsigned char* pixels, bool flipUD = false);
 
@@ -90,9 +96,6 @@ namespace Asset
 	////////////////////////////////////////////////////////////////////////////////
 	float reconstructCameraZ(float depth, glm::mat4 projection);
 
-	////////////////////////////////////////////////////////////////////////////////
-	void linearizeDepthImage(unsigned char* pixels, int width, int height, float near, float far);
-
 	////////////////////////////////////////////////////////////////////////////////
 	bool saveDefaultFramebuffer(Scene::Scene& scene, std::string filePath, int width, int height);
 
@@ -92,60 +92,61 @@ namespace KeyframedAnim
 	////////////////////////////////////////////////////////////////////////////////
 	void releaseObject(Scene::Scene& scene, Scene::Object& object)
 	{
-		// Release any old interpolation objects
-		for (auto& track : object.component<KeyFramedAnimComponent>().m_tracks)
-		{
-			if (track.second.m_interp)
-			{
-				gsl_interp_free(track.second.m_interp);
-				gsl_interp_accel_free(track.second.m_interpAccel);
-			}
-		}
+
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
-	float sampleTrackSimple(KeyframedAnim::KeyFramedAnimTrack const& track, float time)
+	/** Moves the parameter segment cursor to the segment containing 'time'.
+		Consecutive frames tend to stay in the same segment or step into the next one, so these are tested before falling back to a binary search. */
+	size_t seekSegment(KeyframedAnim::KeyFramedAnimTrack const& track, float time, size_t cursor)
 	{
-		// Skip over empty frames
-		if (track.m_frames.empty()) return 0.0f;
+		const size_t numSegments = track.m_times.size() - 1;
+		if (cursor >= numSegments) cursor = 0;
 
-		// Iterators to the two frames to interpolate
-		std::vector<KeyframedAnim::KeyFramedAnimNode>::const_iterator frameIts[2];
+		// Same segment
+		if (time >= track.m_times[cursor] && time <= track.m_times[cursor + 1]) return cursor;
 
-		if (time <= track.m_frames.front().m_time)
-		{
-			frameIts[0] = frameIts[1] = track.m_frames.begin();
-		}
-		else if (time >= track.m_frames.back().m_time)
-		{
-			frameIts[0] = frameIts[1] = track.m_frames.end() - 1;
-		}
-		else
-		{
-			frameIts[1] = std::lower_bound(track.m_frames.begin(), track.m_frames.end(), time, [](auto const& node, auto const& time) { return node.m_time < time; });
-			frameIts[0] = frameIts[1] - 1;
-		}
+		// Next segment
+		if (cursor + 1 < numSegments && time >= track.m_times[cursor + 1] && time <= track.m_times[cursor + 2]) return cursor + 1;
 
-		// Interpolation factor
-		float alpha = (time - frameIts[0]->m_time) / glm::max(frameIts[1]->m_time - frameIts[0]->m_time, 1e-3f);
+		// Binary search for the segment
+		const size_t upper = std::upper_bound(track.m_times.begin(), track.m_times.end(), time) - track.m_times.begin();
+		return glm::clamp(upper, size_t(1), numSegments) - 1;
+	}
 
-		// Lerp between the two values
-		return glm::mix(frameIts[0]->m_value, frameIts[1]->m_value, alpha);
+	////////////////////////////////////////////////////////////////////////////////
+	/** Evaluates the cubic spline segment between (x0, y0) and (x1, y1) with second derivatives m0 and m1 at 'time'. */
+	float evaluateSegment(float time, float x0, float x1, float y0, float y1, float m0, float m1)
+	{
+		const float h = glm::max(x1 - x0, 1e-6f);
+		const float b = glm::clamp((time - x0) / h, 0.0f, 1.0f);
+		const float a = 1.0f - b;
+		return a * y0 + b * y1 + ((a * a * a - a) * m0 + (b * b * b - b) * m1) * (h * h / 6.0f);
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
-	float sampleTrackGsl(KeyframedAnim::KeyFramedAnimTrack const& track, float time)
+	float sampleTrack(KeyframedAnim::KeyFramedAnimTrack const& track, float time, size_t& cursor)
 	{
-		if (time <= track.m_frames.front().m_time) return track.m_frames.front().m_value;
-		if (time >= track.m_frames.back().m_time) return track.m_frames.back().m_value;
-		return (float)gsl_interp_eval(track.m_interp, track.m_times.data(), track.m_values.data(), time, track.m_interpAccel);
+		// Skip over empty tracks
+		if (track.m_times.empty()) return 0.0f;
+
+		// Clamp to the first and last frame
+		if (time <= track.m_times.front()) return track.m_values.front();
+		if (time >= track.m_times.back()) return track.m_values.back();
+
+		// Evaluate the spline segment
+		cursor = seekSegment(track, time, cursor);
+		return evaluateSegment(time, 
+			track.m_times[cursor], track.m_times[cursor + 1], 
+			track.m_values[cursor], track.m_values[cursor + 1],
+			track.m_secondDerivatives[cursor], track.m_secondDerivatives[cursor + 1]);
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
 	float sampleTrack(KeyframedAnim::KeyFramedAnimTrack const& track, float time)
 	{
-		return sampleTrackGsl(track, time);
-		//return sampleTrackSimple(track, time);
+		size_t cursor = 0;
+		return sampleTrack(track, time, cursor);
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -153,21 +154,47 @@ namespace KeyframedAnim
 	{
 		return sampleTrack(track, glm::clamp(time, 0.0f, object->component<KeyFramedAnimComponent>().m_length));
 	}
+
 	////////////////////////////////////////////////////////////////////////////////
-	const gsl_interp_type* determineInterpType(Scene::Scene& scene, Scene::Object* object, KeyFramedAnimTrack& track)
+	/** Computes the second derivatives of a natural cubic spline through the track nodes. */
+	void computeSplineDerivativesCubic(Scene::Scene& scene, Scene::Object* object, KeyFramedAnimTrack& track)
+	{
+		const size_t n = track.m_times.size();
+		track.m_secondDerivatives.assign(n, 0.0f);
+		if (n < 3) return;
+
+		// Forward elimination of the tridiagonal system (Thomas algorithm)
+		std::vector<float> diagonal(n, 1.0f), rhs(n, 0.0f);
+		for (size_t i = 1; i < n - 1; ++i)
+		{
+			const float h0 = track.m_times[i] - track.m_times[i - 1];
+			const float h1 = track.m_times[i + 1] - track.m_times[i];
+			const float factor = (i == 1) ? 0.0f : h0 / diagonal[i - 1];
+
+			diagonal[i] = 2.0f * (h0 + h1) - factor * h0;
+			rhs[i] = 6.0f * ((track.m_values[i + 1] - track.m_values[i]) / h1 - (track.m_values[i] - track.m_values[i - 1]) / h0) - factor * rhs[i - 1];
+		}
+
+		// Back substitution (the end points keep their zero second derivatives)
+		for (size_t i = n - 2; i >= 1; --i)
+		{
+			const float h1 = track.m_times[i + 1] - track.m_times[i];
+			track.m_secondDerivatives[i] = (rhs[i] - h1 * track.m_secondDerivatives[i + 1]) / diagonal[i];
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	void computeSplineDerivatives(Scene::Scene& scene, Scene::Object* object, KeyFramedAnimTrack& track)
 	{
-		// Determine the interpolation type to use
-		const gsl_interp_type* interpType;
 		switch (track.m_interpolationMethod)
 		{
 		case KeyFramedAnimTrack::Linear:
-			interpType = gsl_interp_linear;
+			track.m_secondDerivatives.assign(track.m_times.size(), 0.0f);
 			break;
 		case KeyFramedAnimTrack::Cubic:
-			interpType = gsl_interp_cspline;
+			computeSplineDerivativesCubic(scene, object, track);
 			break;
 		}
-		return interpType;
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -178,9 +205,10 @@ namespace KeyframedAnim
 		track.m_max = -FLT_MAX;
 
 		// Go through the curve and update the min/max values by sampling the curve
+		size_t cursor = 0;
 		for (float t = 0.0f; t < object->component<KeyFramedAnimComponent>().m_length; t += 0.01f)
 		{
-			float value = sampleTrack(track, t);
+			float value = sampleTrack(track, t, cursor);
 			track.m_min = glm::min(track.m_min, value);
 			track.m_max = glm::max(track.m_max, value);
 		}
@@ -213,10 +241,6 @@ namespace KeyframedAnim
 		track.m_values.clear();
 		track.m_values.reserve(track.m_frames.size());
 
-		// Insertiont iterators
-		auto timeInsertIt = track.m_times.begin();
-		auto valueInsertIt = track.m_values.begin();
-
 		// Populate these buffers
 		for (size_t i = 0; i < track.m_frames.size(); ++i)
 		{
@@ -227,25 +251,8 @@ namespace KeyframedAnim
 			}
 		}
 
-		// Determine the interpolation type to use
-		const gsl_interp_type* interpType = determineInterpType(scene, object, track);
-
-		// Release any old interpolation objects
-		if (track.m_interp)
-		{
-			gsl_interp_free(track.m_interp);
-			gsl_interp_accel_reset(track.m_interpAccel);
-		}
-
-		// Create the interpolation objects
-		else
-		{
-			track.m_interpAccel = gsl_interp_accel_alloc();
-		}
-
-		// Init the interp object
-		track.m_interp = gsl_interp_alloc(interpType, track.m_times.size());
-		gsl_interp_init(track.m_interp, track.m_times.data(), track.m_values.data(), track.m_times.size());
+		// Compute the spline coefficients
+		computeSplineDerivatives(scene, object, track);
 
 		// Compute the min/max values
 		switch (track.m_interpolationMethod)
@@ -264,6 +271,104 @@ namespace KeyframedAnim
 	{
 		for (auto& track : object->component<KeyFramedAnimComponent>().m_tracks)
 			KeyframedAnim::updateTrackInterpObjects(scene, object, track.second);
+
+		// Rebuild the evaluation data
+		markTracksChanged(scene, object);
+		updateTrackEvaluator(scene, object);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	/** Invalidates the evaluator; must be called after adding or removing tracks or changing their variable bindings. */
+	void markTracksChanged(Scene::Scene& scene, Scene::Object* object)
+	{
+		++object->component<KeyFramedAnimComponent>().m_tracksVersion;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	void updateTrackEvaluator(Scene::Scene& scene, Scene::Object* object)
+	{
+		auto& tracks = object->component<KeyFramedAnimComponent>().m_tracks;
+		auto& evaluator = object->component<KeyFramedAnimComponent>().m_evaluator;
+
+		evaluator.m_source = &tracks;
+		evaluator.m_sourceVersion = object->component<KeyFramedAnimComponent>().m_tracksVersion;
+		evaluator.m_tracks.clear();
+		evaluator.m_variableOffsets.clear();
+		evaluator.m_variables.clear();
+
+		// Flatten the tracks and their variable bindings
+		for (auto const& track : tracks)
+		{
+			evaluator.m_tracks.push_back(&track.second);
+			evaluator.m_variableOffsets.push_back(evaluator.m_variables.size());
+			for (auto const& variable : track.second.m_variables)
+				evaluator.m_variables.push_back(variable.second);
+		}
+		evaluator.m_variableOffsets.push_back(evaluator.m_variables.size());
+
+		// Allocate the per-track buffers
+		const size_t numTracks = evaluator.m_tracks.size();
+		evaluator.m_cursors.assign(numTracks, 0);
+		for (auto buffer : { &evaluator.m_x0, &evaluator.m_x1, &evaluator.m_y0, &evaluator.m_y1, &evaluator.m_m0, &evaluator.m_m1, &evaluator.m_samples })
+			buffer->assign(numTracks, 0.0f);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	/** Samples every track at 'time' and writes the results into the bound variables. */
+	void evaluateTracks(Scene::Scene& scene, Scene::Object* object, float time)
+	{
+		// Make sure the evaluation data is up-to-date
+		auto& evaluator = object->component<KeyFramedAnimComponent>().m_evaluator;
+		if (evaluator.m_source != &object->component<KeyFramedAnimComponent>().m_tracks || 
+			evaluator.m_sourceVersion != object->component<KeyFramedAnimComponent>().m_tracksVersion ||
+			evaluator.m_tracks.size() != object->component<KeyFramedAnimComponent>().m_tracks.size())
+			updateTrackEvaluator(scene, object);
+
+		const size_t numTracks = evaluator.m_tracks.size();
+
+		// Gather the active segment of each track
+		for (size_t i = 0; i < numTracks; ++i)
+		{
+			KeyFramedAnimTrack const& track = *evaluator.m_tracks[i];
+
+			// Empty and single-node tracks, or times outside the track, collapse to a constant segment
+			if (track.m_times.size() < 2 || time <= track.m_times.front() || time >= track.m_times.back())
+			{
+				const float value = track.m_values.empty() ? 0.0f : (time <= track.m_times.front() ? track.m_values.front() : track.m_values.back());
+				evaluator.m_x0[i] = time;
+				evaluator.m_x1[i] = time + 1.0f;
+				evaluator.m_y0[i] = evaluator.m_y1[i] = value;
+				evaluator.m_m0[i] = evaluator.m_m1[i] = 0.0f;
+				continue;
+			}
+
+			const size_t cursor = evaluator.m_cursors[i] = seekSegment(track, time, evaluator.m_cursors[i]);
+			evaluator.m_x0[i] = track.m_times[cursor];
+			evaluator.m_x1[i] = track.m_times[cursor + 1];
+			evaluator.m_y0[i] = track.m_values[cursor];
+			evaluator.m_y1[i] = track.m_values[cursor + 1];
+			evaluator.m_m0[i] = track.m_secondDerivatives[cursor];
+			evaluator.m_m1[i] = track.m_secondDerivatives[cursor + 1];
+		}
+
+		// Evaluate all the segments at once
+		const float* __restrict x0 = evaluator.m_x0.data();
+		const float* __restrict x1 = evaluator.m_x1.data();
+		const float* __restrict y0 = evaluator.m_y0.data();
+		const float* __restrict y1 = evaluator.m_y1.data();
+		const float* __restrict m0 = evaluator.m_m0.data();
+		const float* __restrict m1 = evaluator.m_m1.data();
+		float* __restrict samples = evaluator.m_samples.data();
+		for (size_t i = 0; i < numTracks; ++i)
+			samples[i] = evaluateSegment(time, x0[i], x1[i], y0[i], y1[i], m0[i], m1[i]);
+
+		// Write the new values into the bound variables
+		for (size_t i = 0; i < numTracks; ++i)
+		{
+			if (evaluator.m_tracks[i]->m_times.empty()) continue;
+			for (size_t j = evaluator.m_variableOffsets[i]; j < evaluator.m_variableOffsets[i + 1]; ++j)
+				*evaluator.m_variables[j] = samples[i];
+		}
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -557,16 +662,7 @@ namespace KeyframedAnim
 		if (object->component<KeyFramedAnimComponent>().m_playState != KeyFramedAnimComponent::Stopped ||
 			(object->component<KeyFramedAnimComponent>().m_generateWhileStopped && object->component<KeyFramedAnimComponent>().m_isRecording == false))
 		{
-			for (const auto& trackIt : object->component<KeyFramedAnimComponent>().m_tracks)
-			{
-				Profiler::ScopedCpuPerfCounter perfCounter(scene, trackIt.first);
-
-				// Sample the track
-				float sample = KeyframedAnim::sampleTrack(trackIt.second, object->component<KeyFramedAnimComponent>().m_currentTime);
-
-				// Write the new variable into each track
-				for (auto variable : trackIt.second.m_variables) (*(variable.second)) = sample;
-			}
+			KeyframedAnim::evaluateTracks(scene, object, object->component<KeyFramedAnimComponent>().m_currentTime);
 		}
 
 		// Stop on finish
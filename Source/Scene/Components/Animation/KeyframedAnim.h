@@ -48,16 +48,44 @@ namespace KeyframedAnim
 		// ---- Private members
 
 		// Set of all the times and values
-		std::vector<double> m_times;
-		std::vector<double> m_values;
+		std::vector<float> m_times;
+		std::vector<float> m_values;
+
+		// Second derivatives of the interpolating spline at each node (all zeros for linear tracks)
+		std::vector<float> m_secondDerivatives;
 
 		// Minimum and maximum values along the track
 		float m_min = FLT_MAX;
 		float m_max = FLT_MAX;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////
+	/** Flattened representation of all the tracks of an animation, for evaluating them together. */
+	struct KeyFramedAnimEvaluator
+	{
+		// The track map that the evaluator was built from
+		const void* m_source = nullptr;
+
+		// Version of the track map that the evaluator was built from
+		size_t m_sourceVersion = 0;
+
+		// The tracks to evaluate
+		std::vector<KeyFramedAnimTrack const*> m_tracks;
+
+		// Cached segment index for each track
+		std::vector<size_t> m_cursors;
 
-		// Interpolation objects
-		gsl_interp* m_interp = nullptr;
-		gsl_interp_accel* m_interpAccel = nullptr;
+		// Bound variables; track i writes m_variables[m_variableOffsets[i] .. m_variableOffsets[i + 1])
+		std::vector<size_t> m_variableOffsets;
+		std::vector<float*> m_variables;
+
+		// Per-track segment end points, node values and second derivatives (SoA)
+		std::vector<float> m_x0, m_x1;
+		std::vector<float> m_y0, m_y1;
+		std::vector<float> m_m0, m_m1;
+
+		// The evaluated samples
+		std::vector<float> m_samples;
 	};
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -132,6 +160,12 @@ namespace KeyframedAnim
 		bool m_isRecording = false;
 		float m_recordStartTime = 0.0f;
 		float m_timeSinceLastFrame = 0.0f;
+
+		// Incremented whenever the tracks, their frames or their variable bindings change
+		size_t m_tracksVersion = 1;
+
+		// Batched track evaluation data
+		KeyFramedAnimEvaluator m_evaluator;
 	};
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -178,6 +212,12 @@ namespace KeyframedAnim
 
 	////////////////////////////////////////////////////////////////////////////////
 	void updateTrackInterpObjects(Scene::Scene& scene, Scene::Object* object);
+
+	////////////////////////////////////////////////////////////////////////////////
+	void markTracksChanged(Scene::Scene& scene, Scene::Object* object);
+
+	////////////////////////////////////////////////////////////////////////////////
+	void updateTrackEvaluator(Scene::Scene& scene, Scene::Object* object);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -32,6 +32,245 @@ namespace PhysicalCamera
 		Asset::loadShader(scene, "LensFlare/Aperture", "octagon_smooth");
 	}
 
+	////////////////////////////////////////////////////////////////////////////////
+	namespace aperture_bake_impl
+	{
+		////////////////////////////////////////////////////////////////////////////////
+		// Resolution of the baked diffraction textures; must be a power of two
+		static const size_t FFT_RESOLUTION = 512;
+
+		////////////////////////////////////////////////////////////////////////////////
+		// The aperture covers a quarter of the FFT grid at this f-number, and shrinks with larger ones
+		static const float REFERENCE_F_NUMBER = 1.4f;
+		static const float REFERENCE_APERTURE_RADIUS = FFT_RESOLUTION / 8.0f;
+		static const float MIN_APERTURE_RADIUS = 4.0f;
+
+		////////////////////////////////////////////////////////////////////////////////
+		// The f-number is quantized to this many steps per stop before baking, to bound the number of bakes
+		static const float F_NUMBER_STEPS_PER_STOP = 3.0f;
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Dynamic range of the log-compressed power spectrum, in decades
+		static const float SPECTRUM_DECADES = 6.0f;
+
+		////////////////////////////////////////////////////////////////////////////////
+		// CPU versions of the aperture distance functions in LensFlare/Aperture/common.glsl
+		float smaxPolynomial(const float a, const float b, const float k)
+		{
+			const float diff = a - b;
+			const float h = glm::clamp(0.5f + 0.5f * diff / k, 0.0f, 1.0f);
+			return b + h * (diff + k * (1.0f - h));
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		float smoothMask(const float dist)
+		{
+			return glm::smoothstep(0.95f, 0.8f, dist);
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		float apertureDist(PhysicalCameraAttributes::ApertureShape shape, const glm::vec2 pos)
+		{
+			const glm::vec2 absPos = glm::abs(pos);
+			switch (shape)
+			{
+			case PhysicalCameraAttributes::CircleAperture: return glm::length(pos);
+			case PhysicalCameraAttributes::OctagonAperture: return smaxPolynomial(glm::max(absPos.x, absPos.y), glm::dot(absPos, glm::vec2(0.70710678118f)), 0.1f);
+			}
+			return glm::length(pos);
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		std::string getShapeName(PhysicalCameraAttributes::ApertureShape shape)
+		{
+			switch (shape)
+			{
+			case PhysicalCameraAttributes::CircleAperture: return "Circle";
+			case PhysicalCameraAttributes::OctagonAperture: return "Octagon";
+			}
+			return "Texture";
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// The distance textures of the analytic shapes are rendered on the GPU by initApertureTextures
+		std::string getDistTextureName(PhysicalCameraAttributes const& camera)
+		{
+			return "Textures/FX/PhysicalLensFlare/apertureDist" + getShapeName(camera.m_apertureShape);
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// The f-number snapped to the nearest fraction of a stop; a stop is a factor of sqrt(2)
+		float quantizeFNumber(const float fNumber)
+		{
+			const float stops = 2.0f * glm::log2(glm::max(fNumber, REFERENCE_F_NUMBER));
+			return glm::pow(2.0f, glm::round(stops * F_NUMBER_STEPS_PER_STOP) / F_NUMBER_STEPS_PER_STOP / 2.0f);
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		std::string getFFTTexturePrefix(PhysicalCameraAttributes const& camera)
+		{
+			return "Textures/FX/PhysicalLensFlare/Baked/apertureFFT" + getShapeName(camera.m_apertureShape) + "_f";
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Whether the camera still points to the textures baked for one of the analytic shapes
+		bool usesBakedTextures(PhysicalCameraAttributes const& camera)
+		{
+			for (auto shape : { PhysicalCameraAttributes::CircleAperture, PhysicalCameraAttributes::OctagonAperture })
+			{
+				PhysicalCameraAttributes analytic;
+				analytic.m_apertureShape = shape;
+				if (camera.m_apertureTexture == getDistTextureName(analytic) || camera.m_apertureFFT.rfind(getFFTTexturePrefix(analytic), 0) == 0)
+					return true;
+			}
+			return false;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// The preset the camera was created from; interpolated zoom cameras fall back to their zoom group
+		PhysicalCameraAttributes const* findPreset(CameraPresets const& presets, PhysicalCameraAttributes const& camera)
+		{
+			if (auto it = presets.find(camera.m_name); it != presets.end())
+				return &it->second;
+			auto const& group = getZoomGroupPresets(presets, camera.m_zoomGroup);
+			return group.empty() ? nullptr : group.front();
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		std::string getFFTTextureName(PhysicalCameraAttributes const& camera)
+		{
+			return fmt::format("{}{:.2f}", getFFTTexturePrefix(camera), quantizeFNumber(camera.m_fNumber));
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// exp(-2 pi i k / n) for k in [0, n / 2)
+		std::vector<std::complex<float>> computeTwiddles(const size_t n)
+		{
+			std::vector<std::complex<float>> result(n / 2);
+			for (size_t k = 0; k < n / 2; ++k)
+				result[k] = std::complex<float>(std::polar(1.0, -2.0 * glm::pi<double>() * double(k) / double(n)));
+			return result;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// In-place iterative radix-2 FFT of n strided elements
+		void fft(std::complex<float>* data, const size_t n, const size_t stride, std::vector<std::complex<float>> const& twiddles)
+		{
+			// Bit reversal permutation
+			for (size_t i = 1, j = 0; i < n; ++i)
+			{
+				size_t bit = n >> 1;
+				for (; j & bit; bit >>= 1)
+					j ^= bit;
+				j ^= bit;
+				if (i < j) std::swap(data[i * stride], data[j * stride]);
+			}
+
+			// Butterflies
+			for (size_t len = 2; len <= n; len <<= 1)
+			{
+				const size_t halfLen = len / 2, twiddleStep = n / len;
+				for (size_t i = 0; i < n; i += len)
+				for (size_t j = 0; j < halfLen; ++j)
+				{
+					const std::complex<float> u = data[(i + j) * stride];
+					const std::complex<float> v = data[(i + j + halfLen) * stride] * twiddles[j * twiddleStep];
+					data[(i + j) * stride] = u + v;
+					data[(i + j + halfLen) * stride] = u - v;
+				}
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// 2D FFT of a square, row-major grid; rows and columns are transformed in parallel
+		void fft2D(std::vector<std::complex<float>>& data, const size_t n)
+		{
+			const auto twiddles = computeTwiddles(n);
+			Threading::threadedExecuteIndices(Threading::numThreads(),
+				[&](Threading::ThreadedExecuteEnvironment const& environment, const size_t row)
+				{ fft(data.data() + row * n, n, 1, twiddles); }, n);
+			Threading::threadedExecuteIndices(Threading::numThreads(),
+				[&](Threading::ThreadedExecuteEnvironment const& environment, const size_t column)
+				{ fft(data.data() + column, n, n, twiddles); }, n);
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Log-compressed Fraunhofer power spectrum of the aperture, centered on the grid
+		std::vector<float> bakeFFTTexture(PhysicalCameraAttributes const& camera)
+		{
+			const size_t n = FFT_RESOLUTION;
+
+			// Rasterize the aperture mask into the center of the zero padded grid
+			const float radius = glm::max(REFERENCE_APERTURE_RADIUS * REFERENCE_F_NUMBER / quantizeFNumber(camera.m_fNumber), MIN_APERTURE_RADIUS);
+			std::vector<std::complex<float>> spectrum(n * n);
+			Threading::threadedExecuteIndices(Threading::numThreads(),
+				[&](Threading::ThreadedExecuteEnvironment const& environment, const size_t y, const size_t x)
+				{
+					const glm::vec2 pos = (glm::vec2(x, y) + 0.5f - float(n / 2)) / radius;
+					spectrum[y * n + x] = smoothMask(apertureDist(camera.m_apertureShape, pos));
+				}, n, n);
+
+			// Transform the mask
+			fft2D(spectrum, n);
+
+			// Normalize by the DC term, compress and shift the zero frequency to the center
+			const float dcPower = std::norm(spectrum[0]);
+			std::vector<float> result(n * n, 0.0f);
+			if (dcPower <= 0.0f) return result;
+
+			const float maxRelativePower = glm::pow(10.0f, SPECTRUM_DECADES);
+			Threading::threadedExecuteIndices(Threading::numThreads(),
+				[&](Threading::ThreadedExecuteEnvironment const& environment, const size_t y, const size_t x)
+				{
+					const float relativePower = std::norm(spectrum[y * n + x]) / dcPower;
+					const size_t shiftedX = (x + n / 2) % n, shiftedY = (y + n / 2) % n;
+					result[shiftedY * n + shiftedX] = glm::log(1.0f + relativePower * maxRelativePower) / glm::log(1.0f + maxRelativePower);
+				}, n, n);
+			return result;
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	void bakeApertureTextures(Scene::Scene& scene, CameraPresets const& presets, PhysicalCameraAttributes& camera)
+	{
+		// Restore the textures of the preset when switching back from an analytic shape
+		if (camera.m_apertureShape == PhysicalCameraAttributes::TextureAperture)
+		{
+			PhysicalCameraAttributes const* preset = aperture_bake_impl::findPreset(presets, camera);
+			if (preset != nullptr && aperture_bake_impl::usesBakedTextures(camera))
+			{
+				camera.m_apertureTexture = preset->m_apertureTexture;
+				camera.m_apertureFFT = preset->m_apertureFFT;
+			}
+			return;
+		}
+
+		// Diffraction texture, which also depends on the size of the opening
+		const std::string fftTextureName = aperture_bake_impl::getFFTTextureName(camera);
+		if (scene.m_textures.find(fftTextureName) == scene.m_textures.end())
+		{
+			DateTime::ScopedTimer timer = DateTime::ScopedTimer(Debug::Debug, 1, DateTime::Milliseconds, "Aperture FFT Bake");
+
+			// Only keep the texture of the current f-number for each shape
+			const std::string fftTexturePrefix = aperture_bake_impl::getFFTTexturePrefix(camera);
+			std::vector<std::string> staleTextures;
+			for (auto const& texture : scene.m_textures)
+				if (texture.first.rfind(fftTexturePrefix, 0) == 0)
+					staleTextures.push_back(texture.first);
+			for (auto const& textureName : staleTextures)
+				Scene::deleteTexture(scene, textureName);
+
+			const size_t n = aperture_bake_impl::FFT_RESOLUTION;
+			const std::vector<float> fft = aperture_bake_impl::bakeFFTTexture(camera);
+			Scene::createTexture(scene, fftTextureName, GL_TEXTURE_2D, n, n, 1, GL_R32F, GL_RED, GL_LINEAR, GL_LINEAR, GL_CLAMP_TO_EDGE, GL_FLOAT, fft.data());
+
+			Debug::log_debug() << "Baked aperture FFT texture: " << fftTextureName << Debug::end;
+		}
+
+		camera.m_apertureTexture = aperture_bake_impl::getDistTextureName(camera);
+		camera.m_apertureFFT = fftTextureName;
+	}
+
 	////////////////////////////////////////////////////////////////////////////////
 	PhysicalCamera::PhysicalCameraAttributes loadCameraPatent(Scene::Scene& scene, const std::string& patentName)
 	{
@@ -70,7 +309,7 @@ namespace PhysicalCamera
 			PhysicalCameraAttributes::LensComponent lens;
 
 			std::string elementType = element->FirstChildElement("type")->GetText();
-			if (elementType == "lensSpherical")
+			if (elementType == "lensSpherical" || elementType == "lensAspheric")
 			{
 				lens.m_height = element->FirstChildElement("height")->ToElement()->FloatText() * result.m_heightMultiplier;
 				lens.m_thickness = element->FirstChildElement("thickness")->ToElement()->FloatText();
@@ -79,6 +318,20 @@ namespace PhysicalCamera
 				lens.m_abbeNumber = element->FirstChildElement("abbeNumber")->ToElement()->FloatText();
 				lens.m_coatingWavelength = element->FirstChildElement("coatingLambda")->ToElement()->FloatText();
 				lens.m_coatingRefraction = element->FirstChildElement("coatingIor")->ToElement()->FloatText();
+
+				// Conic constant, followed by the even polynomial deformation terms
+				if (elementType == "lensAspheric")
+				{
+					lens.m_aspheric.push_back(0.0f);
+					if (tinyxml2::XMLElement* conicNode = element->FirstChildElement("conic"); conicNode)
+						lens.m_aspheric[0] = conicNode->FloatText();
+					if (tinyxml2::XMLElement* coefficientsNode = element->FirstChildElement("asphericCoefficients"); coefficientsNode && coefficientsNode->GetText())
+					{
+						std::istringstream coefficients(coefficientsNode->GetText());
+						for (float coefficient; coefficients >> coefficient;)
+							lens.m_aspheric.push_back(coefficient);
+					}
+				}
 			}
 			else if (elementType == "apertureStop")
 			{
@@ -196,6 +449,220 @@ namespace PhysicalCamera
 	}
 
 
+	////////////////////////////////////////////////////////////////////////////////
+	namespace patent_cache_impl
+	{
+		////////////////////////////////////////////////////////////////////////////////
+		// Identifies the cache layout; bump it whenever the stored attributes change
+		static const uint32_t CACHE_MAGIC = 0x4C504331; // 'LPC1'
+		static const uint32_t CACHE_VERSION = 5;
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Properties of the source xml that the cache is validated against
+		struct SourceStamp
+		{
+			uint64_t m_fileSize = 0;
+			int64_t m_lastWriteTime = 0;
+
+			bool operator==(SourceStamp const& other) const
+			{
+				return m_fileSize == other.m_fileSize && m_lastWriteTime == other.m_lastWriteTime;
+			}
+		};
+
+		////////////////////////////////////////////////////////////////////////////////
+		SourceStamp getSourceStamp(std::filesystem::path const& sourcePath)
+		{
+			SourceStamp result;
+			std::error_code ec;
+			result.m_fileSize = std::filesystem::file_size(sourcePath, ec);
+			result.m_lastWriteTime = std::filesystem::last_write_time(sourcePath, ec).time_since_epoch().count();
+			return result;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		std::filesystem::path getCacheFilePath(std::filesystem::path const& sourcePath)
+		{
+			return EnginePaths::generatedFilesFolder() / "Lenses" / (sourcePath.stem().string() + ".bin");
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		template<typename T>
+		void write(std::ofstream& file, T const& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			file.write((const char*)&value, sizeof(T));
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		template<typename T>
+		void write(std::ofstream& file, std::vector<T> const& values)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			write(file, uint64_t(values.size()));
+			file.write((const char*)values.data(), values.size() * sizeof(T));
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		void write(std::ofstream& file, std::string const& value)
+		{
+			write(file, uint64_t(value.size()));
+			file.write(value.data(), value.size());
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		template<typename T>
+		bool read(std::ifstream& file, T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			return bool(file.read((char*)&value, sizeof(T)));
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		template<typename T>
+		bool read(std::ifstream& file, std::vector<T>& values)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			uint64_t size;
+			if (!read(file, size)) return false;
+			values.resize(size);
+			return bool(file.read((char*)values.data(), size * sizeof(T)));
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		bool read(std::ifstream& file, std::string& value)
+		{
+			uint64_t size;
+			if (!read(file, size)) return false;
+			value.resize(size);
+			return bool(file.read(value.data(), size));
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		void saveCachedPatent(std::filesystem::path const& cachePath, SourceStamp const& stamp, PhysicalCameraAttributes const& camera)
+		{
+			EnginePaths::makeDirectoryStructure(cachePath, true);
+			std::ofstream file(cachePath, std::ofstream::binary);
+			if (!file) return;
+
+			// Header
+			write(file, CACHE_MAGIC);
+			write(file, CACHE_VERSION);
+			write(file, stamp);
+
+			// Optical system description
+			write(file, camera.m_name);
+			write(file, camera.m_fNumber);
+			write(file, camera.m_focalDistance);
+			write(file, camera.m_fieldOfView);
+			write(file, camera.m_filmSize);
+			write(file, camera.m_heightMultiplier);
+			write(file, camera.m_coatingRefraction);
+			write(file, camera.m_coatingWavelength);
+			write(file, camera.m_apertureShape);
+			write(file, camera.m_apertureTexture);
+			write(file, camera.m_apertureFFT);
+			write(file, camera.m_minWavelength);
+			write(file, camera.m_maxWavelength);
+			write(file, camera.m_maxNumWavelengths);
+			write(file, camera.m_spectralSampling);
+
+			// Lens elements
+			write(file, uint64_t(camera.m_lenses.size()));
+			for (auto const& lens : camera.m_lenses)
+			{
+				write(file, lens.m_thickness);
+				write(file, lens.m_radius);
+				write(file, lens.m_refraction);
+				write(file, lens.m_abbeNumber);
+				write(file, lens.m_height);
+				write(file, lens.m_aspheric);
+				write(file, lens.m_coatingWavelength);
+				write(file, lens.m_coatingThickness);
+				write(file, lens.m_coatingRefraction);
+			}
+
+			// Derived data
+			write(file, uint64_t(camera.m_wavelengths.size()));
+			for (auto const& wavelengths : camera.m_wavelengths)
+				write(file, wavelengths);
+			for (auto const& weights : camera.m_wavelengthWeights)
+				write(file, weights);
+			write(file, uint64_t(camera.m_ghosts.size()));
+			for (auto const& ghost : camera.m_ghosts)
+				write(file, ghost);
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		std::optional<PhysicalCameraAttributes> loadCachedPatent(std::filesystem::path const& cachePath, SourceStamp const& stamp)
+		{
+			std::ifstream file(cachePath, std::ifstream::binary);
+			if (!file) return std::nullopt;
+
+			// Validate the header against the source file
+			uint32_t magic, version;
+			SourceStamp cachedStamp;
+			if (!read(file, magic) || magic != CACHE_MAGIC) return std::nullopt;
+			if (!read(file, version) || version != CACHE_VERSION) return std::nullopt;
+			if (!read(file, cachedStamp) || !(cachedStamp == stamp)) return std::nullopt;
+
+			PhysicalCameraAttributes camera;
+
+			// Optical system description
+			bool valid =
+				read(file, camera.m_name) &&
+				read(file, camera.m_fNumber) &&
+				read(file, camera.m_focalDistance) &&
+				read(file, camera.m_fieldOfView) &&
+				read(file, camera.m_filmSize) &&
+				read(file, camera.m_heightMultiplier) &&
+				read(file, camera.m_coatingRefraction) &&
+				read(file, camera.m_coatingWavelength) &&
+				read(file, camera.m_apertureShape) &&
+				read(file, camera.m_apertureTexture) &&
+				read(file, camera.m_apertureFFT) &&
+				read(file, camera.m_minWavelength) &&
+				read(file, camera.m_maxWavelength) &&
+				read(file, camera.m_maxNumWavelengths) &&
+				read(file, camera.m_spectralSampling);
+
+			// Lens elements
+			uint64_t numLenses = 0;
+			valid = valid && read(file, numLenses);
+			camera.m_lenses.resize(valid ? numLenses : 0);
+			for (auto& lens : camera.m_lenses)
+			{
+				valid = valid &&
+					read(file, lens.m_thickness) &&
+					read(file, lens.m_radius) &&
+					read(file, lens.m_refraction) &&
+					read(file, lens.m_abbeNumber) &&
+					read(file, lens.m_height) &&
+					read(file, lens.m_aspheric) &&
+					read(file, lens.m_coatingWavelength) &&
+					read(file, lens.m_coatingThickness) &&
+					read(file, lens.m_coatingRefraction);
+			}
+
+			// Derived data
+			uint64_t numWavelengthSets = 0, numGhosts = 0;
+			valid = valid && read(file, numWavelengthSets);
+			camera.m_wavelengths.resize(valid ? numWavelengthSets : 0);
+			for (auto& wavelengths : camera.m_wavelengths)
+				valid = valid && read(file, wavelengths);
+			camera.m_wavelengthWeights.resize(camera.m_wavelengths.size());
+			for (auto& weights : camera.m_wavelengthWeights)
+				valid = valid && read(file, weights);
+			valid = valid && read(file, numGhosts);
+			camera.m_ghosts.resize(valid ? numGhosts : 0);
+			for (auto& ghost : camera.m_ghosts)
+				valid = valid && read(file, ghost);
+
+			if (!valid) return std::nullopt;
+			return camera;
+		}
+	}
+
 	////////////////////////////////////////////////////////////////////////////////
 	CameraPresets initCameraPatents(Scene::Scene& scene)
 	{
@@ -214,11 +681,122 @@ namespace PhysicalCamera
 			if (lensPatent.path().extension() != ".xml")
 				continue;
 
-			// Load the camera patent
-			std::string patentName = lensPatent.path().stem().string();
-			result[patentName] = loadCameraPatent(scene, lensPatent.path().filename().string());
+			// Use the cached prescription if the source has not changed since it was written
+			const std::string patentName = lensPatent.path().stem().string();
+			const auto stamp = patent_cache_impl::getSourceStamp(lensPatent.path());
+			const auto cachePath = patent_cache_impl::getCacheFilePath(lensPatent.path());
+			if (auto cached = patent_cache_impl::loadCachedPatent(cachePath, stamp); cached.has_value())
+			{
+				Debug::log_debug() << "Loaded cached lens patent: " << patentName << Debug::end;
+				result[patentName] = std::move(cached.value());
+				continue;
+			}
+
+			// Parse the camera patent and refresh the cache
+			PhysicalCameraAttributes camera = loadCameraPatent(scene, lensPatent.path().filename().string());
+			computeDerivedData(camera);
+			patent_cache_impl::saveCachedPatent(cachePath, stamp, camera);
+			result[patentName] = std::move(camera);
 		}
 
+		// Place the zoom presets within their focal ranges
+		computeZoomPositions(result);
+
+		return result;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	std::string getZoomGroupName(std::string const& patentName)
+	{
+		static const std::string s_zoomTag = "-zoom";
+		const size_t tagPos = patentName.find(s_zoomTag + "-");
+		return tagPos == std::string::npos ? std::string() : patentName.substr(0, tagPos + s_zoomTag.size());
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	std::vector<PhysicalCameraAttributes const*> getZoomGroupPresets(CameraPresets const& presets, std::string const& zoomGroup)
+	{
+		std::vector<PhysicalCameraAttributes const*> result;
+		if (zoomGroup.empty()) return result;
+
+		for (auto const& preset : presets)
+			if (preset.second.m_zoomGroup == zoomGroup)
+				result.push_back(&preset.second);
+
+		std::sort(result.begin(), result.end(), [](PhysicalCameraAttributes const* a, PhysicalCameraAttributes const* b)
+			{ return a->m_focalDistance < b->m_focalDistance; });
+
+		return result;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	bool hasMatchingGhost(PhysicalCameraAttributes const& preset, PhysicalCameraAttributes const& reference, std::vector<int> const& ghost)
+	{
+		// Surface indices only carry over if the two systems share their layout around the aperture
+		if (preset.m_lenses.size() != reference.m_lenses.size() || getApertureIndex(preset) != getApertureIndex(reference))
+			return false;
+
+		return std::find(preset.m_ghosts.begin(), preset.m_ghosts.end(), ghost) != preset.m_ghosts.end();
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	void computeZoomPositions(CameraPresets& presets)
+	{
+		// Assign the zoom groups
+		for (auto& preset : presets)
+		{
+			preset.second.m_zoomGroup = getZoomGroupName(preset.second.m_name);
+			preset.second.m_zoomPosition = 0.0f;
+		}
+
+		// Normalize the focal lengths within each group
+		for (auto& preset : presets)
+		{
+			auto const& group = getZoomGroupPresets(presets, preset.second.m_zoomGroup);
+			if (group.size() < 2) continue;
+
+			const float minFocalDistance = group.front()->m_focalDistance;
+			const float maxFocalDistance = group.back()->m_focalDistance;
+			if (maxFocalDistance > minFocalDistance)
+				preset.second.m_zoomPosition = (preset.second.m_focalDistance - minFocalDistance) / (maxFocalDistance - minFocalDistance);
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	PhysicalCameraAttributes interpolateZoomPosition(CameraPresets const& presets, std::string const& zoomGroup, const float zoomPosition)
+	{
+		auto const& group = getZoomGroupPresets(presets, zoomGroup);
+		if (group.empty()) return PhysicalCameraAttributes{};
+
+		// Find the neighboring presets
+		const float zoom = glm::clamp(zoomPosition, 0.0f, 1.0f);
+		size_t upperID = std::min(size_t(1), group.size() - 1);
+		while (upperID < group.size() - 1 && group[upperID]->m_zoomPosition < zoom)
+			++upperID;
+		PhysicalCameraAttributes const& lower = *group[upperID > 0 ? upperID - 1 : 0];
+		PhysicalCameraAttributes const& upper = *group[upperID];
+
+		// Start from the closest preset
+		const float range = upper.m_zoomPosition - lower.m_zoomPosition;
+		const float t = range > 0.0f ? glm::clamp((zoom - lower.m_zoomPosition) / range, 0.0f, 1.0f) : 0.0f;
+		PhysicalCameraAttributes result = t < 0.5f ? lower : upper;
+		result.m_zoomPosition = zoom;
+
+		// Name the result after the zoom position, so it doesn't alias the preset it was copied from
+		std::stringstream name;
+		name << zoomGroup << "-zoom" << std::fixed << std::setprecision(3) << zoom;
+		result.m_name = name.str();
+
+		// Only the element spacings move in a zoom lens; the surfaces and glasses are kept from the closest preset
+		if (lower.m_lenses.size() != upper.m_lenses.size())
+			return result;
+
+		result.m_fNumber = glm::mix(lower.m_fNumber, upper.m_fNumber, t);
+		result.m_focalDistance = glm::mix(lower.m_focalDistance, upper.m_focalDistance, t);
+		result.m_fieldOfView = glm::mix(lower.m_fieldOfView, upper.m_fieldOfView, t);
+		for (size_t i = 0; i < result.m_lenses.size(); ++i)
+			result.m_lenses[i].m_thickness = glm::mix(lower.m_lenses[i].m_thickness, upper.m_lenses[i].m_thickness, t);
+
 		return result;
 	}
 
@@ -232,6 +810,15 @@ namespace PhysicalCamera
 		if (descriptionChanged) camera = presets[camera.m_name];
 
 		systemChanged = systemChanged || descriptionChanged;
+		if (!camera.m_zoomGroup.empty())
+		{
+			float zoomPosition = camera.m_zoomPosition;
+			if (ImGui::SliderFloat("Zoom Position", &zoomPosition, 0.0f, 1.0f))
+			{
+				camera = interpolateZoomPosition(presets, camera.m_zoomGroup, zoomPosition);
+				systemChanged = lensesChanged = true;
+			}
+		}
 		systemChanged |= ImGui::SliderFloat("f-number", &camera.m_fNumber, 0, 64.0f);
 		systemChanged |= ImGui::SliderFloat("Focal Length", &camera.m_focalDistance, 0, 1000.0f);
 		systemChanged |= ImGui::SliderFloat("Field of View", &camera.m_fieldOfView, 0, 180.0f);
@@ -250,8 +837,10 @@ namespace PhysicalCamera
 		systemChanged |= ImGui::SliderFloat("Min Wavelength", &camera.m_minWavelength, 400.0f, 500.0f);
 		systemChanged |= ImGui::SliderFloat("Max Wavelength", &camera.m_maxWavelength, 600.0f, 800.0f);
 		systemChanged |= ImGui::SliderInt("Max Num Wavelengths", &camera.m_maxNumWavelengths, 1, 10);
+		systemChanged |= ImGui::Combo("Spectral Sampling", &camera.m_spectralSampling, PhysicalCameraAttributes::SpectralSamplingMethod_meta);
 		systemChanged |= ImGui::SliderFloat("Coating IoR", &camera.m_coatingRefraction, 1.0f, 2.0f);
 		systemChanged |= ImGui::SliderFloat("Coating Wavelength", &camera.m_coatingWavelength, 200.0f, 1200.0f);
+		systemChanged |= ImGui::Combo("Aperture Shape", &camera.m_apertureShape, PhysicalCameraAttributes::ApertureShape_meta);
 		systemChanged |= GuiSettings::generateTextureCombo(scene, "Aperture Texture", camera.m_apertureTexture);
 		systemChanged |= GuiSettings::generateTextureCombo(scene, "Aperture Texture FFT", camera.m_apertureFFT);
 
@@ -516,6 +1105,23 @@ namespace PhysicalCamera
 		return getCoatingThickness(camera, lensID, camera.m_wavelengths[numChannels][channelID]);
 	}
 
+	////////////////////////////////////////////////////////////////////////////////
+	float getConicConstant(PhysicalCameraAttributes const& camera, const size_t lensID)
+	{
+		auto const& aspheric = camera.m_lenses[lensID].m_aspheric;
+		return aspheric.empty() ? 0.0f : aspheric[0];
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	glm::vec4 getAsphericCoefficients(PhysicalCameraAttributes const& camera, const size_t lensID)
+	{
+		auto const& aspheric = camera.m_lenses[lensID].m_aspheric;
+		glm::vec4 result(0.0f);
+		for (size_t i = 1; i < aspheric.size() && i <= 4; ++i)
+			result[i - 1] = aspheric[i];
+		return result;
+	}
+
 	////////////////////////////////////////////////////////////////////////////////
 	std::vector<GhostIndices> enumerateGhosts(PhysicalCameraAttributes const& camera, const int reflections, const bool apertureCrossing)
 	{
@@ -545,17 +1151,129 @@ namespace PhysicalCamera
 		return enumerateGhosts(camera, reflections, apertureCrossing).size();
 	}
 
+	////////////////////////////////////////////////////////////////////////////////
+	namespace spectral_sampling_impl
+	{
+		////////////////////////////////////////////////////////////////////////////////
+		// Resolution of the dense reference spectrum, in nanometers
+		static const float SPECTRUM_STEP = 1.0f;
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Piecewise gaussian lobe of the multi-lobe CIE fit [Wyman et al. 2013]
+		float cieLobe(const float lambda, const float mu, const float sigmaLow, const float sigmaHigh)
+		{
+			const float t = (lambda - mu) / (lambda < mu ? sigmaLow : sigmaHigh);
+			return glm::exp(-0.5f * t * t);
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Sum of the dispersion strengths |dn/dlambda| of every glass in the system
+		float getDispersionStrength(PhysicalCameraAttributes const& camera, const float lambda)
+		{
+			// For n = A + B / lambda^2, the derivative is -2B / lambda^3
+			const float lambdaMuM = lambda * 1e-3f;
+			float result = 0.0f;
+			for (auto const& lens : camera.m_lenses)
+			{
+				if (lens.m_abbeNumber <= 0.0f) continue;
+				const float B = ((lens.m_refraction - 1.0f) / lens.m_abbeNumber) * 0.52345f;
+				result += glm::abs(2.0f * B / (lambdaMuM * lambdaMuM * lambdaMuM));
+			}
+			return result;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		void computeWavelengthsUniform(PhysicalCameraAttributes& camera, const int numWavelengths)
+		{
+			camera.m_wavelengths[numWavelengths].resize(numWavelengths);
+			camera.m_wavelengthWeights[numWavelengths].assign(numWavelengths, 1.0f);
+			const float lambdaStep = (camera.m_maxWavelength - camera.m_minWavelength) / std::max(numWavelengths - 1, 1);
+			for (size_t channelId = 0; channelId < numWavelengths; ++channelId)
+				camera.m_wavelengths[numWavelengths][channelId] = camera.m_minWavelength + channelId * lambdaStep;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Splits the spectrum into bins of equal importance, where the importance is the sensor response,
+		// scaled up where the glasses disperse the most. Each bin is represented by its importance-weighted
+		// centroid, weighted by 1/pdf relative to uniform sampling: the bin width over its 1/N sample share.
+		// The sensor response itself is applied by the shaders when converting the wavelengths to RGB.
+		void computeWavelengthsImportanceBinned(PhysicalCameraAttributes& camera, const int numWavelengths, 
+			std::vector<float> const& lambdas, std::vector<float> const& importance)
+		{
+			const float totalImportance = std::accumulate(importance.begin(), importance.end(), 0.0f);
+			if (totalImportance <= 0.0f)
+			{
+				computeWavelengthsUniform(camera, numWavelengths);
+				return;
+			}
+
+			camera.m_wavelengths[numWavelengths].resize(numWavelengths);
+			camera.m_wavelengthWeights[numWavelengths].resize(numWavelengths);
+
+			float cumulativeImportance = 0.0f;
+			for (size_t channelId = 0, sampleId = 0; channelId < numWavelengths; ++channelId)
+			{
+				// Collect the samples until the importance of this bin is reached
+				const float binEnd = totalImportance * float(channelId + 1) / float(numWavelengths);
+				const size_t binStart = sampleId;
+				float binImportance = 0.0f, binCentroid = 0.0f;
+				for (; sampleId < lambdas.size() && (cumulativeImportance < binEnd || channelId + 1 == numWavelengths); ++sampleId)
+				{
+					cumulativeImportance += importance[sampleId];
+					binImportance += importance[sampleId];
+					binCentroid += importance[sampleId] * lambdas[sampleId];
+				}
+				const float binWidth = float(sampleId - binStart) / float(lambdas.size());
+
+				// Fall back to the previous wavelength for empty bins, which may only happen with very narrow ranges
+				const float previous = channelId > 0 ? camera.m_wavelengths[numWavelengths][channelId - 1] : camera.m_minWavelength;
+				camera.m_wavelengths[numWavelengths][channelId] = binImportance > 0.0f ? binCentroid / binImportance : previous;
+				camera.m_wavelengthWeights[numWavelengths][channelId] = binWidth * numWavelengths;
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	float getSensorResponse(const float lambda)
+	{
+		using spectral_sampling_impl::cieLobe;
+
+		const float x = 1.056f * cieLobe(lambda, 599.8f, 37.9f, 31.0f) + 0.362f * cieLobe(lambda, 442.0f, 16.0f, 26.7f) - 0.065f * cieLobe(lambda, 501.1f, 20.4f, 26.2f);
+		const float y = 0.821f * cieLobe(lambda, 568.8f, 46.9f, 40.5f) + 0.286f * cieLobe(lambda, 530.9f, 16.3f, 31.1f);
+		const float z = 1.217f * cieLobe(lambda, 437.0f, 11.8f, 36.0f) + 0.681f * cieLobe(lambda, 459.0f, 26.0f, 13.8f);
+		return glm::max(x, 0.0f) + y + z;
+	}
+
 	////////////////////////////////////////////////////////////////////////////////
 	void computeWavelengths(PhysicalCameraAttributes& camera)
 	{
 		camera.m_wavelengths.resize(camera.m_maxNumWavelengths + 1);
-		for (int i = 1; i <= camera.m_maxNumWavelengths; ++i)
+		camera.m_wavelengthWeights.resize(camera.m_maxNumWavelengths + 1);
+
+		if (camera.m_spectralSampling == PhysicalCameraAttributes::UniformSpectralSampling)
 		{
-			camera.m_wavelengths[i].resize(i);
-			const float lambdaStep = (camera.m_maxWavelength - camera.m_minWavelength) / std::max(i - 1, 1);
-			for (size_t channelId = 0; channelId < i; ++channelId)
-				camera.m_wavelengths[i][channelId] = camera.m_minWavelength + channelId * lambdaStep;
+			for (int i = 1; i <= camera.m_maxNumWavelengths; ++i)
+				spectral_sampling_impl::computeWavelengthsUniform(camera, i);
+			return;
 		}
+
+		// Evaluate the dense reference spectrum
+		std::vector<float> lambdas, response, dispersion;
+		for (float lambda = camera.m_minWavelength; lambda <= camera.m_maxWavelength; lambda += spectral_sampling_impl::SPECTRUM_STEP)
+		{
+			lambdas.push_back(lambda);
+			response.push_back(getSensorResponse(lambda));
+			dispersion.push_back(spectral_sampling_impl::getDispersionStrength(camera, lambda));
+		}
+
+		// Sensor response, emphasized proportionally to the relative dispersion strength
+		const float avgDispersion = dispersion.empty() ? 0.0f : std::accumulate(dispersion.begin(), dispersion.end(), 0.0f) / dispersion.size();
+		std::vector<float> importance(lambdas.size());
+		for (size_t i = 0; i < lambdas.size(); ++i)
+			importance[i] = response[i] * (1.0f + (avgDispersion > 0.0f ? dispersion[i] / avgDispersion : 0.0f));
+
+		for (int i = 1; i <= camera.m_maxNumWavelengths; ++i)
+			spectral_sampling_impl::computeWavelengthsImportanceBinned(camera, i, lambdas, importance);
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -567,4 +1285,114 @@ namespace PhysicalCamera
 			camera.m_lenses[i].m_coatingWavelength = camera.m_coatingWavelength;
 		}
 	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	void computeDerivedData(PhysicalCameraAttributes& camera)
+	{
+		computeWavelengths(camera);
+		camera.m_ghosts = enumerateGhosts(camera);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	namespace content_hash_impl
+	{
+		////////////////////////////////////////////////////////////////////////////////
+		// 64-bit FNV-1a; unlike std::hash, it is stable across runs and platforms
+		static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+		static const uint64_t FNV_PRIME = 1099511628211ull;
+
+		////////////////////////////////////////////////////////////////////////////////
+		void hashBytes(uint64_t& hash, const void* data, const size_t size)
+		{
+			const unsigned char* bytes = (const unsigned char*)data;
+			for (size_t i = 0; i < size; ++i)
+				hash = (hash ^ uint64_t(bytes[i])) * FNV_PRIME;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		template<typename T>
+		void hashValue(uint64_t& hash, T const& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be hashed directly.");
+			hashBytes(hash, &value, sizeof(T));
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		void hashValue(uint64_t& hash, std::string const& value)
+		{
+			hashValue(hash, uint64_t(value.size()));
+			hashBytes(hash, value.data(), value.size());
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		template<typename T>
+		void hashValue(uint64_t& hash, std::vector<T> const& values)
+		{
+			hashValue(hash, uint64_t(values.size()));
+			for (auto const& value : values)
+				hashValue(hash, value);
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		void hashSurface(uint64_t& hash, PhysicalCameraAttributes::LensComponent const& lens)
+		{
+			hashValue(hash, lens.m_thickness);
+			hashValue(hash, lens.m_radius);
+			hashValue(hash, lens.m_refraction);
+			hashValue(hash, lens.m_abbeNumber);
+			hashValue(hash, lens.m_height);
+			hashValue(hash, lens.m_aspheric);
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		void hashCoating(uint64_t& hash, PhysicalCameraAttributes::LensComponent const& lens)
+		{
+			hashValue(hash, lens.m_coatingWavelength);
+			hashValue(hash, lens.m_coatingThickness);
+			hashValue(hash, lens.m_coatingRefraction);
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	uint64_t hashPrescription(PhysicalCameraAttributes const& camera)
+	{
+		uint64_t hash = content_hash_impl::FNV_OFFSET_BASIS;
+		content_hash_impl::hashValue(hash, camera.m_fNumber);
+		content_hash_impl::hashValue(hash, camera.m_filmSize);
+		content_hash_impl::hashValue(hash, camera.m_heightMultiplier);
+		content_hash_impl::hashValue(hash, camera.m_apertureTexture);
+		content_hash_impl::hashValue(hash, camera.m_minWavelength);
+		content_hash_impl::hashValue(hash, camera.m_maxWavelength);
+		content_hash_impl::hashValue(hash, camera.m_spectralSampling);
+		content_hash_impl::hashValue(hash, uint64_t(camera.m_lenses.size()));
+		for (auto const& lens : camera.m_lenses)
+			content_hash_impl::hashSurface(hash, lens);
+		return hash;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	uint64_t hashGhost(PhysicalCameraAttributes const& camera, GhostIndices const& ghost)
+	{
+		// Every ghost path traverses the full system, so the whole prescription is an input; the
+		// coatings only enter through the Fresnel terms of the reflecting surfaces.
+		uint64_t hash = hashPrescription(camera);
+		content_hash_impl::hashValue(hash, ghost);
+		for (int surfaceId : ghost)
+			content_hash_impl::hashCoating(hash, camera.m_lenses[surfaceId]);
+		return hash;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	uint64_t hashCombine(const uint64_t hash, const void* data, const size_t size)
+	{
+		uint64_t result = hash;
+		content_hash_impl::hashBytes(result, data, size);
+		return result;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	std::string hashToString(const uint64_t hash)
+	{
+		return fmt::format("{:016x}", hash);
+	}
 }
\ No newline at end of file
@@ -24,6 +24,7 @@ namespace PhysicalCamera
 			float m_abbeNumber;
 			float m_height;
 
+			// Conic constant, followed by the 4th, 6th, 8th... order deformation coefficients
 			std::vector<float> m_aspheric;
 
 			float m_coatingWavelength;
@@ -42,15 +43,31 @@ namespace PhysicalCamera
 		float m_coatingRefraction;
 		float m_coatingWavelength;
 
+		// Aperture shape; texture apertures use the textures below as-is, analytic shapes bake them in-process
+		meta_enum(ApertureShape, int, TextureAperture, CircleAperture, OctagonAperture);
+		ApertureShape m_apertureShape = TextureAperture;
+
 		std::string m_apertureTexture;
 		std::string m_apertureFFT;
 		std::vector<LensComponent> m_lenses;
 
-		// Wavelengths to trace at
+		// Zoom group the prescription belongs to, and its normalized position in the group's focal range
+		std::string m_zoomGroup;
+		float m_zoomPosition = 0.0f;
+
+		// How the traced wavelengths are distributed in the spectral range
+		meta_enum(SpectralSamplingMethod, int, UniformSpectralSampling, ImportanceBinnedSpectralSampling);
+
+		// Wavelengths to trace at, and the relative weight of each wavelength in the final color
 		float m_minWavelength;
 		float m_maxWavelength;
 		int m_maxNumWavelengths;
+		SpectralSamplingMethod m_spectralSampling = UniformSpectralSampling;
 		std::vector<std::vector<float>> m_wavelengths;
+		std::vector<std::vector<float>> m_wavelengthWeights;
+
+		// Derived data, stored in the binary prescription cache
+		std::vector<std::vector<int>> m_ghosts;
 	};
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -62,9 +79,35 @@ namespace PhysicalCamera
 	////////////////////////////////////////////////////////////////////////////////
 	void initApertureShaders(Scene::Scene& scene);
 
+	////////////////////////////////////////////////////////////////////////////////
+	// Points the camera to the distance texture of analytic aperture shapes, and bakes their diffraction (FFT) 
+	// texture on the CPU; only the texture of the current, quantized f-number is kept for each shape.
+	// Texture apertures get the textures of their preset back if they still point to baked ones.
+	void bakeApertureTextures(Scene::Scene& scene, CameraPresets const& presets, PhysicalCameraAttributes& camera);
+
 	////////////////////////////////////////////////////////////////////////////////
 	CameraPresets initCameraPatents(Scene::Scene& scene);
 
+	////////////////////////////////////////////////////////////////////////////////
+	// Name of the zoom group for a patent (e.g. 'canon-zoom' for 'canon-zoom-mid'), or empty for prime lenses
+	std::string getZoomGroupName(std::string const& patentName);
+
+	////////////////////////////////////////////////////////////////////////////////
+	// Presets belonging to the given zoom group, ordered by their zoom position
+	std::vector<PhysicalCameraAttributes const*> getZoomGroupPresets(CameraPresets const& presets, std::string const& zoomGroup);
+
+	////////////////////////////////////////////////////////////////////////////////
+	// Whether a ghost of the reference camera is also a ghost of the preset, with its indices referring to the same surfaces
+	bool hasMatchingGhost(PhysicalCameraAttributes const& preset, PhysicalCameraAttributes const& reference, std::vector<int> const& ghost);
+
+	////////////////////////////////////////////////////////////////////////////////
+	// Assigns the normalized zoom positions of every zoom group based on their focal lengths
+	void computeZoomPositions(CameraPresets& presets);
+
+	////////////////////////////////////////////////////////////////////////////////
+	// Constructs the prescription at an arbitrary zoom position by interpolating the neighboring presets
+	PhysicalCameraAttributes interpolateZoomPosition(CameraPresets const& presets, std::string const& zoomGroup, const float zoomPosition);
+
 	////////////////////////////////////////////////////////////////////////////////
 	std::array<bool, 3> generateGui(Scene::Scene& scene, Scene::Object* guiSettings, Scene::Object* owner, 
 		CameraPresets& presets, PhysicalCameraAttributes& camera);
@@ -128,6 +171,13 @@ namespace PhysicalCamera
 	////////////////////////////////////////////////////////////////////////////////
 	float getCoatingThickness(PhysicalCameraAttributes const& camera, const size_t numChannels, const size_t lensID, const size_t channelID);
 
+	////////////////////////////////////////////////////////////////////////////////
+	float getConicConstant(PhysicalCameraAttributes const& camera, const size_t lensID);
+
+	////////////////////////////////////////////////////////////////////////////////
+	// Returns the 4th, 6th, 8th and 10th order deformation coefficients
+	glm::vec4 getAsphericCoefficients(PhysicalCameraAttributes const& camera, const size_t lensID);
+
 	////////////////////////////////////////////////////////////////////////////////
 	typedef std::vector<int> GhostIndices;
 
@@ -138,8 +188,36 @@ namespace PhysicalCamera
 	size_t getNumGhosts(PhysicalCameraAttributes const& camera, const int reflections = 2, const bool apertureCrossing = false);
 
 	////////////////////////////////////////////////////////////////////////////////
+	// Approximate total sensor response (sum of the CIE 1931 color matching functions) at the given wavelength
+	float getSensorResponse(const float lambda);
+
+	////////////////////////////////////////////////////////////////////////////////
+	// Wavelengths and weights for every channel count, either spaced evenly or importance binned
+	// according to the sensor response and the dispersion of the lens system
 	void computeWavelengths(PhysicalCameraAttributes& camera);
 
 	////////////////////////////////////////////////////////////////////////////////
 	void propagateCoatingInformation(PhysicalCameraAttributes& camera);
+
+	////////////////////////////////////////////////////////////////////////////////
+	// Computes the ghosts and wavelengths derived from the lens prescription
+	void computeDerivedData(PhysicalCameraAttributes& camera);
+
+	////////////////////////////////////////////////////////////////////////////////
+	// Stable content hash of every prescription attribute that affects the path of all ghosts
+	// (surface geometry, glasses, aperture and film); coatings are left out
+	uint64_t hashPrescription(PhysicalCameraAttributes const& camera);
+
+	////////////////////////////////////////////////////////////////////////////////
+	// Stable content hash of every input of a single ghost: the prescription, the reflecting surfaces
+	// and the coatings on them
+	uint64_t hashGhost(PhysicalCameraAttributes const& camera, GhostIndices const& ghost);
+
+	////////////////////////////////////////////////////////////////////////////////
+	// Extends a content hash with an arbitrary block of memory
+	uint64_t hashCombine(const uint64_t hash, const void* data, const size_t size);
+
+	////////////////////////////////////////////////////////////////////////////////
+	// Hexadecimal representation of a content hash, for use in file names
+	std::string hashToString(const uint64_t hash);
 }
\ No newline at end of file
@@ -170,88 +170,159 @@ namespace TiledLensFlare
 	namespace TransferMatrices
 	{
 		////////////////////////////////////////////////////////////////////////////////
-		void computeRaytraceLensFlareTransferMatrices(Scene::Scene& scene, Scene::Object* object)
+		static const size_t NUM_WAVELENGTHS = 3;
+
+		////////////////////////////////////////////////////////////////////////////////
+		// A single transfer matrix for each of the traced wavelengths
+		using ChannelMatrices = std::array<glm::mat2, NUM_WAVELENGTHS>;
+
+		////////////////////////////////////////////////////////////////////////////////
+		ChannelMatrices multiply(ChannelMatrices const& lhs, ChannelMatrices const& rhs)
 		{
-			static const size_t NUM_WAVELENGTHS = 3;
+			ChannelMatrices result;
+			for (size_t channelId = 0; channelId < NUM_WAVELENGTHS; ++channelId)
+				result[channelId] = lhs[channelId] * rhs[channelId];
+			return result;
+		}
 
-			// Camera parameters
-			auto const& camera = object->component<TiledLensFlareComponent>().m_camera;
+		////////////////////////////////////////////////////////////////////////////////
+		// Matrices of the individual interfaces, each followed by the translation to the next surface
+		struct InterfaceMatrices
+		{
+			std::vector<ChannelMatrices> m_forward;
+			std::vector<ChannelMatrices> m_backward;
+			std::vector<ChannelMatrices> m_reflectForward;
+			std::vector<ChannelMatrices> m_reflectBackward;
+		};
 
-			// Aperture id
+		////////////////////////////////////////////////////////////////////////////////
+		InterfaceMatrices computeInterfaceMatrices(PhysicalCamera::PhysicalCameraAttributes const& camera)
+		{
+			const int numLenses = camera.m_lenses.size();
 			const int apertureId = PhysicalCamera::getApertureId(camera);
 
-			// Ghost indices
-			auto const& ghostIndices = PhysicalCamera::enumerateGhosts(object->component<TiledLensFlareComponent>().m_camera);
+			InterfaceMatrices result;
+			result.m_forward.resize(numLenses);
+			result.m_backward.resize(numLenses);
+			result.m_reflectForward.resize(numLenses);
+			result.m_reflectBackward.resize(numLenses);
 
-			// List of ABCD matrices
-			auto& transferMatrices = object->component<TiledLensFlareComponent>().m_transferMatrices;
+			std::vector<float> n(numLenses);
+			for (size_t channelId = 0; channelId < NUM_WAVELENGTHS; ++channelId)
+			{
+				// Refractive indices at the current wavelength
+				const float lambda = camera.m_wavelengths[NUM_WAVELENGTHS][channelId];
+				for (int i = 0; i < numLenses; ++i)
+					n[i] = PhysicalCamera::cauchyDispersion(camera, i, lambda);
 
-			DateTime::ScopedTimer timer = DateTime::ScopedTimer(Debug::Debug, ghostIndices.size() * NUM_WAVELENGTHS, DateTime::Milliseconds, "Transfer Matrices");
+				for (int i = 1; i < numLenses; ++i)
+				{
+					const float r = camera.m_lenses[i].m_radius;
+					const glm::mat2 Tf = PhysicalCamera::translationMatrix(camera.m_lenses[i].m_thickness);
+					const glm::mat2 Tb = PhysicalCamera::translationMatrix(camera.m_lenses[i - 1].m_thickness);
 
-			// First perform the bounding pass
-			transferMatrices.resize(ghostIndices.size());
-			for (size_t ghostId = 0; ghostId < ghostIndices.size(); ++ghostId)
-			{
-				transferMatrices[ghostId].resize(NUM_WAVELENGTHS);
+					// Do not refract or reflect at the aperture
+					if (i == apertureId)
+					{
+						result.m_forward[i][channelId] = result.m_reflectBackward[i][channelId] = Tf;
+						result.m_backward[i][channelId] = result.m_reflectForward[i][channelId] = Tb;
+						continue;
+					}
+
+					result.m_forward[i][channelId] = Tf * PhysicalCamera::refractionMatrix(n[i - 1], n[i], r);
+					result.m_backward[i][channelId] = Tb * PhysicalCamera::refractionMatrix(n[i], n[i - 1], -r);
+					result.m_reflectForward[i][channelId] = Tb * PhysicalCamera::reflectionMatrix(r);
+					result.m_reflectBackward[i][channelId] = Tf * PhysicalCamera::reflectionMatrix(-r);
+				}
 			}
 
-			Threading::threadedExecuteIndices(Threading::numThreads(),
-				[&](Threading::ThreadedExecuteEnvironment const& environment, const size_t ghostId, const size_t channelId)
-				{
-					// Ghost indices
-					const std::array<int, 2> ghost = { ghostIndices[ghostId][1], ghostIndices[ghostId][0] };
-					const float lambda = camera.m_wavelengths[NUM_WAVELENGTHS][channelId];
+			return result;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		void computeRaytraceLensFlareTransferMatrices(Scene::Scene& scene, Scene::Object* object)
+		{
+			// Camera parameters
+			auto const& camera = object->component<TiledLensFlareComponent>().m_camera;
+			const int numLenses = camera.m_lenses.size();
 
-					transferMatrices[ghostId][channelId].clear();
+			// Ghost indices
+			auto const& ghostIndices = object->component<TiledLensFlareComponent>().m_ghostIndices;
+
+			// List of ABCD matrices
+			auto& transferMatrices = object->component<TiledLensFlareComponent>().m_transferMatrices;
 
-					// The transfer matrix that is accumulated
-					glm::mat2 abcd = glm::mat2(1.0f, 0.0f, 0.0f, 1.0f);
+			DateTime::ScopedTimer timer = DateTime::ScopedTimer(Debug::Debug, ghostIndices.size() * NUM_WAVELENGTHS, DateTime::Milliseconds, "Transfer Matrices");
 
-					// Follow the ray through the system
-					int passId = 0, direction = 1;
-					for (int i = 1; i < camera.m_lenses.size(); i += direction)
-					{
-						// Store the matrix
-						transferMatrices[ghostId][channelId].push_back(abcd);
+			// Interface matrices for every wavelength
+			const InterfaceMatrices interfaces = computeInterfaceMatrices(camera);
 
-						// Do not refract or reflect at the aperture
-						if (i != apertureId)
-						{
-							if (passId <= 2 && ghost[passId] == i) // Reflection
-							{
-								const float r = direction * camera.m_lenses[i].m_radius;
-								const glm::mat2 Li = PhysicalCamera::reflectionMatrix(r);
+			// Matrices before each surface along the forward path, shared by every ghost up to its first reflection
+			std::vector<ChannelMatrices> forwardPrefix(numLenses);
+			forwardPrefix[1].fill(glm::mat2(1.0f));
+			for (int i = 2; i < numLenses; ++i)
+				forwardPrefix[i] = multiply(interfaces.m_forward[i - 1], forwardPrefix[i - 1]);
 
-								abcd = Li * abcd;
+			// Matrices before each surface on the way back from the first reflection, shared by ghosts with the same first reflection
+			std::vector<bool> firstReflections(numLenses, false);
+			for (auto const& ghost : ghostIndices)
+				firstReflections[ghost[1]] = true;
 
-								direction *= -1;
-								++passId;
-							}
-							else // refraction
-							{
-								const int prevI = (direction > 0) ? (i - 1) : (i);
-								const int currentI = (direction > 0) ? (i) : (i - 1);
+			std::vector<std::vector<ChannelMatrices>> backwardPrefixes(numLenses);
+			Threading::threadedExecuteIndices(Threading::numThreads(),
+				[&](Threading::ThreadedExecuteEnvironment const& environment, const size_t firstReflection)
+				{
+					if (!firstReflections[firstReflection]) return;
 
-								const float n0 = PhysicalCamera::cauchyDispersion(camera, prevI, lambda);
-								const float n1 = PhysicalCamera::cauchyDispersion(camera, currentI, lambda);
-								const float r = direction * camera.m_lenses[i].m_radius;
+					auto& backwardPrefix = backwardPrefixes[firstReflection];
+					backwardPrefix.resize(firstReflection);
+					backwardPrefix[firstReflection - 1] = multiply(interfaces.m_reflectForward[firstReflection], forwardPrefix[firstReflection]);
+					for (int i = int(firstReflection) - 1; i > 1; --i)
+						backwardPrefix[i - 1] = multiply(interfaces.m_backward[i], backwardPrefix[i]);
+				},
+				size_t(numLenses));
 
-								const glm::mat2 Ri = PhysicalCamera::refractionMatrix(n0, n1, r);
+			// Assemble the matrices of the individual ghosts
+			transferMatrices.resize(ghostIndices.size());
+			Threading::threadedExecuteIndices(Threading::numThreads(),
+				[&](Threading::ThreadedExecuteEnvironment const& environment, const size_t ghostId)
+				{
+					// Surfaces of the first and second reflections
+					const int first = ghostIndices[ghostId][1];
+					const int second = ghostIndices[ghostId][0];
+					auto const& backwardPrefix = backwardPrefixes[first];
+
+					// One matrix is stored before each visited surface
+					auto& ghostMatrices = transferMatrices[ghostId];
+					ghostMatrices.resize(NUM_WAVELENGTHS);
+					const size_t numMatrices = first + (first - second) + (numLenses - 1 - second);
+					for (auto& channelMatrices : ghostMatrices)
+						channelMatrices.resize(numMatrices);
+
+					size_t matrixId = 0;
+					auto store = [&](ChannelMatrices const& abcd)
+					{
+						for (size_t channelId = 0; channelId < NUM_WAVELENGTHS; ++channelId)
+							ghostMatrices[channelId][matrixId] = abcd[channelId];
+						++matrixId;
+					};
 
-								abcd = Ri * abcd;
-							}
-						}
+					// Forward until the first reflection, then backward until the second one
+					for (int i = 1; i <= first; ++i)
+						store(forwardPrefix[i]);
+					for (int i = first - 1; i >= second; --i)
+						store(backwardPrefix[i]);
 
-						// Do the translation
-						const int translateI = (direction > 0) ? (i) : (i - 1);
-						const float d = camera.m_lenses[translateI].m_thickness;
-						const glm::mat2 Ti = PhysicalCamera::translationMatrix(d);
-						//const glm::mat2 Ti = PhysicalCamera::translationMatrix(direction * d);
-						abcd = Ti * abcd;
+					// Forward again until the sensor
+					ChannelMatrices abcd = multiply(interfaces.m_reflectBackward[second], backwardPrefix[second]);
+					for (int i = second + 1; i < numLenses; ++i)
+					{
+						store(abcd);
+						if (i + 1 < numLenses)
+							abcd = multiply(interfaces.m_forward[i], abcd);
 					}
 				},
-				ghostIndices.size(),
-				NUM_WAVELENGTHS);
+				ghostIndices.size());
 		}
 	}
 
@@ -319,7 +390,7 @@ namespace TiledLensFlare
 	namespace Uniforms
 	{
 		////////////////////////////////////////////////////////////////////////////////
-		const size_t NUM_GPU_POLYNOMIAL_INPUTS_FULL = 6;
+		const size_t NUM_GPU_POLYNOMIAL_INPUTS_FULL = 7;
 		const size_t NUM_GPU_POLYNOMIAL_INPUTS_BAKED = 4;
 		const size_t NUM_GPU_POLYNOMIAL_OUTPUTS = 6;
 
@@ -343,6 +414,7 @@ namespace TiledLensFlare
 
 			GLint m_gridStartId;
 			GLint m_numPolynomialTerms;
+			GLint m_numGridRows;
 		};
 
 		////////////////////////////////////////////////////////////////////////////////
@@ -354,6 +426,8 @@ namespace TiledLensFlare
 			glm::vec4 m_refraction[2];
 			GLfloat m_height;
 			GLfloat m_aperture;
+			GLfloat m_conic;
+			alignas(sizeof(glm::vec4)) glm::vec4 m_aspheric;
 		};
 
 		////////////////////////////////////////////////////////////////////////////////
@@ -377,6 +451,7 @@ namespace TiledLensFlare
 			alignas(sizeof(glm::vec2)) glm::vec2 m_filmSize;
 
 			GLint m_numLenses;
+			GLfloat m_zoomPosition;
 
 			alignas(sizeof(glm::vec4)) glm::vec4 m_wavelengths[MAX_CHANNELS];
 			Lens m_lenses[MAX_CHANNELS][MAX_LENSES];
@@ -517,6 +592,7 @@ namespace TiledLensFlare
 			uniformDataGhostParams.m_lambda = camera.m_wavelengths[precomputeParams.m_numChannels][channelID];
 			uniformDataGhostParams.m_intensityScale = 1.0f;
 			uniformDataGhostParams.m_gridStartId = 0;
+			uniformDataGhostParams.m_numGridRows = numRays;
 
 			return { uniformDataGhostParams };
 		}
@@ -544,6 +620,8 @@ namespace TiledLensFlare
 				lensData[i].m_height = (i != apertureId) ? lens.m_height : physicalApertureHeight;
 				lensData[i].m_aperture = (i != apertureId) ? -1.0f : physicalApertureHeight;
 				lensData[i].m_center = glm::vec3(0.0f, 0.0f, lensDistance + lensData[i].m_curvature);
+				lensData[i].m_conic = (i != apertureId) ? PhysicalCamera::getConicConstant(camera, i) : 0.0f;
+				lensData[i].m_aspheric = (i != apertureId) ? PhysicalCamera::getAsphericCoefficients(camera, i) : glm::vec4(0.0f);
 				lensData[i].m_refraction[0].x = PhysicalCamera::cauchyDispersion(camera, glm::max(i - 1, 0), lambda);
 				lensData[i].m_refraction[0].y = lens.m_coatingRefraction;
 				lensData[i].m_refraction[0].z = PhysicalCamera::cauchyDispersion(camera, i, lambda);
@@ -590,10 +668,14 @@ namespace TiledLensFlare
 			lensFlareDataCommon.m_filmSize = camera.m_filmSize;
 
 			lensFlareDataCommon.m_numLenses = camera.m_lenses.size();
+			lensFlareDataCommon.m_zoomPosition = camera.m_zoomPosition;
 
-			// Upload the lens parameters for each channel
+			// Upload the lens parameters and the spectral weight for each channel
 			for (int channelID = 0; channelID < numWavelengths; ++channelID)
+			{
 				uploadLensUniforms(scene, object, lensFlareDataCommon.m_lenses[channelID], lensFlareDataCommon.m_wavelengths[channelID].x, numWavelengths, channelID);
+				lensFlareDataCommon.m_wavelengths[channelID].y = camera.m_wavelengthWeights[numWavelengths][channelID];
+			}
 
 			return lensFlareDataCommon;
 		}
@@ -668,6 +750,12 @@ namespace TiledLensFlare
 			builder.add(precomputeParams.m_slackAbsolute);
 			builder.add(precomputeParams.m_slackPercentage);
 			builder.add(precomputeParams.m_slackRays);
+			if (precomputeParams.m_pruneGhosts)
+			{
+				builder.add("pruned");
+				builder.add(precomputeParams.m_pruneThreshold);
+				builder.add(precomputeParams.m_ghostBudget);
+			}
 
 			return builder;
 		}
@@ -688,14 +776,12 @@ namespace TiledLensFlare
 		}
 
 		////////////////////////////////////////////////////////////////////////////////
-		std::string getFilenamePrefix(Scene::Scene& scene, Scene::Object* object,
-			PrecomputeGhostsParameters const& precomputeParams, PolynomialFitParameters const& fitParameters,
-			PhysicalCamera::PhysicalCameraAttributes const& camera)
+		// Precompute parameters that the ghost attribs used for fitting depend on
+		std::string getPrecomputeParametersName(Scene::Scene& scene, Scene::Object* object,
+			PrecomputeGhostsParameters const& precomputeParams, PolynomialFitParameters const& fitParameters)
 		{
 			FileNameBuilder builder;
 
-			builder.add(camera.m_name);
-			builder.add(camera.m_fNumber);
 			builder.add(precomputeParams.m_rayCount);
 			builder.add(precomputeParams.m_refinementSteps);
 			builder.add(precomputeParams.m_numChannels);
@@ -713,6 +799,26 @@ namespace TiledLensFlare
 			return builder;
 		}
 
+		////////////////////////////////////////////////////////////////////////////////
+		std::string getFilenamePrefix(Scene::Scene& scene, Scene::Object* object,
+			PrecomputeGhostsParameters const& precomputeParams, PolynomialFitParameters const& fitParameters,
+			PhysicalCamera::PhysicalCameraAttributes const& camera)
+		{
+			FileNameBuilder builder;
+
+			builder.add(camera.m_name);
+			builder.add(camera.m_fNumber);
+			builder.add(getPrecomputeParametersName(scene, object, precomputeParams, fitParameters));
+			if (precomputeParams.m_pruneGhosts)
+			{
+				builder.add("pruned");
+				builder.add(precomputeParams.m_pruneThreshold);
+				builder.add(precomputeParams.m_ghostBudget);
+			}
+
+			return builder;
+		}
+
 		////////////////////////////////////////////////////////////////////////////////
 		std::string getFileName(Scene::Scene& scene, Scene::Object* object,
 			PrecomputeGhostsParameters const& precomputeParams, PolynomialFitParameters const& fitParameters,
@@ -858,18 +964,11 @@ namespace TiledLensFlare
 		}
 
 		////////////////////////////////////////////////////////////////////////////////
-		std::string getPolynomialWeightsFileName(Scene::Scene& scene, Scene::Object* object,
-			PolynomialFitParameters const& fitParameters,
-			PhysicalCamera::PhysicalCameraAttributes const& camera,
-			std::string const& fileName)
+		std::string getPolynomialFitParametersName(Scene::Scene& scene, Scene::Object* object,
+			PolynomialFitParameters const& fitParameters)
 		{
 			FileNameBuilder builder;
 
-			builder.add(camera.m_name);
-			builder.add(camera.m_fNumber);
-			builder.add(fitParameters.m_ghostGeometryParameters.m_rayCount);
-			builder.add(fitParameters.m_ghostGeometryParameters.m_firstGhost);
-			builder.add(fitParameters.m_ghostGeometryParameters.m_numGhost);
 			builder.add(fitParameters.m_ghostGeometryParameters.m_numChannels);
 			builder.add(fitParameters.m_ghostGeometryParameters.m_numAngles);
 			builder.add(glm::degrees(fitParameters.m_ghostGeometryParameters.m_maxAngle));
@@ -890,6 +989,8 @@ namespace TiledLensFlare
 			builder.add(fitParameters.m_ghostGeometryParameters.m_includeZeroWeightedDataset);
 			builder.add(fitParameters.m_ghostGeometryParameters.m_includeZeroWeightedFit);
 			//builder.add(fitParameters.m_ghostGeometryParameters.m_shareNeighboringGeometries);
+			if (fitParameters.m_ghostGeometryParameters.m_halfPrecisionStorage) builder.add("half");
+			if (fitParameters.m_randomSeed != 0) builder.add("seed" + std::to_string(fitParameters.m_randomSeed));
 			if (fitParameters.m_fitMethod == PolynomialFitParameters::FitMethod::SimulatedAnnealing)
 			{
 				builder.add(fitParameters.m_annealingParams.m_numSamples);
@@ -900,12 +1001,119 @@ namespace TiledLensFlare
 				builder.add(fitParameters.m_polynomialRegressionParams.m_numSamples);
 				builder.add(fitParameters.m_polynomialRegressionParams.m_recursionDepth);
 				//builder.add(fitParameters.m_polynomialRegressionParams.m_fixedTermNumber);
+				if (fitParameters.m_polynomialRegressionParams.m_validationRatio > 0.0f)
+				{
+					builder.add("val" + std::to_string(int(fitParameters.m_polynomialRegressionParams.m_validationRatio * 100.0f)));
+					builder.add(fitParameters.m_polynomialRegressionParams.m_validationPatience);
+				}
+			}
+			if (fitParameters.m_fitMethod == PolynomialFitParameters::FitMethod::SparseRegression)
+			{
+				builder.add(fitParameters.m_sparseRegressionParams.m_numSamples);
+				builder.add(PolynomialFitParameters::SparseSelectionMethod_value_to_string(fitParameters.m_sparseRegressionParams.m_selectionMethod));
+				if (fitParameters.m_sparseRegressionParams.m_selectionMethod == PolynomialFitParameters::SparseSelectionMethod::Lasso)
+				{
+					builder.add(fitParameters.m_sparseRegressionParams.m_lassoPathSteps);
+					builder.add(fitParameters.m_sparseRegressionParams.m_lassoPathDecay);
+					builder.add(fitParameters.m_sparseRegressionParams.m_lassoMaxSweeps);
+					builder.add(fitParameters.m_sparseRegressionParams.m_lassoTolerance);
+				}
 			}
+
+			return builder;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		std::string getPolynomialWeightsFileName(Scene::Scene& scene, Scene::Object* object,
+			PolynomialFitParameters const& fitParameters,
+			PhysicalCamera::PhysicalCameraAttributes const& camera,
+			std::string const& fileName)
+		{
+			FileNameBuilder builder;
+
+			// Zoom range fits are shared by every preset of the zoom group
+			if (fitParameters.m_ghostGeometryParameters.m_fitZoomRange && !camera.m_zoomGroup.empty())
+			{
+				builder.add(camera.m_zoomGroup);
+				builder.add("zoom");
+			}
+			else
+			{
+				builder.add(camera.m_name);
+			}
+			builder.add(camera.m_fNumber);
+			builder.add(fitParameters.m_ghostGeometryParameters.m_rayCount);
+			builder.add(fitParameters.m_ghostGeometryParameters.m_firstGhost);
+			builder.add(fitParameters.m_ghostGeometryParameters.m_numGhost);
+			if (PrecomputeGhostsParameters const& precomputeParams = object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters; precomputeParams.m_pruneGhosts)
+			{
+				builder.add("pruned");
+				builder.add(precomputeParams.m_pruneThreshold);
+				builder.add(precomputeParams.m_ghostBudget);
+			}
+			builder.add(getPolynomialFitParametersName(scene, object, fitParameters));
 			builder.add(fileName);
 
 			return builder;
 		}
 
+		////////////////////////////////////////////////////////////////////////////////
+		// Content hash of a single ghost, for the given camera
+		std::string getGhostContentHash(Scene::Scene& scene, Scene::Object* object,
+			PhysicalCamera::PhysicalCameraAttributes const& camera, const size_t ghostID)
+		{
+			auto const& ghostIndices = object->component<TiledLensFlareComponent>().m_ghostIndices;
+			return PhysicalCamera::hashToString(PhysicalCamera::hashGhost(camera, ghostIndices[ghostID]));
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Content hash of every input of a single ghost's fit; zoom range fits depend on every preset of the zoom group
+		std::string getGhostFitContentHash(Scene::Scene& scene, Scene::Object* object,
+			PolynomialFitParameters const& fitParameters, const size_t ghostID)
+		{
+			auto const& camera = object->component<TiledLensFlareComponent>().m_camera;
+			auto const& ghost = object->component<TiledLensFlareComponent>().m_ghostIndices[ghostID];
+
+			if (!fitParameters.m_ghostGeometryParameters.m_fitZoomRange || camera.m_zoomGroup.empty())
+				return PhysicalCamera::hashToString(PhysicalCamera::hashGhost(camera, ghost));
+
+			uint64_t hash = 0;
+			size_t numMatchingPresets = 0;
+			for (auto preset : PhysicalCamera::getZoomGroupPresets(object->component<TiledLensFlareComponent>().m_cameraPresets, camera.m_zoomGroup))
+			{
+				if (!PhysicalCamera::hasMatchingGhost(*preset, camera, ghost)) continue;
+				++numMatchingPresets;
+
+				PhysicalCamera::PhysicalCameraAttributes presetCamera = *preset;
+				PhysicalCamera::propagateCoatingInformation(presetCamera);
+				const uint64_t presetHash = PhysicalCamera::hashGhost(presetCamera, ghost);
+				const float zoomPosition = preset->m_zoomPosition;
+				hash = PhysicalCamera::hashCombine(hash, &presetHash, sizeof(presetHash));
+				hash = PhysicalCamera::hashCombine(hash, &zoomPosition, sizeof(zoomPosition));
+			}
+
+			// Same fallback as the geometry computation when no preset produces the ghost
+			if (numMatchingPresets == 0)
+				return PhysicalCamera::hashToString(PhysicalCamera::hashGhost(camera, ghost));
+			return PhysicalCamera::hashToString(hash);
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		std::string getPolynomialWeightsGhostFileName(Scene::Scene& scene, Scene::Object* object,
+			PolynomialFitParameters const& fitParameters, const size_t ghostID)
+		{
+			FileNameBuilder builder;
+
+			builder.addFolder("Ghosts");
+			builder.add(getGhostFitContentHash(scene, object, fitParameters, ghostID));
+			builder.add(fitParameters.m_ghostGeometryParameters.m_rayCount);
+			builder.add(getPrecomputeParametersName(scene, object, object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters, fitParameters));
+			builder.add(getPolynomialFitParametersName(scene, object, fitParameters));
+			builder.addExtension("dat");
+
+			return builder;
+		}
+
 		////////////////////////////////////////////////////////////////////////////////
 		std::string getPolynomialWeightsFullFitFilePath(Scene::Scene& scene, Scene::Object* object,
 			PolynomialFitParameters const& fitParameters,
@@ -923,6 +1131,22 @@ namespace TiledLensFlare
 			return builder;
 		}
 
+		////////////////////////////////////////////////////////////////////////////////
+		std::string getPolynomialWeightsFullFitGhostFilePath(Scene::Scene& scene, Scene::Object* object, const size_t ghostID)
+		{
+			PolynomialFitParameters const& fitParameters = object->component<TiledLensFlareComponent>().m_polynomialFitParameters;
+
+			FileNameBuilder builder;
+
+			builder.addFolder(EnginePaths::generatedFilesFolder().string());
+			builder.addFolder("TiledLensFlare");
+			builder.addFolder("PolyWeightsFull");
+			builder.addFolder(PolynomialFitParameters::FitMethod_value_to_string(fitParameters.m_fitMethod));
+			builder.add(getPolynomialWeightsGhostFileName(scene, object, fitParameters, ghostID));
+
+			return builder;
+		}
+
 		////////////////////////////////////////////////////////////////////////////////
 		std::string getPolynomialWeightsFullFitFilePath(Scene::Scene& scene, Scene::Object* object,
 			std::string const& fileName = "weights.dat")
@@ -950,6 +1174,22 @@ namespace TiledLensFlare
 			return builder;
 		}
 
+		////////////////////////////////////////////////////////////////////////////////
+		std::string getPolynomialWeightsPartialFitGhostFilePath(Scene::Scene& scene, Scene::Object* object, const size_t ghostID)
+		{
+			PolynomialFitParameters const& fitParameters = object->component<TiledLensFlareComponent>().m_polynomialFitParameters;
+
+			FileNameBuilder builder;
+
+			builder.addFolder(EnginePaths::generatedFilesFolder().string());
+			builder.addFolder("TiledLensFlare");
+			builder.addFolder("PolyWeightsPartial");
+			builder.addFolder(PolynomialFitParameters::FitMethod_value_to_string(fitParameters.m_fitMethod));
+			builder.add(getPolynomialWeightsGhostFileName(scene, object, fitParameters, ghostID));
+
+			return builder;
+		}
+
 		////////////////////////////////////////////////////////////////////////////////
 		std::string getPolynomialWeightsPartialFitFilePath(Scene::Scene& scene, Scene::Object* object,
 			std::string const& fileName = "weights.dat")
@@ -994,14 +1234,28 @@ namespace TiledLensFlare
 		};
 
 		////////////////////////////////////////////////////////////////////////////////
-		/** Data describing the validity of a single entry */
+		/** Data describing the validity of a single entry, packed into a bitmask */
 		struct ValidityFlags
 		{
-			bool m_isTractable{ false };
-			bool m_isValid{ false };
-			bool m_isInternal{ false };
-			bool m_isOnSensor{ false };
-			bool m_isBoundary{ false };
+			enum Flag: uint8_t
+			{
+				Tractable = 1 << 0,
+				Valid = 1 << 1,
+				Internal = 1 << 2,
+				OnSensor = 1 << 3,
+				Boundary = 1 << 4,
+			};
+
+			bool test(const Flag flag) const { return (m_flags & flag) != 0; }
+			void set(const Flag flag, const bool value) { m_flags = uint8_t(value ? (m_flags | flag) : (m_flags & ~flag)); }
+
+			bool isTractable() const { return test(Tractable); }
+			bool isValid() const { return test(Valid); }
+			bool isInternal() const { return test(Internal); }
+			bool isOnSensor() const { return test(OnSensor); }
+			bool isBoundary() const { return test(Boundary); }
+
+			uint8_t m_flags{ 0 };
 		};
 
 		////////////////////////////////////////////////////////////////////////////////
@@ -1036,6 +1290,7 @@ namespace TiledLensFlare
 			float m_wavelength{ 0.0f };
 			float m_angle{ 0.0f };
 			float m_rotation{ 0.0f };
+			float m_zoomPosition{ 0.0f };
 			ValidityFlags m_validityFlags;
 		};
 		using GhostGeometry = std::vector<GeometryEntry>;
@@ -1071,13 +1326,187 @@ namespace TiledLensFlare
 			ostream << " - wavelength: " << entry.m_wavelength << ", " << std::endl;
 			ostream << " - angle: " << entry.m_angle << ", " << std::endl;
 			ostream << " - rotation: " << entry.m_rotation << ", " << std::endl;
-			ostream << " - isValid: " << entry.m_validityFlags.m_isValid << ", " << std::endl;
-			ostream << " - isInternal: " << entry.m_validityFlags.m_isInternal << ", " << std::endl;
-			ostream << " - isOnSensor: " << entry.m_validityFlags.m_isOnSensor << ", " << std::endl;
-			ostream << " - isBoundary: " << entry.m_validityFlags.m_isBoundary << " }" << std::endl;
+			ostream << " - isValid: " << entry.m_validityFlags.isValid() << ", " << std::endl;
+			ostream << " - isInternal: " << entry.m_validityFlags.isInternal() << ", " << std::endl;
+			ostream << " - isOnSensor: " << entry.m_validityFlags.isOnSensor() << ", " << std::endl;
+			ostream << " - isBoundary: " << entry.m_validityFlags.isBoundary() << " }" << std::endl;
 			return ostream;
 		}
 
+		////////////////////////////////////////////////////////////////////////////////
+		namespace compact_geometry_impl
+		{
+			////////////////////////////////////////////////////////////////////////////////
+			/** Vector attributes of an entry, stored as two separate columns each. */
+			static constexpr std::array<glm::vec2 GeometryEntry::*, 16> s_vectorAttributes =
+			{
+				&GeometryEntry::m_pupilPosCartesian,
+				&GeometryEntry::m_pupilPosCartesianNormalized,
+				&GeometryEntry::m_pupilPosPolar,
+				&GeometryEntry::m_pupilPosPolarNormalized,
+				&GeometryEntry::m_centeredPupilPosCartesian,
+				&GeometryEntry::m_centeredPupilPosCartesianNormalized,
+				&GeometryEntry::m_centeredPupilPosPolar,
+				&GeometryEntry::m_centeredPupilPosPolarNormalized,
+				&GeometryEntry::m_entrancePupilPosCartesian,
+				&GeometryEntry::m_entrancePupilPosCartesianNormalized,
+				&GeometryEntry::m_entrancePupilPosPolar,
+				&GeometryEntry::m_entrancePupilPosPolarNormalized,
+				&GeometryEntry::m_aperturePos,
+				&GeometryEntry::m_aperturePosNormalized,
+				&GeometryEntry::m_sensorPos,
+				&GeometryEntry::m_sensorPosNormalized,
+			};
+
+			////////////////////////////////////////////////////////////////////////////////
+			/** Scalar attributes of an entry that may be stored with reduced precision. */
+			static constexpr std::array<float GeometryEntry::*, 7> s_scalarAttributes =
+			{
+				&GeometryEntry::m_apertureDistAnalytical,
+				&GeometryEntry::m_apertureDistTexture,
+				&GeometryEntry::m_pupilApertureDistAbsolute,
+				&GeometryEntry::m_pupilApertureDistBounded,
+				&GeometryEntry::m_intensity,
+				&GeometryEntry::m_relativeRadius,
+				&GeometryEntry::m_clipFactor,
+			};
+
+			////////////////////////////////////////////////////////////////////////////////
+			/** Fit inputs of an entry; these are always stored with full precision. */
+			static constexpr std::array<float GeometryEntry::*, 4> s_inputAttributes =
+			{
+				&GeometryEntry::m_wavelength,
+				&GeometryEntry::m_angle,
+				&GeometryEntry::m_rotation,
+				&GeometryEntry::m_zoomPosition,
+			};
+			static constexpr size_t s_zoomPositionInputID = 3;
+
+			////////////////////////////////////////////////////////////////////////////////
+			static constexpr size_t s_numColumns = s_vectorAttributes.size() * 2 + s_scalarAttributes.size();
+
+			////////////////////////////////////////////////////////////////////////////////
+			float& attribute(GeometryEntry& entry, const size_t columnID)
+			{
+				if (columnID < s_vectorAttributes.size() * 2)
+					return (entry.*s_vectorAttributes[columnID / 2])[columnID % 2];
+				return entry.*s_scalarAttributes[columnID - s_vectorAttributes.size() * 2];
+			}
+
+			////////////////////////////////////////////////////////////////////////////////
+			float attribute(GeometryEntry const& entry, const size_t columnID)
+			{
+				return attribute(const_cast<GeometryEntry&>(entry), columnID);
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		/** Structure-of-arrays storage for a list of geometry entries, with optional half-precision attribute columns. */
+		struct CompactGhostGeometry
+		{
+			CompactGhostGeometry(const bool halfPrecision = false):
+				m_halfPrecision(halfPrecision),
+				m_size(0)
+			{
+				if (m_halfPrecision) m_halfColumns.resize(compact_geometry_impl::s_numColumns);
+				else m_fullColumns.resize(compact_geometry_impl::s_numColumns);
+			}
+
+			CompactGhostGeometry(GhostGeometry const& geometry, const bool halfPrecision):
+				CompactGhostGeometry(halfPrecision)
+			{
+				reserve(geometry.size());
+				for (GeometryEntry const& entry : geometry)
+					push_back(entry);
+			}
+
+			size_t size() const { return m_size; }
+			bool empty() const { return m_size == 0; }
+
+			void reserve(const size_t capacity)
+			{
+				for (auto& column : m_fullColumns) column.reserve(capacity);
+				for (auto& column : m_halfColumns) column.reserve(capacity);
+				for (auto& column : m_inputColumns) column.reserve(capacity);
+				m_ghostIDs.reserve(capacity);
+				m_validityFlags.reserve(capacity);
+			}
+
+			void push_back(GeometryEntry const& entry)
+			{
+				for (size_t columnID = 0; columnID < compact_geometry_impl::s_numColumns; ++columnID)
+				{
+					const float value = compact_geometry_impl::attribute(entry, columnID);
+					if (m_halfPrecision) m_halfColumns[columnID].push_back(glm::packHalf1x16(value));
+					else m_fullColumns[columnID].push_back(value);
+				}
+				for (size_t inputID = 0; inputID < m_inputColumns.size(); ++inputID)
+					m_inputColumns[inputID].push_back(entry.*compact_geometry_impl::s_inputAttributes[inputID]);
+				m_ghostIDs.push_back(entry.m_ghostID);
+				m_validityFlags.push_back(entry.m_validityFlags);
+				++m_size;
+			}
+
+			// Appends every entry of the other geometry, converting the precision if necessary
+			void append(CompactGhostGeometry const& other)
+			{
+				if (other.m_halfPrecision != m_halfPrecision)
+				{
+					reserve(m_size + other.m_size);
+					for (size_t entryID = 0; entryID < other.m_size; ++entryID)
+						push_back(other[entryID]);
+					return;
+				}
+				for (size_t columnID = 0; columnID < m_fullColumns.size(); ++columnID)
+					m_fullColumns[columnID].insert(m_fullColumns[columnID].end(), other.m_fullColumns[columnID].begin(), other.m_fullColumns[columnID].end());
+				for (size_t columnID = 0; columnID < m_halfColumns.size(); ++columnID)
+					m_halfColumns[columnID].insert(m_halfColumns[columnID].end(), other.m_halfColumns[columnID].begin(), other.m_halfColumns[columnID].end());
+				for (size_t inputID = 0; inputID < m_inputColumns.size(); ++inputID)
+					m_inputColumns[inputID].insert(m_inputColumns[inputID].end(), other.m_inputColumns[inputID].begin(), other.m_inputColumns[inputID].end());
+				m_ghostIDs.insert(m_ghostIDs.end(), other.m_ghostIDs.begin(), other.m_ghostIDs.end());
+				m_validityFlags.insert(m_validityFlags.end(), other.m_validityFlags.begin(), other.m_validityFlags.end());
+				m_size += other.m_size;
+			}
+
+			// Reconstructs a single entry
+			GeometryEntry operator[](const size_t entryID) const
+			{
+				GeometryEntry result;
+				for (size_t columnID = 0; columnID < compact_geometry_impl::s_numColumns; ++columnID)
+					compact_geometry_impl::attribute(result, columnID) = m_halfPrecision ?
+						glm::unpackHalf1x16(m_halfColumns[columnID][entryID]) :
+						m_fullColumns[columnID][entryID];
+				for (size_t inputID = 0; inputID < m_inputColumns.size(); ++inputID)
+					result.*compact_geometry_impl::s_inputAttributes[inputID] = m_inputColumns[inputID][entryID];
+				result.m_ghostID = m_ghostIDs[entryID];
+				result.m_validityFlags = m_validityFlags[entryID];
+				return result;
+			}
+
+			// Overrides the zoom position of every entry
+			void setZoomPosition(const float zoomPosition)
+			{
+				auto& column = m_inputColumns[compact_geometry_impl::s_zoomPositionInputID];
+				std::fill(column.begin(), column.end(), zoomPosition);
+			}
+
+			// Memory used by the stored entries
+			size_t sizeInBytes() const
+			{
+				const size_t columnSize = m_halfPrecision ? sizeof(glm::uint16) : sizeof(float);
+				return m_size * (compact_geometry_impl::s_numColumns * columnSize +
+					m_inputColumns.size() * sizeof(float) + sizeof(int) + sizeof(ValidityFlags));
+			}
+
+			bool m_halfPrecision;
+			size_t m_size;
+			std::vector<std::vector<float>> m_fullColumns;
+			std::vector<std::vector<glm::uint16>> m_halfColumns;
+			std::array<std::vector<float>, compact_geometry_impl::s_inputAttributes.size()> m_inputColumns;
+			std::vector<int> m_ghostIDs;
+			std::vector<ValidityFlags> m_validityFlags;
+		};
+
 		////////////////////////////////////////////////////////////////////////////////
 		GeometryEntry convertGpuEntry(const size_t ghostID, const float angle, const float rotation, const float lambda, 
 			GeometryEntryGPU const& entryGpu)
@@ -1246,11 +1675,17 @@ namespace TiledLensFlare
 				return isEntryValid(geometry[entryId], clipParameters);
 			}
 
+			////////////////////////////////////////////////////////////////////////////////
+			bool isEntryValid(GhostGeometry const& geometry, const int numRows, const int numCols, const int rowId, const int colId, ClipParameters const& clipParameters)
+			{
+				if (rowId < 0 || rowId >= numRows || colId < 0 || colId >= numCols) return false;
+				return isEntryValid(extractRay(geometry, numCols, rowId, colId), clipParameters);
+			}
+
 			////////////////////////////////////////////////////////////////////////////////
 			bool isEntryValid(GhostGeometry const& geometry, const int numRays, const int rowId, const int colId, ClipParameters const& clipParameters)
 			{
-				if (rowId < 0 || rowId >= numRays || colId < 0 || colId >= numRays) return false;
-				return isEntryValid(extractRay(geometry, numRays, rowId, colId), clipParameters);
+				return isEntryValid(geometry, numRays, numRays, rowId, colId, clipParameters);
 			}
 
 			////////////////////////////////////////////////////////////////////////////////
@@ -1270,11 +1705,19 @@ namespace TiledLensFlare
 				return isEntryValid(geometry[entryId], pupilMin, pupilMax);
 			}
 
+			////////////////////////////////////////////////////////////////////////////////
+			bool isNeighborValid(GhostGeometry const& geometry, const int numRows, const int numCols, const int rowId, const int colId, 
+				const int rowOffset, const int colOffset, ClipParameters const& clipParameters)
+			{
+				return isEntryValid(geometry, numRows, numCols, rowId + rowOffset, colId + colOffset, clipParameters);
+			}
+
 			////////////////////////////////////////////////////////////////////////////////
 			bool isNeighborValid(GhostGeometry const& geometry, const int rowId, const int colId, const int rowOffset, const int colOffset,
 				ClipParameters const& clipParameters)
 			{
-				return isEntryValid(geometry, int(std::sqrt(geometry.size())), rowId + rowOffset, colId + colOffset, clipParameters);
+				const int numRays = int(std::sqrt(geometry.size()));
+				return isNeighborValid(geometry, numRays, numRays, rowId, colId, rowOffset, colOffset, clipParameters);
 			}
 
 			////////////////////////////////////////////////////////////////////////////////
@@ -1362,25 +1805,26 @@ namespace TiledLensFlare
 			}
 
 			////////////////////////////////////////////////////////////////////////////////
-			bool isEntryInternalOrBoundary(GhostGeometry const& geometry, const int rowId, const int colId, ClipParameters const& clipParameters)
+			bool isEntryInternalOrBoundary(GhostGeometry const& geometry, const int numRows, const int numCols, const int rowId, const int colId, 
+				ClipParameters const& clipParameters)
 			{
 				// Calculate the valid flags
 				bool validFlags[3][3] =
 				{
 					{
-						isNeighborValid(geometry, rowId, colId, -1, -1, clipParameters),
-						isNeighborValid(geometry, rowId, colId, -1,  0, clipParameters),
-						isNeighborValid(geometry, rowId, colId, -1,  1, clipParameters),
+						isNeighborValid(geometry, numRows, numCols, rowId, colId, -1, -1, clipParameters),
+						isNeighborValid(geometry, numRows, numCols, rowId, colId, -1,  0, clipParameters),
+						isNeighborValid(geometry, numRows, numCols, rowId, colId, -1,  1, clipParameters),
 					},
 					{
-						isNeighborValid(geometry, rowId, colId,  0, -1, clipParameters),
-						isNeighborValid(geometry, rowId, colId,  0,  0, clipParameters),
-						isNeighborValid(geometry, rowId, colId,  0,  1, clipParameters),
+						isNeighborValid(geometry, numRows, numCols, rowId, colId,  0, -1, clipParameters),
+						isNeighborValid(geometry, numRows, numCols, rowId, colId,  0,  0, clipParameters),
+						isNeighborValid(geometry, numRows, numCols, rowId, colId,  0,  1, clipParameters),
 					},
 					{
-						isNeighborValid(geometry, rowId, colId,  1, -1, clipParameters),
-						isNeighborValid(geometry, rowId, colId,  1,  0, clipParameters),
-						isNeighborValid(geometry, rowId, colId,  1,  1, clipParameters),
+						isNeighborValid(geometry, numRows, numCols, rowId, colId,  1, -1, clipParameters),
+						isNeighborValid(geometry, numRows, numCols, rowId, colId,  1,  0, clipParameters),
+						isNeighborValid(geometry, numRows, numCols, rowId, colId,  1,  1, clipParameters),
 					},
 				};
 
@@ -1414,6 +1858,13 @@ namespace TiledLensFlare
 				return considerEntry;
 			}
 
+			////////////////////////////////////////////////////////////////////////////////
+			bool isEntryInternalOrBoundary(GhostGeometry const& geometry, const int rowId, const int colId, ClipParameters const& clipParameters)
+			{
+				const int numRays = int(std::sqrt(float(geometry.size())));
+				return isEntryInternalOrBoundary(geometry, numRays, numRays, rowId, colId, clipParameters);
+			}
+
 			////////////////////////////////////////////////////////////////////////////////
 			bool isEntryInternalOrBoundary(GhostGeometry const& geometry, const size_t entryId, const int numRays,
 				ClipParameters const& clipParameters)
@@ -1482,9 +1933,10 @@ namespace TiledLensFlare
 		}
 
 		////////////////////////////////////////////////////////////////////////////////
-		GhostGeometry computeGhostGeometry(Scene::Scene& scene, Scene::Object* object, 
+		/** Traces the rows [firstRow, firstRow + numRows) of the ray grid. */
+		GhostGeometry computeGhostGeometryRows(Scene::Scene& scene, Scene::Object* object, 
 			const size_t ghostID, const size_t channelID, const float angle, const float rotation,
-			const size_t numWavelengths, const size_t numRays, 
+			const size_t numWavelengths, const size_t numRays, const size_t firstRow, const size_t numRows,
 			const glm::vec2 pupilMin, const glm::vec2 pupilMax, const glm::vec2 pupilCenter, const glm::vec2 pupilRadius,
 			const float radiusClip, const float irisClip, const float intensityClip, const float refractionClip)
 		{
@@ -1505,6 +1957,8 @@ namespace TiledLensFlare
 
 			// Upload the common parameters
 			std::vector<Uniforms::GhostParams> ghostParams = Uniforms::uploadGhostParametersPrecompute(scene, object, lightData, ghostID, channelID, numRays, pupilMin, pupilMax, pupilCenter, pupilRadius);
+			ghostParams[0].m_gridStartId = GLint(firstRow * numRays);
+			ghostParams[0].m_numGridRows = GLint(numRows);
 			uploadBufferData(scene, "TiledLensFlareTracedGhostParams", ghostParams);
 
 			Uniforms::RenderGhostsLensUniforms lensFlareDataLens = Uniforms::uploadLensUniformsPrecompute(scene, object, lightData, numWavelengths, radiusClip, irisClip, intensityClip, refractionClip);
@@ -1514,7 +1968,7 @@ namespace TiledLensFlare
 			//Debug::log_debug() << "Aperture height: " << lensFlareDataLens.m_apertureHeight << Debug::end;
 
 			// resize the buffer
-			Scene::resizeGPUBuffer(scene, "TiledLensFlarePrecomputeGeometry", numRays * numRays * sizeof(GeometryEntryGPU), true);
+			Scene::resizeGPUBuffer(scene, "TiledLensFlarePrecomputeGeometry", numRays * numRows * sizeof(GeometryEntryGPU), true);
 			Scene::bindBuffer(scene, "TiledLensFlarePrecomputeGeometry");
 
 			// Bind the ghosts shader
@@ -1522,7 +1976,7 @@ namespace TiledLensFlare
 
 			// Dispatch the computation
 			const glm::ivec3 groupSize(8, 8, 1);
-			const glm::ivec3 numWorkItems(numRays, numRays, 1);
+			const glm::ivec3 numWorkItems(numRays, numRows, 1);
 			const glm::ivec3 numWorkGroups = Common::getNumWorkGroups(groupSize, numWorkItems);
 			glDispatchCompute(numWorkGroups.x, numWorkGroups.y, numWorkGroups.z);
 			glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
@@ -1536,8 +1990,8 @@ namespace TiledLensFlare
 				Debug::log_error() << "Unable to map data buffer." << Debug::end;
 
 			// Copy over the resulting traced rays to the output buffer
-			GhostGeometry result(numRays * numRays);
-			std::transform(tracedRays, tracedRays + numRays * numRays, result.begin(), [&](GeometryEntryGPU const& gpuEntry)
+			GhostGeometry result(numRays * numRows);
+			std::transform(tracedRays, tracedRays + numRays * numRows, result.begin(), [&](GeometryEntryGPU const& gpuEntry)
 				{ return convertGpuEntry(ghostID, angle, rotation, camera.m_wavelengths[numWavelengths][channelID], gpuEntry); });
 
 			// Unmap the buffer
@@ -1548,48 +2002,152 @@ namespace TiledLensFlare
 		}
 
 		////////////////////////////////////////////////////////////////////////////////
-		GhostGeometry computeGhostGeometry(Scene::Scene& scene, Scene::Object* object,
+		GhostGeometry computeGhostGeometry(Scene::Scene& scene, Scene::Object* object, 
 			const size_t ghostID, const size_t channelID, const float angle, const float rotation,
-			const size_t numWavelengths, const size_t numRays, const glm::vec2 pupilMin, const glm::vec2 pupilMax,
+			const size_t numWavelengths, const size_t numRays, 
+			const glm::vec2 pupilMin, const glm::vec2 pupilMax, const glm::vec2 pupilCenter, const glm::vec2 pupilRadius,
 			const float radiusClip, const float irisClip, const float intensityClip, const float refractionClip)
 		{
-			return computeGhostGeometry(scene, object, ghostID, channelID, angle, rotation, numWavelengths, numRays, 
-				pupilMin, pupilMax, (pupilMax + pupilMin) / 2.0f, (pupilMax - pupilMin) / 2.0f,
-				radiusClip, irisClip, intensityClip, refractionClip);
+			return computeGhostGeometryRows(scene, object, ghostID, channelID, angle, rotation, numWavelengths, numRays, 0, numRays,
+				pupilMin, pupilMax, pupilCenter, pupilRadius, radiusClip, irisClip, intensityClip, refractionClip);
 		}
 
 		////////////////////////////////////////////////////////////////////////////////
 		GhostGeometry computeGhostGeometry(Scene::Scene& scene, Scene::Object* object,
-			const size_t ghostID, const size_t channelID, const float angle, const float rotation, 
-			PrecomputeGhostAttribs const& ghostAttribs, PrecomputeGhostsParameters const& precomputeParams)
+			const size_t ghostID, const size_t channelID, const float angle, const float rotation,
+			const size_t numWavelengths, const size_t numRays, const glm::vec2 pupilMin, const glm::vec2 pupilMax,
+			const float radiusClip, const float irisClip, const float intensityClip, const float refractionClip)
 		{
-			return computeGhostGeometry(scene, object, ghostID, channelID, angle, rotation, 
-				precomputeParams.m_numChannels, precomputeParams.m_rayCount, ghostAttribs.m_pupilMin, ghostAttribs.m_pupilMax,
-				precomputeParams.m_radiusClipping, precomputeParams.m_irisClipping, precomputeParams.m_intensityClipping, 
-				precomputeParams.m_refractionClipping);
+			return computeGhostGeometry(scene, object, ghostID, channelID, angle, rotation, numWavelengths, numRays, 
+				pupilMin, pupilMax, (pupilMax + pupilMin) / 2.0f, (pupilMax - pupilMin) / 2.0f,
+				radiusClip, irisClip, intensityClip, refractionClip);
 		}
-		
+
+		////////////////////////////////////////////////////////////////////////////////
+		/** A band of rows of the ray grid, with one extra halo row on each side (where available) for the neighbor tests. */
+		struct GeometryChunk
+		{
+			// The traced rows, including the halo
+			GhostGeometry m_entries;
+
+			// Width of the full grid
+			int m_numRays = 0;
+
+			// Rows stored in the chunk (including the halo)
+			int m_firstRow = 0;
+			int m_numRows = 0;
+
+			// Rows that belong to this chunk
+			int m_firstOwnedRow = 0;
+			int m_numOwnedRows = 0;
+
+			size_t ownedBegin() const { return size_t(m_firstOwnedRow - m_firstRow) * m_numRays; }
+			size_t ownedEnd() const { return size_t(m_firstOwnedRow - m_firstRow + m_numOwnedRows) * m_numRays; }
+		};
+
+		////////////////////////////////////////////////////////////////////////////////
+		/** Traces the ray grid band-by-band, holding at most maxChunkRays rays (plus the halo) in memory at once. */
+		template<typename Fn>
+		void traceGhostGeometryChunks(Scene::Scene& scene, Scene::Object* object,
+			const size_t ghostID, const size_t channelID, const float angle, const float rotation,
+			PrecomputeGhostAttribs const& ghostAttribs, PrecomputeGhostsParameters const& precomputeParams, Fn const& fn)
+		{
+			const int numRays = precomputeParams.m_rayCount;
+			const int chunkRows = glm::clamp(precomputeParams.m_maxChunkRays / numRays, 1, numRays);
+
+			for (int firstOwnedRow = 0; firstOwnedRow < numRays; firstOwnedRow += chunkRows)
+			{
+				GeometryChunk chunk;
+				chunk.m_numRays = numRays;
+				chunk.m_firstOwnedRow = firstOwnedRow;
+				chunk.m_numOwnedRows = glm::min(chunkRows, numRays - firstOwnedRow);
+				chunk.m_firstRow = glm::max(firstOwnedRow - 1, 0);
+				chunk.m_numRows = glm::min(firstOwnedRow + chunk.m_numOwnedRows + 1, numRays) - chunk.m_firstRow;
+				chunk.m_entries = computeGhostGeometryRows(scene, object, ghostID, channelID, angle, rotation,
+					precomputeParams.m_numChannels, numRays, chunk.m_firstRow, chunk.m_numRows,
+					ghostAttribs.m_pupilMin, ghostAttribs.m_pupilMax, (ghostAttribs.m_pupilMax + ghostAttribs.m_pupilMin) / 2.0f, (ghostAttribs.m_pupilMax - ghostAttribs.m_pupilMin) / 2.0f,
+					precomputeParams.m_radiusClipping, precomputeParams.m_irisClipping, precomputeParams.m_intensityClipping,
+					precomputeParams.m_refractionClipping);
+				fn(chunk);
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		/** Temporary on-disk storage of traced chunks, for consumers that need a second pass over the grid. */
+		struct GeometrySpillFile
+		{
+			GeometrySpillFile(std::string const& filePath):
+				m_filePath(filePath)
+			{
+				Asset::makeDirectoryStructure(m_filePath);
+				m_file.open(m_filePath, std::fstream::binary | std::fstream::in | std::fstream::out | std::fstream::trunc);
+				if (!m_file) Debug::log_error() << "Unable to open geometry spill file: " << m_filePath << Debug::end;
+			}
+
+			~GeometrySpillFile()
+			{
+				m_file.close();
+				std::error_code errorCode;
+				std::filesystem::remove(m_filePath, errorCode);
+			}
+
+			void write(GeometryChunk const& chunk)
+			{
+				const int header[5] = { chunk.m_numRays, chunk.m_firstRow, chunk.m_numRows, chunk.m_firstOwnedRow, chunk.m_numOwnedRows };
+				m_file.write((char*)header, sizeof(header));
+				m_file.write((char*)chunk.m_entries.data(), chunk.m_entries.size() * sizeof(GeometryEntry));
+				++m_numChunks;
+			}
+
+			template<typename Fn>
+			void replay(Fn const& fn)
+			{
+				m_file.flush();
+				m_file.seekg(0);
+				for (size_t chunkID = 0; chunkID < m_numChunks && m_file; ++chunkID)
+				{
+					int header[5];
+					m_file.read((char*)header, sizeof(header));
+
+					GeometryChunk chunk;
+					chunk.m_numRays = header[0];
+					chunk.m_firstRow = header[1];
+					chunk.m_numRows = header[2];
+					chunk.m_firstOwnedRow = header[3];
+					chunk.m_numOwnedRows = header[4];
+					chunk.m_entries.resize(size_t(chunk.m_numRows) * chunk.m_numRays);
+					m_file.read((char*)chunk.m_entries.data(), chunk.m_entries.size() * sizeof(GeometryEntry));
+					fn(chunk);
+				}
+			}
+
+			std::string m_filePath;
+			std::fstream m_file;
+			size_t m_numChunks = 0;
+		};
+
 		////////////////////////////////////////////////////////////////////////////////
-		void saveFullGhostGeometry(Scene::Scene& scene, Scene::Object* object, GhostGeometry const& geometry, std::ofstream& outFile)
+		void saveFullGhostGeometry(Scene::Scene& scene, Scene::Object* object, GeometryChunk const& chunk, std::ofstream& outFile)
 		{
-			outFile.write((char*)geometry.data(), geometry.size() * sizeof(GeometryEntry));
+			outFile.write((char*)(chunk.m_entries.data() + chunk.ownedBegin()), (chunk.ownedEnd() - chunk.ownedBegin()) * sizeof(GeometryEntry));
 		}
 
 		////////////////////////////////////////////////////////////////////////////////
-		void saveValidGhostGeometry(Scene::Scene& scene, Scene::Object* object, GhostGeometry const& geometry, std::ofstream& outFile)
+		void saveValidGhostGeometry(Scene::Scene& scene, Scene::Object* object, GeometryChunk const& chunk, std::ofstream& outFile)
 		{
-			Filtering::filterGhostGeometryByRays(geometry, Filtering::ClipParameters(scene, object),
-				[&](const size_t id, GeometryEntry const& entry)
-				{ outFile.write((char*)&entry, sizeof(GeometryEntry)); });
+			const Filtering::ClipParameters clipParameters(scene, object);
+			for (size_t entryId = chunk.ownedBegin(); entryId < chunk.ownedEnd(); ++entryId)
+				if (Filtering::isEntryValid(chunk.m_entries[entryId], clipParameters))
+					outFile.write((char*)&chunk.m_entries[entryId], sizeof(GeometryEntry));
 		}
 
 		////////////////////////////////////////////////////////////////////////////////
-		void saveBoundedGhostGeometry(Scene::Scene& scene, Scene::Object* object, GhostGeometry const& geometry, 
+		void saveBoundedGhostGeometry(Scene::Scene& scene, Scene::Object* object, GeometryChunk const& chunk, 
 			const glm::vec2 pupilMin, const glm::vec2 pupilMax, std::ofstream& outFile)
 		{
-			Filtering::filterGhostGeometryByPupilRegion(geometry, pupilMin, pupilMax,
-				[&](const size_t id, GeometryEntry const& entry)
-				{ outFile.write((char*)&entry, sizeof(GeometryEntry)); });
+			for (size_t entryId = chunk.ownedBegin(); entryId < chunk.ownedEnd(); ++entryId)
+				if (Filtering::isEntryValid(chunk.m_entries[entryId], pupilMin, pupilMax))
+					outFile.write((char*)&chunk.m_entries[entryId], sizeof(GeometryEntry));
 		}
 	}
 
@@ -1689,7 +2247,7 @@ namespace TiledLensFlare
 			GhostFilePaths::FileNameBuilder builder;
 
 			builder.add(GhostFilePaths::getFilenamePrefix(scene, object, precomputeParams, camera));
-			builder.add(ghostID);
+			builder.add(GhostFilePaths::getGhostContentHash(scene, object, camera, ghostID));
 			builder.add(channelID);
 			builder.add(angleID);
 
@@ -1704,7 +2262,7 @@ namespace TiledLensFlare
 			GhostFilePaths::FileNameBuilder builder;
 
 			builder.add(GhostFilePaths::getFilenamePrefix(scene, object, precomputeParams, fitParameters, camera));
-			builder.add(ghostID);
+			builder.add(GhostFilePaths::getGhostContentHash(scene, object, camera, ghostID));
 			builder.add(channelID);
 			builder.add(angleID);
 
@@ -1775,16 +2333,19 @@ namespace TiledLensFlare
 		}
 
 		////////////////////////////////////////////////////////////////////////////////
-		void loadSingleGhostAttribsFile(Scene::Scene& scene, Scene::Object* object, std::string fileName)
+		std::unordered_map<std::string, PrecomputeGhostAttribs> readGhostAttribsFile(std::string const& fileName)
 		{
 			Debug::log_debug() << "Reading ghost attributes from: " << fileName << Debug::end;
 
+			std::unordered_map<std::string, PrecomputeGhostAttribs> result;
+
 			// Open the file containing all the ghost attributes for a single camera and precomputation preset
 			std::ifstream inFile(fileName, std::ifstream::binary);
 
 			// Load the number of ghost attributes stored in the file
-			size_t numAttribs;
+			size_t numAttribs = 0;
 			inFile.read((char*)&numAttribs, sizeof(numAttribs));
+			if (!inFile) return result;
 
 			Debug::log_debug() << "  > Number of attributes: " << numAttribs << Debug::end;
 
@@ -1794,6 +2355,7 @@ namespace TiledLensFlare
 				// Read the ghost attrib names length
 				size_t attribNameLength;
 				inFile.read((char*)&attribNameLength, sizeof(attribNameLength));
+				if (!inFile) break;
 
 				// Read the ghost attrib name
 				std::string attribName(attribNameLength, ' ');
@@ -1804,10 +2366,29 @@ namespace TiledLensFlare
 				// Read back the ghost attributes
 				PrecomputeGhostAttribs ghostAttribs;
 				inFile.read((char*)&ghostAttribs, sizeof(ghostAttribs));
+				if (!inFile) break;
 
-				// Store the result in the ghost attrib database
-				object->component<TiledLensFlareComponent>().m_precomputedGhostAttribs[attribName] = ghostAttribs;
+				// Store the result
+				result[attribName] = ghostAttribs;
 			}
+
+			return result;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		void storeGhostAttribs(Scene::Scene& scene, Scene::Object* object, std::unordered_map<std::string, PrecomputeGhostAttribs> const& ghostAttribs)
+		{
+			// Store the attributes in the ghost attrib database
+			for (auto const& [attribName, attribs] : ghostAttribs)
+				object->component<TiledLensFlareComponent>().m_precomputedGhostAttribs[attribName] = attribs;
+
+			++object->component<TiledLensFlareComponent>().m_ghostDataVersion;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		void loadSingleGhostAttribsFile(Scene::Scene& scene, Scene::Object* object, std::string fileName)
+		{
+			storeGhostAttribs(scene, object, readGhostAttribsFile(fileName));
 		}
 
 		////////////////////////////////////////////////////////////////////////////////
@@ -1871,42 +2452,52 @@ namespace TiledLensFlare
 		}
 
 		////////////////////////////////////////////////////////////////////////////////
-		PrecomputeGhostAttribs computeSingleGhostAttribs(Scene::Scene& scene, Scene::Object* object,
-			PrecomputeGhostsParameters const& precomputeParams,
-			const size_t ghostID, const size_t channelID, const size_t angleID, const float theta,
-			std::vector<GhostGeometry::GeometryEntry> const& geometry, const size_t refinementID)
+		/** Running state of the ghost attrib computation, fed one geometry chunk at a time. */
+		struct GhostAttribsAccumulator
 		{
+			GhostAttribsAccumulator(Scene::Scene& scene, Scene::Object* object, PrecomputeGhostsParameters const& precomputeParams,
+				const size_t ghostID, const size_t channelID, const size_t angleID, const float theta):
+				m_clipParameters(object->component<TiledLensFlareComponent>().m_camera, precomputeParams)
+			{
+				m_result.m_pupilMin = glm::vec2(FLT_MAX);
+				m_result.m_pupilMax = glm::vec2(-FLT_MAX);
+				m_result.m_sensorMin = glm::vec2(FLT_MAX);
+				m_result.m_sensorMax = glm::vec2(-FLT_MAX);
+				m_result.m_avgIntensity = 0.0f;
+				m_result.m_channelID = channelID;
+				m_result.m_angleID = angleID;
+				m_result.m_ghostID = ghostID;
+				m_result.m_theta = theta;
+			}
+
 			// Clip parameters
-			GhostGeometry::Filtering::ClipParameters clipParameters(object->component<TiledLensFlareComponent>().m_camera, precomputeParams);
+			GhostGeometry::Filtering::ClipParameters m_clipParameters;
 
-			// Count the number of valid rays
-			const int numValidRays = std::count_if(geometry.begin(), geometry.end(), [&](auto const& ray)
-				{ return GhostGeometry::Filtering::isEntryValid(ray, clipParameters); });
+			// The attribs being accumulated
+			PrecomputeGhostAttribs m_result;
 
-			// Return an empty ghost attrib if not valid rays were found
-			if (numValidRays <= 0)
-				return createInvalidAttrib(ghostID, channelID, angleID, theta);
+			// Number of valid rays encountered so far
+			size_t m_numValidRays = 0;
+		};
 
-			// Result of the computation
-			PrecomputeGhostAttribs result;
-			result.m_pupilMin = glm::vec2(FLT_MAX);
-			result.m_pupilMax = glm::vec2(-FLT_MAX);
-			result.m_sensorMin = glm::vec2(FLT_MAX);
-			result.m_sensorMax = glm::vec2(-FLT_MAX);
-			result.m_avgIntensity = 0.0f;
-			result.m_channelID = channelID;
-			result.m_angleID = angleID;
-			result.m_ghostID = ghostID;
-			result.m_theta = theta;
+		////////////////////////////////////////////////////////////////////////////////
+		void accumulateGhostAttribs(GhostAttribsAccumulator& accumulator, GhostGeometry::GeometryChunk const& chunk)
+		{
+			auto& result = accumulator.m_result;
 
-			// Process each entry
-			for (size_t entryId = 0; entryId < geometry.size(); ++entryId)
+			// Process each owned entry
+			for (size_t entryId = chunk.ownedBegin(); entryId < chunk.ownedEnd(); ++entryId)
 			{
 				// Extract the ray
-				auto const& ray = geometry[entryId];
+				auto const& ray = chunk.m_entries[entryId];
+
+				// Count the number of valid rays
+				const bool isValid = GhostGeometry::Filtering::isEntryValid(ray, accumulator.m_clipParameters);
+				if (isValid) ++accumulator.m_numValidRays;
 
 				// Only consider valid rays
-				if (!GhostGeometry::Filtering::isEntryInternalOrBoundary(geometry, entryId, clipParameters)) continue;
+				const int rowId = int(entryId) / chunk.m_numRays, colId = int(entryId) % chunk.m_numRays;
+				if (!GhostGeometry::Filtering::isEntryInternalOrBoundary(chunk.m_entries, chunk.m_numRows, chunk.m_numRays, rowId, colId, accumulator.m_clipParameters)) continue;
 
 				// Update the bounds
 				result.m_pupilMin = glm::min(result.m_pupilMin, ray.m_pupilPosCartesian);
@@ -1915,9 +2506,20 @@ namespace TiledLensFlare
 				result.m_sensorMax = glm::max(result.m_sensorMax, ray.m_sensorPos);
 
 				// Accumulate the intensity
-				if (GhostGeometry::Filtering::isEntryValid(ray, clipParameters)) 
+				if (isValid) 
 					result.m_avgIntensity += ray.m_intensity;
 			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		PrecomputeGhostAttribs finalizeGhostAttribs(Scene::Scene& scene, Scene::Object* object,
+			PrecomputeGhostsParameters const& precomputeParams, GhostAttribsAccumulator const& accumulator)
+		{
+			PrecomputeGhostAttribs result = accumulator.m_result;
+
+			// Return an empty ghost attrib if not valid rays were found
+			if (accumulator.m_numValidRays == 0)
+				return createInvalidAttrib(result.m_ghostID, result.m_channelID, result.m_angleID, result.m_theta);
 
 			// Camera parameters
 			const float pupilHeight = object->component<TiledLensFlareComponent>().m_camera.m_lenses[0].m_height;
@@ -1929,7 +2531,7 @@ namespace TiledLensFlare
 			addSlackAbsolute(result.m_pupilMin, result.m_pupilMax, precomputeParams.m_slackRays * stepSize); // expand the bounds by the size of a single ray
 			addSlackPercentage(result.m_pupilMin, result.m_pupilMax, precomputeParams.m_slackPercentage);
 			addSlackAbsolute(result.m_pupilMin, result.m_pupilMax, pupilHeight * precomputeParams.m_slackAbsolute);
-			result.m_avgIntensity /= float(numValidRays);
+			result.m_avgIntensity /= float(accumulator.m_numValidRays);
 
 			// Return the result
 			return result;
@@ -1970,7 +2572,7 @@ namespace TiledLensFlare
 
 			// Ghost attrib output file
 			std::ofstream ghostAttribsOutFile;
-			if (precomputeParams.m_computeGhostAttribs && precomputeParams.m_saveGhostAttribs)
+			if ((precomputeParams.m_computeGhostAttribs || precomputeParams.m_reuseGhostAttribs) && precomputeParams.m_saveGhostAttribs)
 			{
 				// Open the file
 				GhostFilePaths::openGhostAttribFile(scene, object, ghostAttribsOutFile);
@@ -1979,6 +2581,9 @@ namespace TiledLensFlare
 				ghostAttribsOutFile.write((char*)&numAttribs, sizeof(numAttribs));
 			}
 
+			// Number of attribs reused from a previous precomputation
+			size_t numReusedAttribs = 0;
+
 			// Render the ghosts themselves
 			for (int ghostID = firstGhost; ghostID < firstGhost + numGhosts && ghostID < ghostIndices.size(); ++ghostID)
 			{
@@ -2009,15 +2614,49 @@ namespace TiledLensFlare
 						const std::string ghostAttribName = getGhostAttribName(scene, object, ghostID, channelID, angleID);
 						const bool hasGhostAttrib = ghostAttribsMap.find(ghostAttribName) != ghostAttribsMap.end();
 
+						// Attribs are keyed by the content hash of the ghost, so an existing one is still up-to-date;
+						// explicitly computing the attribs always recomputes them, reusing only fills in the missing ones
+						const bool computeGhostAttrib = precomputeParams.m_computeGhostAttribs ||
+							(!hasGhostAttrib && (precomputeParams.m_reuseGhostAttribs || precomputeParams.m_saveBoundedGhostGeometry));
+						const bool reuseGhostAttrib = hasGhostAttrib && !computeGhostAttrib && precomputeParams.m_reuseGhostAttribs;
+						const bool needsGhostGeometry = precomputeParams.m_saveFullGhostGeometry ||
+							precomputeParams.m_saveValidGhostGeometry || precomputeParams.m_saveBoundedGhostGeometry;
+
 						// Compute the incident light angle on the horizontal axis
 						const float theta = precomputeParams.m_angleStep * angleID;
 
 						// Results of the computation
 						PrecomputeGhostAttribs ghostAttribs;
-						GhostGeometry::GhostGeometry ghostGeometry;
+
+						// Writes the owned rows of a chunk to the requested geometry files
+						auto saveGeometryChunk = [&](GhostGeometry::GeometryChunk const& chunk)
+						{
+							// Save the computed ghost geometry to disk (combined file)
+							if (precomputeParams.m_saveFullGhostGeometry)
+								GhostGeometry::saveFullGhostGeometry(scene, object, chunk, fullGeometryOutFile);
+
+							// Save the computed filtered ghost geometry to disk (combined file)
+							if (precomputeParams.m_saveValidGhostGeometry)
+								GhostGeometry::saveValidGhostGeometry(scene, object, chunk, validGeometryOutFile);
+
+							// Save the computed filtered ghost geometry to disk (combined file)
+							if (precomputeParams.m_saveBoundedGhostGeometry)
+								GhostGeometry::saveBoundedGhostGeometry(scene, object, chunk,
+									ghostAttribs.m_pupilMin, ghostAttribs.m_pupilMax, boundedGeometryOutFile);
+						};
+
+						// Reuse the memoized attribs, only tracing the geometry if it is to be saved
+						if (reuseGhostAttrib)
+						{
+							ghostAttribs = ghostAttribsMap[ghostAttribName];
+							ghostAttribs.m_ghostID = ghostID;
+							if (needsGhostGeometry)
+								GhostGeometry::traceGhostGeometryChunks(scene, object, ghostID, channelID, theta, 0.0f, ghostAttribs, precomputeParams, saveGeometryChunk);
+							++numReusedAttribs;
+						}
 
 						// Early out if an invalid attrib has already been encountered
-						if (precomputeParams.m_terminateOnFirstInvalid && invalidFound)
+						else if (precomputeParams.m_terminateOnFirstInvalid && invalidFound)
 						{
 							ghostAttribs = createInvalidAttrib(ghostID, channelID, angleID, theta);
 						}
@@ -2027,20 +2666,41 @@ namespace TiledLensFlare
 							ghostAttribs.m_pupilMin = -glm::vec2(precomputeParams.m_pupilExpansion * camera.m_lenses[0].m_height);
 							ghostAttribs.m_pupilMax = glm::vec2(precomputeParams.m_pupilExpansion * camera.m_lenses[0].m_height);
 
+							// The bounded geometry depends on the final attribs, so the last pass is spilled to disk and replayed afterwards
+							std::unique_ptr<GhostGeometry::GeometrySpillFile> spillFile;
+							if (computeGhostAttrib && precomputeParams.m_saveBoundedGhostGeometry)
+								spillFile = std::make_unique<GhostGeometry::GeometrySpillFile>(GhostFilePaths::getFilePath(scene, object, "geometry_spill.tmp"));
+
 							// Perform the various refinement steps
 							for (size_t refinementID = 0; refinementID <= refinementSteps; ++refinementID)
 							{
-								// Compute the generated ghost geometry
-								ghostGeometry = GhostGeometry::computeGhostGeometry(scene, object, ghostID, channelID, theta, 0.0f, ghostAttribs, precomputeParams);
+								// Only the last pass produces geometry that is saved
+								const bool lastPass = refinementID == refinementSteps;
+								const bool saveGeometry = lastPass && needsGhostGeometry;
+								if (!computeGhostAttrib && !saveGeometry) continue;
+
+								// Stream the generated ghost geometry through the attrib computation
+								GhostAttribsAccumulator accumulator(scene, object, precomputeParams, ghostID, channelID, angleID, theta);
+								GhostGeometry::traceGhostGeometryChunks(scene, object, ghostID, channelID, theta, 0.0f, ghostAttribs, precomputeParams,
+									[&](GhostGeometry::GeometryChunk const& chunk)
+									{
+										if (computeGhostAttrib) accumulateGhostAttribs(accumulator, chunk);
+										if (saveGeometry && spillFile) spillFile->write(chunk);
+										else if (saveGeometry) saveGeometryChunk(chunk);
+									});
 
 								// Compute the ghost attributes
-								if (precomputeParams.m_computeGhostAttribs || (!hasGhostAttrib && precomputeParams.m_saveBoundedGhostGeometry))
-									ghostAttribs = computeSingleGhostAttribs(scene, object, precomputeParams, ghostID, channelID, angleID, theta, ghostGeometry, refinementID);
+								if (computeGhostAttrib)
+									ghostAttribs = finalizeGhostAttribs(scene, object, precomputeParams, accumulator);
 							}
+
+							// Write out the spilled geometry now that the final bounds are known
+							if (spillFile)
+								spillFile->replay(saveGeometryChunk);
 						}
 
 						// Compute the ghost attributes
-						if (precomputeParams.m_computeGhostAttribs || (!hasGhostAttrib && precomputeParams.m_saveBoundedGhostGeometry))
+						if (computeGhostAttrib)
 							ghostAttribsMap[ghostAttribName] = ghostAttribs;
 
 						// Set the invalid flag
@@ -2052,24 +2712,13 @@ namespace TiledLensFlare
 
 						if (precomputeParams.m_saveGhostAttribs)
 							saveSingleGhostAttribs(scene, object, ghostAttribs, ghostAttribName, ghostAttribsOutFile);
-
-						// Save the computed ghost geometry to disk (combined file)
-						if (precomputeParams.m_saveFullGhostGeometry)
-							GhostGeometry::saveFullGhostGeometry(scene, object, ghostGeometry, fullGeometryOutFile);
-
-						// Save the computed filtered ghost geometry to disk (combined file)
-						if (precomputeParams.m_saveValidGhostGeometry)
-							GhostGeometry::saveValidGhostGeometry(scene, object, ghostGeometry, validGeometryOutFile);
-
-						// Save the computed filtered ghost geometry to disk (combined file)
-						if (precomputeParams.m_saveBoundedGhostGeometry)
-							GhostGeometry::saveBoundedGhostGeometry(scene, object, ghostGeometry,
-								ghostAttribs.m_pupilMin, ghostAttribs.m_pupilMax, boundedGeometryOutFile);
 					}
 				}
 			}
 
-			Debug::log_info() << "Ghost attribs successfully computed." << Debug::end;
+			++object->component<TiledLensFlareComponent>().m_ghostDataVersion;
+
+			Debug::log_info() << "Ghost attribs successfully computed (" << numReusedAttribs << "/" << numAttribs << " reused)." << Debug::end;
 		}
 
 		////////////////////////////////////////////////////////////////////////////////
@@ -2388,6 +3037,36 @@ namespace TiledLensFlare
 			return glm::ceil(ghostAttribs.m_rayGridSize * reduction);
 		}
 
+		////////////////////////////////////////////////////////////////////////////////
+		// Ray grid size matching the predicted screen footprint of the ghost, thinned out for dim ghosts
+		int computeFootprintRayGridSize(Scene::Scene& scene, Scene::Object* object, RenderGhostAttribs const& ghostAttribs)
+		{
+			RenderGhostsParameters const& renderParams = object->component<TiledLensFlareComponent>().m_renderGhostsParameters;
+
+			// Predicted footprint of the ghost, in render target pixels
+			const glm::vec2 filmSize = object->component<TiledLensFlareComponent>().m_camera.m_filmSize;
+			const glm::vec2 projectedSize = glm::max(ghostAttribs.m_sensorMax - ghostAttribs.m_sensorMin, glm::vec2(0.0f));
+			const glm::vec2 footprint = (projectedSize / filmSize) * glm::vec2(Common::computeRenderResolution(scene, object));
+
+			// Relative importance of the ghost, based on its average intensity
+			const float relativeIntensity = ghostAttribs.m_avgIntensity / glm::max(renderParams.m_rayCountFullIntensity, 1e-6f);
+			const float intensityFactor = glm::clamp(glm::pow(relativeIntensity, renderParams.m_rayCountIntensityPower), 0.0f, 1.0f);
+
+			const float rayGridSize = glm::ceil(glm::sqrt(footprint.x * footprint.y) * renderParams.m_rayCountFootprintDensity * intensityFactor);
+			return glm::clamp(int(rayGridSize), glm::min(renderParams.m_minRayCount, ghostAttribs.m_rayGridSize), ghostAttribs.m_rayGridSize);
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		int computeRayGridSize(Scene::Scene& scene, Scene::Object* object, RenderGhostAttribs const& ghostAttribs)
+		{
+			switch (object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_rayCountMethod)
+			{
+			case RenderGhostsParameters::DynamicSensorSizeBased: return computeReducedRayGridSize(scene, object, ghostAttribs);
+			case RenderGhostsParameters::DynamicFootprintBased: return computeFootprintRayGridSize(scene, object, ghostAttribs);
+			}
+			return ghostAttribs.m_rayGridSize;
+		}
+
 		////////////////////////////////////////////////////////////////////////////////
 		// theta    - rotation on the xz plane
 		// rotation - rotation about the optical axis
@@ -2440,7 +3119,7 @@ namespace TiledLensFlare
 			result.m_rayGridSize = object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_rayCount;
 
 			// Extract the two neighboring ghost parameters
-			std::array<PrecomputeGhostAttribs, 2> neighboringGhostAttribs = { ghostAttribs[attribNames[0]], ghostAttribs[attribNames[1]] };
+			std::array<PrecomputeGhostAttribs, 2> neighboringGhostAttribs = { ghostAttribs.at(attribNames[0]), ghostAttribs.at(attribNames[1]) };
 			const std::array<bool, 2> neighborValidities = { isGhostValid(scene, object, neighboringGhostAttribs[0]), isGhostValid(scene, object, neighboringGhostAttribs[1]) };
 
 			// Compute the pupil rectangle enclosing the two neighboring ghost attribs
@@ -2487,8 +3166,7 @@ namespace TiledLensFlare
 			result.m_avgIntensity *= result.m_intensityScale;
 
 			// Compute the dynamic ray grid size
-			if (object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_rayCountMethod == RenderGhostsParameters::DynamicSensorSizeBased)
-				result.m_rayGridSize = computeReducedRayGridSize(scene, object, result);
+			result.m_rayGridSize = computeRayGridSize(scene, object, result);
 
 			// Rotate the grids
 			switch (object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_raytraceMethod)
@@ -2577,8 +3255,7 @@ namespace TiledLensFlare
 
 			// Compute the ray grid size
 			result.m_rayGridSize = object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_rayCount;
-			if (object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_rayCountMethod == RenderGhostsParameters::DynamicSensorSizeBased)
-				result.m_rayGridSize = computeReducedRayGridSize(scene, object, result);
+			result.m_rayGridSize = computeRayGridSize(scene, object, result);
 
 			// Return the result
 			return result;
@@ -2856,6 +3533,86 @@ namespace TiledLensFlare
 		}
 	}
 
+	////////////////////////////////////////////////////////////////////////////////
+	namespace GhostPruning
+	{
+		////////////////////////////////////////////////////////////////////////////////
+		float getSurfaceReflectance(PhysicalCamera::PhysicalCameraAttributes const& camera, const int surfaceID, const float lambda)
+		{
+			auto const& lens = camera.m_lenses[surfaceID];
+			const float n0 = PhysicalCamera::cauchyDispersion(camera, glm::max(surfaceID - 1, 0), lambda);
+			const float n2 = PhysicalCamera::cauchyDispersion(camera, surfaceID, lambda);
+			return PhysicalCamera::fresnelWithAntiReflectionCoating(lambda, lens.m_coatingWavelength, 0.0f, n0, lens.m_coatingRefraction, n2);
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Predicted energy density of a ghost on the sensor for a head-on light source, 
+		// using the reflectances of its two surfaces and its paraxial pupil and sensor footprints
+		float estimateGhostEnergy(Scene::Scene& scene, Scene::Object* object, const size_t ghostID, const size_t channelID, const float lambda)
+		{
+			auto const& camera = object->component<TiledLensFlareComponent>().m_camera;
+			auto const& ghostIndices = object->component<TiledLensFlareComponent>().m_ghostIndices[ghostID];
+
+			// Paraxial bounds of the ghost
+			const PrecomputeGhostAttribs attribs = GhostAttribs::computeGhostAttribMatrixMethod(scene, object, ghostID, channelID, 0.0f);
+			if (attribs.m_avgIntensity <= 0.0f) return 0.0f;
+
+			// Energy entering the system is spread over the ghost's footprint on the sensor
+			const glm::vec2 pupilSize = glm::max(attribs.m_pupilMax - attribs.m_pupilMin, glm::vec2(0.0f));
+			const glm::vec2 sensorSize = glm::max(attribs.m_sensorMax - attribs.m_sensorMin, camera.m_filmSize * 0.01f);
+			const float reflectance = getSurfaceReflectance(camera, ghostIndices[0], lambda) * getSurfaceReflectance(camera, ghostIndices[1], lambda);
+
+			return reflectance * (pupilSize.x * pupilSize.y) / (sensorSize.x * sensorSize.y);
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		void pruneGhosts(Scene::Scene& scene, Scene::Object* object)
+		{
+			PrecomputeGhostsParameters const& precomputeParams = object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters;
+			auto const& camera = object->component<TiledLensFlareComponent>().m_camera;
+			auto& ghostIndices = object->component<TiledLensFlareComponent>().m_ghostIndices;
+			auto& transferMatrices = object->component<TiledLensFlareComponent>().m_transferMatrices;
+			const size_t numGhosts = ghostIndices.size();
+			if (numGhosts == 0) return;
+
+			// Estimate the energy of each ghost at the middle of the spectrum
+			const size_t numChannels = transferMatrices[0].size();
+			const size_t channelID = numChannels / 2;
+			const float lambda = camera.m_wavelengths[numChannels][channelID];
+			std::vector<float> energies(numGhosts);
+			Threading::threadedExecuteIndices(Threading::numThreads(),
+				[&](Threading::ThreadedExecuteEnvironment const& environment, const size_t ghostID)
+				{
+					energies[ghostID] = estimateGhostEnergy(scene, object, ghostID, channelID, lambda);
+				},
+				numGhosts);
+
+			// Rank the ghosts by their energy
+			std::vector<size_t> ranking(numGhosts);
+			std::iota(ranking.begin(), ranking.end(), 0);
+			std::stable_sort(ranking.begin(), ranking.end(), [&](const size_t a, const size_t b) { return energies[a] > energies[b]; });
+
+			// Keep the ghosts above the threshold, within the budget
+			const float minEnergy = energies[ranking[0]] * precomputeParams.m_pruneThreshold;
+			const size_t budget = precomputeParams.m_ghostBudget > 0 ? size_t(precomputeParams.m_ghostBudget) : numGhosts;
+			std::vector<bool> keep(numGhosts, false);
+			for (size_t rank = 0; rank < numGhosts && rank < budget && energies[ranking[rank]] > 0.0f && energies[ranking[rank]] >= minEnergy; ++rank)
+				keep[ranking[rank]] = true;
+
+			// Compact the ghost list, preserving the original ordering
+			size_t numKept = 0;
+			for (size_t ghostID = 0; ghostID < numGhosts; ++ghostID)
+			{
+				if (!keep[ghostID]) continue;
+				ghostIndices[numKept] = std::move(ghostIndices[ghostID]);
+				transferMatrices[numKept] = std::move(transferMatrices[ghostID]);
+				++numKept;
+			}
+			ghostIndices.resize(numKept);
+			transferMatrices.resize(numKept);
+		}
+	}
+
 	////////////////////////////////////////////////////////////////////////////////
 	#define STATIC_STRING_ARRAY(NAME, ...) \
 		static const std::string _##NAME##[] = { __VA_ARGS__ }; \
@@ -2871,7 +3628,8 @@ namespace TiledLensFlare
 			"pupil_pos_polar_normalized_x",
 			"pupil_pos_polar_normalized_inverted_x",
 			"angle_deg",
-			"lambda_nm"
+			"lambda_nm",
+			"zoom_pos"
 		);
 
 		////////////////////////////////////////////////////////////////////////////////
@@ -2888,6 +3646,27 @@ namespace TiledLensFlare
 		static const size_t NUM_POLYNOMIAL_INPUT_VARIABLES = ARRAYSIZE(_polynomialInputVariables);
 		static const size_t NUM_POLYNOMIAL_OUTPUT_VARIABLES = ARRAYSIZE(_polynomialOutputVariables);
 
+		////////////////////////////////////////////////////////////////////////////////
+		static const size_t ZOOM_INPUT_VARIABLE_ID = std::distance(s_polynomialInputVariables.begin(),
+			std::find(s_polynomialInputVariables.begin(), s_polynomialInputVariables.end(), "zoom_pos"));
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Whether the input variable is allowed to appear in the fitted polynomials
+		bool isInputVariableEnabled(PolynomialFitParameters const& fitParameters, const size_t variableID)
+		{
+			return variableID != ZOOM_INPUT_VARIABLE_ID || fitParameters.m_ghostGeometryParameters.m_fitZoomRange;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		template<size_t N>
+		bool usesDisabledInputVariables(PolynomialFitParameters const& fitParameters, MonomialN<N> const& monomial)
+		{
+			for (size_t variableID = 0; variableID < N; ++variableID)
+				if (monomial.m_degrees[variableID] != 0 && !isInputVariableEnabled(fitParameters, variableID))
+					return true;
+			return false;
+		}
+
 		///////////////////////////////////////////////////////////////////////////////
 		#ifdef AUTODIFF_FORWARD
 		using AutodiffVar = autodiff::real;
@@ -2905,7 +3684,7 @@ namespace TiledLensFlare
 		// - #1: angle
 		// - #2: rotation
 		// - #3: wavelength
-		using PrecomputedGhostGeometry = boost::multi_array<GhostGeometry::GhostGeometry, 3>;
+		using PrecomputedGhostGeometry = boost::multi_array<GhostGeometry::CompactGhostGeometry, 3>;
 
 		////////////////////////////////////////////////////////////////////////////////
 		template<size_t N>
@@ -3141,8 +3920,8 @@ namespace TiledLensFlare
 				GhostGeometry::GeometryEntry const& entry)
 			{
 				return 
-					(fitParams.m_ghostGeometryParameters.m_smoothenData || entry.m_validityFlags.m_isTractable) &&
-					(!fitParams.m_ghostGeometryParameters.m_ghostClipping.m_clipSensor || entry.m_validityFlags.m_isOnSensor);
+					(fitParams.m_ghostGeometryParameters.m_smoothenData || entry.m_validityFlags.isTractable()) &&
+					(!fitParams.m_ghostGeometryParameters.m_ghostClipping.m_clipSensor || entry.m_validityFlags.isOnSensor());
 			}
 
 			////////////////////////////////////////////////////////////////////////////////
@@ -3594,11 +4373,11 @@ namespace TiledLensFlare
 					// Fill in the per-ray validity attributes of the ghost geometry
 					for (size_t i = 0; i < geometry.size(); ++i)
 					{
-						geometry[i].m_validityFlags.m_isTractable = GhostGeometry::Filtering::isEntryTractable(geometry, i);
-						geometry[i].m_validityFlags.m_isValid = GhostGeometry::Filtering::isEntryValid(geometry, i, clipParameters);
-						geometry[i].m_validityFlags.m_isInternal = GhostGeometry::Filtering::isEntryInternal(geometry, i, clipParameters);
-						geometry[i].m_validityFlags.m_isBoundary = GhostGeometry::Filtering::isEntryBoundary(geometry, i, clipParameters);
-						geometry[i].m_validityFlags.m_isOnSensor = GhostGeometry::Filtering::isEntryOnSensor(geometry, i, clipParameters);
+						geometry[i].m_validityFlags.set(GhostGeometry::ValidityFlags::Tractable, GhostGeometry::Filtering::isEntryTractable(geometry, i));
+						geometry[i].m_validityFlags.set(GhostGeometry::ValidityFlags::Valid, GhostGeometry::Filtering::isEntryValid(geometry, i, clipParameters));
+						geometry[i].m_validityFlags.set(GhostGeometry::ValidityFlags::Internal, GhostGeometry::Filtering::isEntryInternal(geometry, i, clipParameters));
+						geometry[i].m_validityFlags.set(GhostGeometry::ValidityFlags::Boundary, GhostGeometry::Filtering::isEntryBoundary(geometry, i, clipParameters));
+						geometry[i].m_validityFlags.set(GhostGeometry::ValidityFlags::OnSensor, GhostGeometry::Filtering::isEntryOnSensor(geometry, i, clipParameters));
 					}
 				}
 
@@ -3607,7 +4386,7 @@ namespace TiledLensFlare
 					PolynomialFitParameters const& fitParams, GhostGeometry::Filtering::ClipParameters clipParameters,
 					GhostGeometry::GeometryEntry const& entry)
 				{
-					return (fitParams.m_ghostGeometryParameters.m_smoothenData || entry.m_validityFlags.m_isTractable);
+					return (fitParams.m_ghostGeometryParameters.m_smoothenData || entry.m_validityFlags.isTractable());
 					//return entry.m_isOnSensor || entry.m_isInternal;
 					//return (entry.m_isValid || entry.m_isInternal);
 				}
@@ -3751,9 +4530,9 @@ namespace TiledLensFlare
 
 						//entryInvalid.m_isTractable = entryValid.m_isTractable;
 						//entryInvalid.m_isValid = entryValid.m_isValid;
-						entryInvalid.m_validityFlags.m_isOnSensor = entryValid.m_validityFlags.m_isOnSensor;
-						entryInvalid.m_validityFlags.m_isInternal = entryValid.m_validityFlags.m_isInternal;
-						entryInvalid.m_validityFlags.m_isBoundary = entryValid.m_validityFlags.m_isBoundary;
+						entryInvalid.m_validityFlags.set(GhostGeometry::ValidityFlags::OnSensor, entryValid.m_validityFlags.isOnSensor());
+						entryInvalid.m_validityFlags.set(GhostGeometry::ValidityFlags::Internal, entryValid.m_validityFlags.isInternal());
+						entryInvalid.m_validityFlags.set(GhostGeometry::ValidityFlags::Boundary, entryValid.m_validityFlags.isBoundary());
 					}
 					ghostGeometryInvalid = postProcessGeometry(scene, object, fitParams, renderGhostAttribs, ghostGeometryInvalid, false, true, true);
 
@@ -3797,16 +4576,18 @@ namespace TiledLensFlare
 						Debug::log_debug() << "Ghost" << index.to_string(fitParams) << ": " << isEntryValid << ", " << to_string(renderGhostAttribs) << Debug::end;
 				}
 
-				// Compute the geometries
+				// Compute the geometries, and store them in the compact layout
+				const bool halfPrecision = fitParams.m_ghostGeometryParameters.m_halfPrecisionStorage;
 				PrecomputedGhostGeometry ghostGeometries(boost::extents[numAngles][numRotations][numChannels]);
 				for (size_t angleID = 0; angleID < numAngles; ++angleID)
 				for (size_t rotationID = 0; rotationID < numRotations; ++rotationID)
 				for (size_t channelID = 0; channelID < numChannels; ++channelID)
 				{
 					GhostGeometryIndex index{ int(ghostID), int(channelID), int(angleID), int(rotationID) };
-					index.accessArray(ghostGeometries) = index.accessArray(validFlags) ?
+					index.accessArray(ghostGeometries) = GhostGeometry::CompactGhostGeometry(index.accessArray(validFlags) ?
 						computeGhostGeometryForValidEntry(scene, object, index, ghostGeometries, validFlags, fitParams) :
-						computeGhostGeometryForInvalidEntry(scene, object, index, ghostGeometries, validFlags, fitParams);
+						computeGhostGeometryForInvalidEntry(scene, object, index, ghostGeometries, validFlags, fitParams),
+						halfPrecision);
 				}
 
 				// Copy over neighboring elements (angle)
@@ -3823,7 +4604,7 @@ namespace TiledLensFlare
 						auto const& geometry = index.accessArray(ghostGeometries);
 						auto& targetGeometry = targetIndex.accessArray(ghostGeometries);
 						if (index.accessArray(validFlags))
-							targetGeometry.insert(targetGeometry.end(), geometry.begin(), geometry.end());
+							targetGeometry.append(geometry);
 					}
 				}
 
@@ -3841,7 +4622,7 @@ namespace TiledLensFlare
 						auto const& geometry = index.accessArray(ghostGeometries);
 						auto& targetGeometry = targetIndex.accessArray(ghostGeometries);
 						if (index.accessArray(validFlags))
-							targetGeometry.insert(targetGeometry.end(), geometry.begin(), geometry.end());
+							targetGeometry.append(geometry);
 					}
 				}
 
@@ -3853,13 +4634,200 @@ namespace TiledLensFlare
 					for (size_t channelID = 0; channelID < numChannels; ++channelID)
 					{
 						GhostGeometryIndex index{ int(ghostID), int(channelID), int(angleID), int(rotationID) };
-						Debug::log_debug() << "Ghost" << index.to_string(fitParams) << ": " << index.accessArray(ghostGeometries).size() << Debug::end;
+						Debug::log_debug() << "Ghost" << index.to_string(fitParams) << ": " << index.accessArray(ghostGeometries).size() 
+							<< " (" << index.accessArray(ghostGeometries).sizeInBytes() << " bytes)" << Debug::end;
 					}
 				}
 
 				// Return the result
 				return ghostGeometries;
 			}
+
+			////////////////////////////////////////////////////////////////////////////////
+			void setZoomPosition(PrecomputedGhostGeometry& ghostGeometries, const float zoomPosition)
+			{
+				for (size_t elementID = 0; elementID < ghostGeometries.num_elements(); ++elementID)
+					ghostGeometries.data()[elementID].setZoomPosition(zoomPosition);
+			}
+
+			////////////////////////////////////////////////////////////////////////////////
+			PrecomputedGhostGeometry computeZoomGhostGeometries(Scene::Scene& scene, Scene::Object* object, const size_t ghostID)
+			{
+				// Precompute parameters
+				PolynomialFitParameters const& fitParams = object->component<TiledLensFlareComponent>().m_polynomialFitParameters;
+				PhysicalCamera::PhysicalCameraAttributes& camera = object->component<TiledLensFlareComponent>().m_camera;
+
+				// Only use the current camera if the zoom range is not needed
+				if (!fitParams.m_ghostGeometryParameters.m_fitZoomRange || camera.m_zoomGroup.empty())
+				{
+					PrecomputedGhostGeometry ghostGeometries = computeGhostGeometries(scene, object, ghostID);
+					setZoomPosition(ghostGeometries, camera.m_zoomPosition);
+					return ghostGeometries;
+				}
+
+				// Compute the geometries for every preset of the zoom group, and merge them into a single dataset
+				const PhysicalCamera::PhysicalCameraAttributes originalCamera = camera;
+				PhysicalCamera::GhostIndices const& ghost = object->component<TiledLensFlareComponent>().m_ghostIndices[ghostID];
+				PrecomputedGhostGeometry result;
+				for (auto preset: PhysicalCamera::getZoomGroupPresets(object->component<TiledLensFlareComponent>().m_cameraPresets, originalCamera.m_zoomGroup))
+				{
+					// The ghost list of the preset can differ from the active camera's; skip presets that don't produce the same ghost
+					if (!PhysicalCamera::hasMatchingGhost(*preset, originalCamera, ghost))
+					{
+						Debug::log_warning() << "Skipping zoom preset " << preset->m_name << " for ghost #" << ghostID << ": the preset does not produce the same ghost" << Debug::end;
+						continue;
+					}
+
+					Debug::log_debug() << "Computing ghost geometries for zoom preset " << preset->m_name << " (zoom position: " << preset->m_zoomPosition << ")" << Debug::end;
+
+					camera = *preset;
+					PhysicalCamera::propagateCoatingInformation(camera);
+
+					PrecomputedGhostGeometry ghostGeometries = computeGhostGeometries(scene, object, ghostID);
+					setZoomPosition(ghostGeometries, preset->m_zoomPosition);
+
+					if (result.num_elements() == 0)
+					{
+						result.resize(boost::extents[ghostGeometries.shape()[0]][ghostGeometries.shape()[1]][ghostGeometries.shape()[2]]);
+						result = ghostGeometries;
+						continue;
+					}
+
+					for (size_t elementID = 0; elementID < result.num_elements(); ++elementID)
+					{
+						result.data()[elementID].append(ghostGeometries.data()[elementID]);
+					}
+				}
+				camera = originalCamera;
+
+				// Fall back to the current camera if none of the presets matched
+				if (result.num_elements() == 0)
+				{
+					PrecomputedGhostGeometry ghostGeometries = computeGhostGeometries(scene, object, ghostID);
+					setZoomPosition(ghostGeometries, camera.m_zoomPosition);
+					return ghostGeometries;
+				}
+
+				// Return the result
+				return result;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		/** Header written in front of every polynomial weight file.
+			The monomials are stored as raw memory, so files written with a different input variable count cannot be read back. */
+		namespace WeightFileHeader
+		{
+			////////////////////////////////////////////////////////////////////////////////
+			static const uint32_t MAGIC = 0x57504C46; // "FLPW"
+			static const uint32_t VERSION = 1;
+
+			////////////////////////////////////////////////////////////////////////////////
+			void write(std::ostream& stream)
+			{
+				const uint32_t header[] = { MAGIC, VERSION, uint32_t(NUM_POLYNOMIAL_INPUT_VARIABLES) };
+				stream.write((const char*)header, sizeof(header));
+			}
+
+			////////////////////////////////////////////////////////////////////////////////
+			bool read(std::istream& stream, std::string const& filePath)
+			{
+				uint32_t header[3] = { 0, 0, 0 };
+				stream.read((char*)header, sizeof(header));
+				if (!stream || header[0] != MAGIC || header[1] != VERSION || header[2] != NUM_POLYNOMIAL_INPUT_VARIABLES)
+				{
+					Debug::log_warning() << "Incompatible polynomial weights file, ignoring it: " << filePath << Debug::end;
+					return false;
+				}
+				return true;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Number of bytes left to read in the stream
+		size_t getRemainingBytes(std::istream& stream)
+		{
+			const std::streampos position = stream.tellg();
+			stream.seekg(0, std::ios::end);
+			const std::streampos end = stream.tellg();
+			stream.seekg(position);
+			return (position < 0 || end < position) ? 0 : size_t(end - position);
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Reads an element count from a weight file, rejecting counts that cannot be valid (e.g. for truncated or corrupt files)
+		bool readWeightFileCount(std::istream& stream, size_t& count, const size_t maxCount)
+		{
+			count = 0;
+			stream.read((char*)&count, sizeof(count));
+			return stream && count <= maxCount;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		/** Per-ghost polynomial files, keyed by the content hash of the ghost, for incremental refitting. */
+		namespace GhostFitCache
+		{
+			////////////////////////////////////////////////////////////////////////////////
+			template<typename P>
+			size_t getNumPolynomialsPerGhost(P const& polynomials)
+			{
+				return polynomials.num_elements() / polynomials.shape()[0];
+			}
+
+			////////////////////////////////////////////////////////////////////////////////
+			template<typename P>
+			bool loadGhostPolynomials(Scene::Scene& scene, Scene::Object* object, std::string const& filePath, P& polynomials, const size_t ghostID)
+			{
+				using Polynomial = typename P::element;
+				using Monomial = typename Polynomial::value_type;
+
+				std::ifstream file(filePath, std::ios::binary);
+				if (!file || !WeightFileHeader::read(file, filePath)) return false;
+
+				// Make sure the stored layout matches the current fit
+				const size_t numPolynomials = getNumPolynomialsPerGhost(polynomials);
+				size_t numStoredPolynomials = 0;
+				file.read((char*)&numStoredPolynomials, sizeof(numStoredPolynomials));
+				if (!file || numStoredPolynomials != numPolynomials) return false;
+
+				std::vector<Polynomial> ghostPolynomials(numPolynomials);
+				for (auto& polynomial : ghostPolynomials)
+				{
+					size_t numWeights = 0;
+					if (!readWeightFileCount(file, numWeights, getRemainingBytes(file) / sizeof(Monomial))) return false;
+					polynomial.resize(numWeights);
+					file.read((char*)polynomial.data(), numWeights * sizeof(Monomial));
+				}
+				if (!file) return false;
+
+				std::move(ghostPolynomials.begin(), ghostPolynomials.end(), polynomials.data() + ghostID * numPolynomials);
+
+				Debug::log_debug() << "Loaded cached polynomials for ghost #" << ghostID << " from file: " << filePath << Debug::end;
+
+				return true;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////
+			template<typename P>
+			void saveGhostPolynomials(Scene::Scene& scene, Scene::Object* object, std::string const& filePath, P const& polynomials, const size_t ghostID)
+			{
+				using Polynomial = typename P::element;
+				using Monomial = typename Polynomial::value_type;
+
+				EnginePaths::makeDirectoryStructure(filePath, true);
+				std::ofstream outFile(filePath, std::ofstream::binary);
+				WeightFileHeader::write(outFile);
+
+				const size_t numPolynomials = getNumPolynomialsPerGhost(polynomials);
+				outFile.write((char*)&numPolynomials, sizeof(numPolynomials));
+				for (size_t polynomialID = 0; polynomialID < numPolynomials; ++polynomialID)
+				{
+					Polynomial const& polynomial = polynomials.data()[ghostID * numPolynomials + polynomialID];
+					const size_t numWeights = polynomial.size();
+					outFile.write((char*)&numWeights, sizeof(numWeights));
+					outFile.write((char*)polynomial.data(), numWeights * sizeof(Monomial));
+				}
+			}
 		}
 
 		////////////////////////////////////////////////////////////////////////////////
@@ -4011,6 +4979,7 @@ namespace TiledLensFlare
 				float getSampleRotationDeg(GhostGeometry::GeometryEntry const& sample) { return glm::degrees(sample.m_rotation); }
 				float getSampleLambdaMuM(GhostGeometry::GeometryEntry const& sample) { return sample.m_wavelength; }
 				float getSampleLambdaNM(GhostGeometry::GeometryEntry const& sample) { return sample.m_wavelength * 1e-3f; }
+				float getSampleZoomPos(GhostGeometry::GeometryEntry const& sample) { return sample.m_zoomPosition; }
 				// - pupil pos
 				float getSamplePupilPosCartesianX(GhostGeometry::GeometryEntry const& sample) { return sample.m_pupilPosCartesian.x; }
 				float getSamplePupilPosCartesianY(GhostGeometry::GeometryEntry const& sample) { return sample.m_pupilPosCartesian.y; }
@@ -4253,6 +5222,7 @@ namespace TiledLensFlare
 				{ "rotation_deg",                                     AttribData{ &ValueExtractors::getSampleRotationDeg } },
 				{ "lambda_mum",                                       AttribData{ &ValueExtractors::getSampleLambdaMuM } },
 				{ "lambda_nm",                                        AttribData{ &ValueExtractors::getSampleLambdaNM } },
+				{ "zoom_pos",                                         AttribData{ &ValueExtractors::getSampleZoomPos } },
 				{ "aperture_dist_absolute",                           AttribData{ &ValueExtractors::getSamplePupilApertureDistAbsolute } },
 				{ "aperture_dist_bounded",                            AttribData{ &ValueExtractors::getSamplePupilApertureDistBounded } },
 
@@ -4350,6 +5320,16 @@ namespace TiledLensFlare
 			}
 		}
 
+		////////////////////////////////////////////////////////////////////////////////
+		/** Random stream of a single work item, seeded only by the work item's identity so the results don't depend on thread scheduling. */
+		std::mt19937 makeRandomStream(PolynomialFitParameters const& fitParameters, std::string const& variableName, const size_t workItemID)
+		{
+			std::vector<uint32_t> seeds = { uint32_t(fitParameters.m_randomSeed), uint32_t(workItemID) };
+			seeds.insert(seeds.end(), variableName.begin(), variableName.end());
+			std::seed_seq seedSequence(seeds.begin(), seeds.end());
+			return std::mt19937(seedSequence);
+		}
+
 		////////////////////////////////////////////////////////////////////////////////
 		namespace DensePolynomial
 		{
@@ -4842,11 +5822,9 @@ namespace TiledLensFlare
 
 			////////////////////////////////////////////////////////////////////////////////
 			template<size_t N>
-			PolynomialN<N> makeSparsePolynomial(PolynomialN<N> const& densePolynomial, std::vector<size_t>& ids, int numTerms)
+			PolynomialN<N> makeSparsePolynomial(PolynomialN<N> const& densePolynomial, std::vector<size_t>& ids, int numTerms, std::mt19937& gen)
 			{
 				// Make a random set of indices
-				std::random_device rd;
-				std::mt19937 gen(rd());
 				std::shuffle(ids.begin(), ids.end(), gen);
 
 				// Copy over the new terms
@@ -4860,10 +5838,8 @@ namespace TiledLensFlare
 
 			////////////////////////////////////////////////////////////////////////////////
 			template<size_t N>
-			PolynomialN<N> swapSparseTerms(PolynomialN<N> sparsePolynomial, PolynomialN<N> const& densePolynomial, std::vector<size_t>& ids, int numTerms)
+			PolynomialN<N> swapSparseTerms(PolynomialN<N> sparsePolynomial, PolynomialN<N> const& densePolynomial, std::vector<size_t>& ids, int numTerms, std::mt19937& gen)
 			{
-				std::random_device rd;
-				std::mt19937 gen(rd());
 				std::uniform_int_distribution<int> rng(sparsePolynomial.size(), densePolynomial.size() - 1);
 
 				// Make a random set of swap ids
@@ -5016,12 +5992,12 @@ namespace TiledLensFlare
 				FitDataSamplePointN<N> result;
 				for (size_t variableID = 0; variableID < inputVariables.size(); ++variableID)
 					result.m_input[variableID] = Attribs::getVariableData(inputVariables[variableID]).m_valueExtractor(sample);
-				if      (!sample.m_validityFlags.m_isTractable)  result.m_weight = 0.0f;
-				else if (sample.m_validityFlags.m_isBoundary)    result.m_weight = fitParameters.m_outputVariableParams.find(variableName)->second.m_boundaryWeight;
-				else if (sample.m_validityFlags.m_isInternal)    result.m_weight = fitParameters.m_outputVariableParams.find(variableName)->second.m_interiorWeight;
+				if      (!sample.m_validityFlags.isTractable())  result.m_weight = 0.0f;
+				else if (sample.m_validityFlags.isBoundary())    result.m_weight = fitParameters.m_outputVariableParams.find(variableName)->second.m_boundaryWeight;
+				else if (sample.m_validityFlags.isInternal())    result.m_weight = fitParameters.m_outputVariableParams.find(variableName)->second.m_interiorWeight;
 				else                                             result.m_weight = fitParameters.m_outputVariableParams.find(variableName)->second.m_exteriorWeight;
 				result.m_value = 
-					sample.m_validityFlags.m_isTractable ? 
+					sample.m_validityFlags.isTractable() ? 
 					(*attribData.m_valueExtractor)(sample) : 
 					(*attribData.m_defaultValueExtractor)(scene, object, fitParameters, variableName);
 				result.m_validityFlags = sample.m_validityFlags;
@@ -5144,19 +6120,19 @@ namespace TiledLensFlare
 						validEntries.end());
 
 					// Process the valid entries
-					std::mutex updateMutex;
+					std::vector<float> errors(validEntries.size());
 					Threading::threadedExecuteIndices(Threading::numThreads(),
 						[&](Threading::ThreadedExecuteEnvironment const& environment, size_t i)
 						{
 							const size_t entryId = validEntries[i];
 							const PolynomialN<N> fitPolynomial = DensePolynomial::fitDenseCoefficients(fitParameters, polynomial, datasetFitPtr[entryId]);
-							const float error = getApproximationError(scene, object, fitParameters, fitPolynomial, datasetPtr[entryId], variableName, false);
-							{
-								std::lock_guard<std::mutex>	lock(updateMutex);
-								collapseFn.addError(error);
-							}
+							errors[i] = getApproximationError(scene, object, fitParameters, fitPolynomial, datasetPtr[entryId], variableName, false);
 						},
 						validEntries.size());
+
+					// Collapse the errors in entry order, so the result doesn't depend on the thread scheduling
+					for (const float error : errors)
+						collapseFn.addError(error);
 					return collapseFn.getResult(dataset.num_elements());
 				}
 
@@ -5197,7 +6173,7 @@ namespace TiledLensFlare
 
 			////////////////////////////////////////////////////////////////////////////////
 			template<size_t N>
-			FitDataPointsN<N> subsampleDatapoints(PolynomialFitParameters const& fitParameters, FitDataPointsN<N> dataPoints, const size_t numSamples)
+			FitDataPointsN<N> subsampleDatapoints(PolynomialFitParameters const& fitParameters, FitDataPointsN<N> dataPoints, const size_t numSamples, std::mt19937& gen)
 			{
 				// Early out for empty datasets
 				if (dataPoints.empty()) return dataPoints;
@@ -5208,7 +6184,7 @@ namespace TiledLensFlare
 
 				// Fall back to simpler implementation if all samples are valid/invalid
 				if (relevantSamples == 0 || relevantSamples == dataPoints.size())
-					return std::random_samples(dataPoints, numSamples);
+					return std::random_samples(dataPoints, numSamples, gen);
 
 				// Separate the valid and invalid samples
 				auto validSamplesEnd = std::partition(dataPoints.begin(), dataPoints.end(), 
@@ -5216,7 +6192,7 @@ namespace TiledLensFlare
 
 				// Fall back to simpler implementation if all samples are valid/invalid
 				if (validSamplesEnd == dataPoints.begin() || validSamplesEnd == dataPoints.end())
-					return std::random_samples(dataPoints, numSamples);
+					return std::random_samples(dataPoints, numSamples, gen);
 
 				// Calculate the valid and invalid samples
 				const int numValidPoints = std::distance(dataPoints.begin(), validSamplesEnd);
@@ -5231,8 +6207,6 @@ namespace TiledLensFlare
 				const int numResultInvalidPoints = std::min(numInvalidPoints, numTargetInvalidPoints);
 
 				// Make a random set of indices
-				std::random_device rd;
-				std::mt19937 gen(rd());
 				std::vector<size_t> validIds = std::iota<size_t>(numValidPoints, 0);
 				std::vector<size_t> invalidIds = std::iota<size_t>(numInvalidPoints, numValidPoints);
 				shuffle(validIds.begin(), validIds.end(), gen);
@@ -5249,14 +6223,38 @@ namespace TiledLensFlare
 
 			////////////////////////////////////////////////////////////////////////////////
 			template<size_t N>
-			FitDataSetN<N> subsampleDataset(PolynomialFitParameters const& fitParameters, FitDataSetN<N> const& dataset, const size_t numSamples)
+			FitDataSetN<N> subsampleDataset(PolynomialFitParameters const& fitParameters, FitDataSetN<N> const& dataset, 
+				std::string const& variableName, const size_t numSamples)
 			{
 				FitDataSetN<N> result(boost::extents[dataset.shape()[0]][dataset.shape()[1]][dataset.shape()[2]]);
-				std::transform(dataset.data(), dataset.data() + dataset.num_elements(), result.data(), 
-					[&](FitDataPointsN<N> const& dataPoints){ return subsampleDatapoints(fitParameters, dataPoints, numSamples); });
+				for (size_t entryId = 0; entryId < dataset.num_elements(); ++entryId)
+				{
+					std::mt19937 gen = makeRandomStream(fitParameters, variableName, entryId);
+					result.data()[entryId] = subsampleDatapoints(fitParameters, dataset.data()[entryId], numSamples, gen);
+				}
 				return result;
 			}
 
+			////////////////////////////////////////////////////////////////////////////////
+			/** Moves a random validationRatio fraction of each entry's samples to the validation set, and the rest to the training set. */
+			template<size_t N>
+			void splitValidationDataset(PolynomialFitParameters const& fitParameters, FitDataSetN<N> const& dataset, std::string const& variableName, 
+				const float validationRatio, FitDataSetN<N>& training, FitDataSetN<N>& validation)
+			{
+				for (size_t entryId = 0; entryId < dataset.num_elements(); ++entryId)
+				{
+					// Shuffle the samples, using streams separate from the subsampling and annealing ones
+					FitDataPointsN<N> dataPoints = dataset.data()[entryId];
+					std::mt19937 gen = makeRandomStream(fitParameters, variableName, dataset.num_elements() + 1 + entryId);
+					std::shuffle(dataPoints.begin(), dataPoints.end(), gen);
+
+					// Split them
+					const size_t numValidation = size_t(float(dataPoints.size()) * validationRatio);
+					validation.data()[entryId].assign(dataPoints.begin(), dataPoints.begin() + numValidation);
+					training.data()[entryId].assign(dataPoints.begin() + numValidation, dataPoints.end());
+				}
+			}
+
 			////////////////////////////////////////////////////////////////////////////////
 			template<size_t N>
 			FitDataPointsN<N> constructFitDatapoints(PolynomialFitParameters const& fitParameters, FitDataPointsN<N> dataPoints)
@@ -5314,11 +6312,9 @@ namespace TiledLensFlare
 				}
 
 				////////////////////////////////////////////////////////////////////////////////
-				float getAcceptance()
+				float getAcceptance(std::mt19937& gen)
 				{
 					// Random number generator for the acceptance evaluation
-					std::random_device rd;
-					std::mt19937 gen(rd());
 					std::uniform_real_distribution<float> rng(0.0f, 1.0f);
 					return rng(gen);
 				}
@@ -5340,11 +6336,16 @@ namespace TiledLensFlare
 
 					// Dense polynomial to sparsify
 					PolynomialN<N> densePolynomial = DensePolynomial::makeDensePolynomial<N>(fitParameters.m_maxTermDegree, true);
+					densePolynomial.erase(std::remove_if(densePolynomial.begin(), densePolynomial.end(), [&](MonomialN<N> const& monomial)
+						{ return usesDisabledInputVariables(fitParameters, monomial); }), densePolynomial.end());
 					std::vector<size_t> coefficientIds = std::iota<size_t>(densePolynomial.size(), 0);
 
+					// Random stream driving the annealing; kept separate from the subsampling streams
+					std::mt19937 gen = makeRandomStream(fitParameters, variableName, datasets.num_elements());
+
 					// Results of the fitting
 					FitResultN<N> result(boost::extents[numAngles][numRotations][numWavelengths]);
-					PolynomialN<N> resultPolynomial = DensePolynomial::makeSparsePolynomial(densePolynomial, coefficientIds, fitParameters.m_numSparseTerms);
+					PolynomialN<N> resultPolynomial = DensePolynomial::makeSparsePolynomial(densePolynomial, coefficientIds, fitParameters.m_numSparseTerms, gen);
 					FitStatsData resultStats;
 					resultStats.m_computationTimer.start();
 
@@ -5369,14 +6370,14 @@ namespace TiledLensFlare
 						const int numTermsSwap = getNumSwap(fitParameters, annealingParameters, temperature);
 
 						// Construct the new polynomial
-						const PolynomialN<N> newPolynomial = DensePolynomial::swapSparseTerms(resultPolynomial, densePolynomial, coefficientIds, numTermsSwap);
+						const PolynomialN<N> newPolynomial = DensePolynomial::swapSparseTerms(resultPolynomial, densePolynomial, coefficientIds, numTermsSwap, gen);
 						
 						// Evaluate the new error
 						const float newError = getApproximationError(scene, object, fitParameters, newPolynomial, datasetsSubsampledFit, datasetsSubsampled, variableName);
 
 						// Evaluate the acceptance probablity
 						const float acceptanceProbability = getAcceptanceProbability(fitParameters, annealingParameters, temperature, prevError, newError);
-						const float acceptance = getAcceptance();
+						const float acceptance = getAcceptance(gen);
 
 						Debug::log_output(outputLevel) << " - Iteration #" << iterationID << ", "
 							<< "error: " << newError << " (" << prevError << ")" ", "
@@ -5436,8 +6437,8 @@ namespace TiledLensFlare
 					PolynomialFitParameters const& fitParameters,
 					PolynomialFitParameters::PolynomialRegressionParams const& regressionParams,
 					FitDataSetN<N> const& datasetFit, FitDataSetN<N> const& dataset, std::string const& variableName,
-					PolynomialN<N>& result, float& resultError, FitStatsData& resultStats,
-					std::optional<PolynomialN<N>> const& testPolynomial)
+					PolynomialN<N>& result, float& resultError, size_t& resultCandidateID, FitStatsData& resultStats,
+					const size_t candidateID, std::optional<PolynomialN<N>> const& testPolynomial)
 				{
 					// Do nothing it the polynomial is not valid
 					if (!testPolynomial.has_value()) return;
@@ -5445,15 +6446,16 @@ namespace TiledLensFlare
 					// Calculate the fitting error of the polynomial
 					const float testError = getApproximationError(scene, object, fitParameters, testPolynomial.value(), datasetFit, dataset, variableName);
 
-					// Evaluate the fit
+					// Evaluate the fit; ties are broken by the candidate index, so the winner doesn't depend on the evaluation order
 					static std::mutex s_swapMutex;
 					{
 						std::lock_guard<std::mutex>	lock(s_swapMutex);
 
-						if (testError < resultError)
+						if (testError < resultError || (testError == resultError && candidateID < resultCandidateID))
 						{
 							result = testPolynomial.value();
 							resultError = testError;
+							resultCandidateID = candidateID;
 						}
 
 						++resultStats.m_numPermutationsTested;
@@ -5479,6 +6481,7 @@ namespace TiledLensFlare
 					// Return a null polynomial if the term has a negative degree
 					if (newTerm.isAnyDegreeNegative()) return std::nullopt;
 					if (newTerm.maxDegree() >= fitParameters.m_maxTermDegree) return std::nullopt;
+					if (usesDisabledInputVariables(fitParameters, newTerm)) return std::nullopt;
 
 					// Return a null polynomial if the term is already present
 					auto it = std::find_if(currentPolynomial.begin(), currentPolynomial.end(), [&](MonomialN<N> const& testTerm)
@@ -5518,6 +6521,10 @@ namespace TiledLensFlare
 				{
 					PolynomialN<N> result = currentPolynomial;
 					float resultError = FLT_MAX;
+					size_t resultCandidateID = SIZE_MAX;
+
+					// Candidate indices: F1 candidates first, followed by the F2 ones
+					const size_t f2CandidatesStart = currentPolynomial.size() * N;
 
 					if (useThreading(scene, object, fitParameters, regressionParams, datasetFit))
 					{
@@ -5526,8 +6533,8 @@ namespace TiledLensFlare
 							[&](Threading::ThreadedExecuteEnvironment const& environment, size_t i, size_t id)
 							{
 								evalPolynomial(scene, object, fitParameters, regressionParams,
-									datasetFit, datasets, variableName, result, resultError, resultStats,
-									expandF1(fitParameters, regressionParams, currentPolynomial, i, id, depth));
+									datasetFit, datasets, variableName, result, resultError, resultCandidateID, resultStats,
+									i * N + id, expandF1(fitParameters, regressionParams, currentPolynomial, i, id, depth));
 							},
 							currentPolynomial.size(),
 							N);
@@ -5537,8 +6544,8 @@ namespace TiledLensFlare
 							[&](Threading::ThreadedExecuteEnvironment const& environment, size_t id)
 							{
 								evalPolynomial(scene, object, fitParameters, regressionParams,
-									datasetFit, datasets, variableName, result, resultError, resultStats,
-									expandF2(fitParameters, regressionParams, currentPolynomial, id, depth));
+									datasetFit, datasets, variableName, result, resultError, resultCandidateID, resultStats,
+									f2CandidatesStart + id, expandF2(fitParameters, regressionParams, currentPolynomial, id, depth));
 							},
 							N);
 					}
@@ -5548,14 +6555,14 @@ namespace TiledLensFlare
 						for (size_t i = 0; i < currentPolynomial.size(); ++i)
 						for (size_t id = 0; id < N; ++id)
 							evalPolynomial(scene, object, fitParameters, regressionParams,
-								datasetFit, datasets, variableName, result, resultError, resultStats,
-								expandF1(fitParameters, regressionParams, currentPolynomial, i, id, depth));
+								datasetFit, datasets, variableName, result, resultError, resultCandidateID, resultStats,
+								i * N + id, expandF1(fitParameters, regressionParams, currentPolynomial, i, id, depth));
 
 						// F2 operator: add entries with only one term set to d
 						for (size_t id = 0; id < N; ++id)
 							evalPolynomial(scene, object, fitParameters, regressionParams,
-								datasetFit, datasets, variableName, result, resultError, resultStats,
-								expandF2(fitParameters, regressionParams, currentPolynomial, id, depth));
+								datasetFit, datasets, variableName, result, resultError, resultCandidateID, resultStats,
+								f2CandidatesStart + id, expandF2(fitParameters, regressionParams, currentPolynomial, id, depth));
 					}
 
 					return { result, resultError };
@@ -5583,6 +6590,7 @@ namespace TiledLensFlare
 					PolynomialN<N> result = currentPolynomial;
 					result.pop_back();
 					float resultError = FLT_MAX;
+					size_t resultCandidateID = SIZE_MAX;
 
 					if (useThreading(scene, object, fitParameters, regressionParams, datasetFit))
 					{
@@ -5591,8 +6599,8 @@ namespace TiledLensFlare
 							[&](Threading::ThreadedExecuteEnvironment const& environment, size_t i)
 							{
 								evalPolynomial(scene, object, fitParameters, regressionParams,
-									datasetFit, datasets, variableName, result, resultError, resultStats,
-									replaceTerm(fitParameters, regressionParams, currentPolynomial, i));
+									datasetFit, datasets, variableName, result, resultError, resultCandidateID, resultStats,
+									i, replaceTerm(fitParameters, regressionParams, currentPolynomial, i));
 							},
 							currentPolynomial.size() - 1);
 					}
@@ -5601,8 +6609,8 @@ namespace TiledLensFlare
 						// Try to replace each term with the new one
 						for (size_t i = 0; i < currentPolynomial.size() - 1; ++i)
 							evalPolynomial(scene, object, fitParameters, regressionParams,
-								datasetFit, datasets, variableName, result, resultError, resultStats,
-								replaceTerm(fitParameters, regressionParams, currentPolynomial, i));
+								datasetFit, datasets, variableName, result, resultError, resultCandidateID, resultStats,
+								i, replaceTerm(fitParameters, regressionParams, currentPolynomial, i));
 					}
 
 					return { result, resultError };
@@ -5642,6 +6650,10 @@ namespace TiledLensFlare
 				{
 					PolynomialN<N> result = currentPolynomial;
 					float resultError = FLT_MAX;
+					size_t resultCandidateID = SIZE_MAX;
+
+					// Candidate indices: B1 candidates first, followed by the B2 ones
+					const size_t b2CandidatesStart = currentPolynomial.size() * N;
 
 					if (useThreading(scene, object, fitParameters, regressionParams, datasetFit))
 					{
@@ -5650,8 +6662,8 @@ namespace TiledLensFlare
 							[&](Threading::ThreadedExecuteEnvironment const& environment, size_t i, size_t id)
 							{
 								evalPolynomial(scene, object, fitParameters, regressionParams,
-									datasetFit, datasets, variableName, result, resultError, resultStats,
-									simplifyB1(fitParameters, regressionParams, currentPolynomial, i, id, depth));
+									datasetFit, datasets, variableName, result, resultError, resultCandidateID, resultStats,
+									i * N + id, simplifyB1(fitParameters, regressionParams, currentPolynomial, i, id, depth));
 							},
 							currentPolynomial.size(),
 							N);
@@ -5662,8 +6674,8 @@ namespace TiledLensFlare
 								[&](Threading::ThreadedExecuteEnvironment const& environment, size_t i)
 								{
 									evalPolynomial(scene, object, fitParameters, regressionParams,
-										datasetFit, datasets, variableName, result, resultError, resultStats,
-										simplifyB2(fitParameters, regressionParams, currentPolynomial, i));
+										datasetFit, datasets, variableName, result, resultError, resultCandidateID, resultStats,
+										b2CandidatesStart + i, simplifyB2(fitParameters, regressionParams, currentPolynomial, i));
 								},
 								currentPolynomial.size());
 					}
@@ -5673,15 +6685,15 @@ namespace TiledLensFlare
 						for (size_t i = 0; i < currentPolynomial.size(); ++i)
 						for (size_t id = 0; id < N; ++id)
 							evalPolynomial(scene, object, fitParameters, regressionParams,
-								datasetFit, datasets, variableName, result, resultError, resultStats,
-								simplifyB1(fitParameters, regressionParams, currentPolynomial, i, id, depth));
+								datasetFit, datasets, variableName, result, resultError, resultCandidateID, resultStats,
+								i * N + id, simplifyB1(fitParameters, regressionParams, currentPolynomial, i, id, depth));
 
 						// B2 operator: remove one entry if there are more than 2 entries in the polynomial
 						if (currentPolynomial.size() > 2)
 							for (size_t i = 0; i < currentPolynomial.size(); ++i)
 								evalPolynomial(scene, object, fitParameters, regressionParams,
-									datasetFit, datasets, variableName, result, resultError, resultStats,
-									simplifyB2(fitParameters, regressionParams, currentPolynomial, i));
+									datasetFit, datasets, variableName, result, resultError, resultCandidateID, resultStats,
+									b2CandidatesStart + i, simplifyB2(fitParameters, regressionParams, currentPolynomial, i));
 					}
 
 					return { result, resultError };
@@ -5715,8 +6727,22 @@ namespace TiledLensFlare
 					FitDataSetN<N> const& datasetsSubsampledFit = constructFitDataset(fitParameters, datasetsSubsampled);
 					FitDataSetN<N> const& datasetsFit = constructFitDataset(fitParameters, datasets);
 
+					// Hold out the validation samples; the term search only sees the training ones
+					const bool useValidation = regressionParams.m_validationRatio > 0.0f;
+					FitDataSetN<N> datasetsTraining = datasetsSubsampled;
+					FitDataSetN<N> datasetsValidation(boost::extents[numAngles][numRotations][numWavelengths]);
+					if (useValidation)
+						splitValidationDataset(fitParameters, datasetsSubsampled, variableName, regressionParams.m_validationRatio, datasetsTraining, datasetsValidation);
+					FitDataSetN<N> const& datasetsTrainingFit = constructFitDataset(fitParameters, datasetsTraining);
+
+					// Error of a term structure on the validation samples, with coefficients fit to the training samples
+					auto getValidationError = [&](PolynomialN<N> const& polynomial)
+					{
+						return getApproximationError(scene, object, fitParameters, polynomial, datasetsTrainingFit, datasetsValidation, variableName);
+					};
+
 					// Get the initial fitting error
-					float prevError = getApproximationError(scene, object, fitParameters, resultPolynomial, datasetsSubsampledFit, datasetsSubsampled, variableName);
+					float prevError = getApproximationError(scene, object, fitParameters, resultPolynomial, datasetsTrainingFit, datasetsTraining, variableName);
 
 					Debug::log_output(outputLevel) << "Initial error: " << prevError << Debug::end;
 					if (fitParameters.m_debugComputation)
@@ -5724,6 +6750,11 @@ namespace TiledLensFlare
 						Debug::log_debug() << "Initial polynomial: " << resultPolynomial << Debug::end;
 					}
 
+					// Best polynomial on the validation set
+					PolynomialN<N> bestValidationPolynomial = resultPolynomial;
+					float bestValidationError = useValidation ? getValidationError(resultPolynomial) : FLT_MAX;
+					int numIterationsWithoutImprovement = 0;
+
 					// State variables
 					int depth = 1;
 					bool stuck = false;
@@ -5745,7 +6776,7 @@ namespace TiledLensFlare
 						// Expand the polynomial
 						expanded = false;
 						auto [expandedPolynomial, expandedError] = expandPolynomial(scene, object, fitParameters, regressionParams, resultStats,
-							resultPolynomial, datasetsSubsampledFit, datasetsSubsampled, variableName, depth);
+							resultPolynomial, datasetsTrainingFit, datasetsTraining, variableName, depth);
 						
 						if ((expandedPolynomial.size() > resultPolynomial.size()) && (regressionParams.m_fixedTermNumber || expandedError <= (prevError - stopErrorDecrease)))
 						{
@@ -5769,7 +6800,7 @@ namespace TiledLensFlare
 									Debug::log_debug() << "Looking for best replacement" << Debug::end;
 
 								auto [replacedPolynomial, replacedError] = findBestReplace(scene, object, fitParameters, regressionParams, resultStats,
-									expandedPolynomial, datasetsSubsampledFit, datasetsSubsampled, variableName);
+									expandedPolynomial, datasetsTrainingFit, datasetsTraining, variableName);
 								if (replacedError < prevError)
 								{
 									Debug::log_output(outputLevel) << "   " << "error after expansion & replacement: " << replacedError << Debug::end;
@@ -5808,7 +6839,7 @@ namespace TiledLensFlare
 
 								// Simplify the polynomial
 								auto [simplifiedPolynomial, simplifiedError] = simplifyPolynomial(scene, object, fitParameters, regressionParams, resultStats,
-									resultPolynomial, datasetsSubsampledFit, datasetsSubsampled, variableName, depth);
+									resultPolynomial, datasetsTrainingFit, datasetsTraining, variableName, depth);
 								if (simplifiedError < (prevError + simplificationErrorIncrease))
 								{
 									Debug::log_output(outputLevel) << "   " << "error after simplification: " << simplifiedError << Debug::end;
@@ -5830,6 +6861,24 @@ namespace TiledLensFlare
 							}
 						}
 
+						// Stop once the validation error no longer improves
+						if (useValidation)
+						{
+							const float validationError = getValidationError(resultPolynomial);
+							if (validationError < bestValidationError)
+							{
+								bestValidationPolynomial = resultPolynomial;
+								bestValidationError = validationError;
+								numIterationsWithoutImprovement = 0;
+							}
+							else if (++numIterationsWithoutImprovement >= regressionParams.m_validationPatience)
+							{
+								Debug::log_output(outputLevel) << "   " << "validation error stopped improving (" << bestValidationError << "), stopping" << Debug::end;
+
+								break;
+							}
+						}
+
 						// Early stopping
 						if (prevError < stopErrorThreshold)
 						{
@@ -5910,6 +6959,30 @@ namespace TiledLensFlare
 						++iterationID;
 					}
 
+					// Fall back to the best polynomial on the validation set, and drop the terms it doesn't need
+					if (useValidation)
+					{
+						resultPolynomial = bestValidationPolynomial;
+						for (bool trimmed = true; trimmed && resultPolynomial.size() > 1;)
+						{
+							trimmed = false;
+							for (size_t termID = 0; termID < resultPolynomial.size() && !trimmed; ++termID)
+							{
+								PolynomialN<N> trimmedPolynomial = resultPolynomial;
+								trimmedPolynomial.erase(trimmedPolynomial.begin() + termID);
+								const float trimmedError = getValidationError(trimmedPolynomial);
+								if (trimmedError <= bestValidationError)
+								{
+									resultPolynomial = trimmedPolynomial;
+									bestValidationError = trimmedError;
+									trimmed = true;
+								}
+							}
+						}
+
+						Debug::log_output(outputLevel) << "Validation error: " << bestValidationError << ", #terms: " << resultPolynomial.size() << Debug::end;
+					}
+
 					// Fill in the stats
 					resultStats.m_computationTimer.stop();
 
@@ -5949,6 +7022,252 @@ namespace TiledLensFlare
 					return result;
 				}
 			}
+
+			////////////////////////////////////////////////////////////////////////////////
+			namespace SparseRegression
+			{
+				////////////////////////////////////////////////////////////////////////////////
+				/** Design matrix of a single dataset entry over the whole candidate dictionary. */
+				struct EntryDictionary
+				{
+					// Candidate terms evaluated at each sample, with unit-norm columns
+					Eigen::MatrixXd m_A;
+
+					// Target values and the residual of the current fit
+					Eigen::VectorXd m_b;
+					Eigen::VectorXd m_residual;
+				};
+
+				////////////////////////////////////////////////////////////////////////////////
+				template<size_t N>
+				std::vector<EntryDictionary> buildEntryDictionaries(PolynomialN<N> const& dictionary, FitDataSetN<N> const& datasetFit)
+				{
+					// Only non-empty entries take part in the selection
+					std::vector<size_t> entryIds;
+					for (size_t entryId = 0; entryId < datasetFit.num_elements(); ++entryId)
+						if (!datasetFit.data()[entryId].empty())
+							entryIds.push_back(entryId);
+
+					std::vector<EntryDictionary> result(entryIds.size());
+					Threading::threadedExecuteIndices(Threading::numThreads(),
+						[&](Threading::ThreadedExecuteEnvironment const& environment, size_t i)
+						{
+							FitDataPointsN<N> const& dataPoints = datasetFit.data()[entryIds[i]];
+							EntryDictionary& entry = result[i];
+
+							// Evaluate the candidates and normalize them, so the correlations are comparable
+							entry.m_A = Eigen::MatrixXd(dataPoints.size(), dictionary.size());
+							for (size_t termID = 0; termID < dictionary.size(); ++termID)
+							{
+								for (size_t sampleID = 0; sampleID < dataPoints.size(); ++sampleID)
+									entry.m_A(sampleID, termID) = Monomials::evalMonomial(dataPoints[sampleID], dictionary[termID], 1.0f);
+								const double norm = entry.m_A.col(termID).norm();
+								if (norm > 0.0) entry.m_A.col(termID) /= norm;
+							}
+
+							// Construct the Y vector
+							entry.m_b = Eigen::VectorXd(dataPoints.size());
+							std::transform(dataPoints.begin(), dataPoints.end(), entry.m_b.data(),
+								[](FitDataSamplePointN<N> const& sample) { return double(sample.m_value); });
+							entry.m_residual = entry.m_b;
+						},
+						entryIds.size());
+					return result;
+				}
+
+				////////////////////////////////////////////////////////////////////////////////
+				/** Greedily picks the term most correlated with the residuals of every entry, then refits the selected terms. */
+				std::vector<size_t> selectTermsOrthogonalMatchingPursuit(std::vector<EntryDictionary>& entries, 
+					const size_t numCandidates, const size_t maxTerms, FitStatsData& resultStats)
+				{
+					std::vector<size_t> selectedTerms;
+					std::vector<bool> isSelected(numCandidates, false);
+					std::vector<double> scores(numCandidates);
+					while (selectedTerms.size() < maxTerms)
+					{
+						// Score each candidate by its correlation with the current residuals
+						Threading::threadedExecuteIndices(Threading::numThreads(),
+							[&](Threading::ThreadedExecuteEnvironment const& environment, size_t termID)
+							{
+								double score = 0.0;
+								if (!isSelected[termID])
+									for (auto const& entry : entries)
+										score += glm::pow(entry.m_A.col(termID).dot(entry.m_residual), 2.0);
+								scores[termID] = score;
+							},
+							numCandidates);
+						resultStats.m_numPermutationsTested += numCandidates - selectedTerms.size();
+
+						// Pick the best one (the first one on ties)
+						const size_t bestTerm = std::distance(scores.begin(), std::max_element(scores.begin(), scores.end()));
+						if (scores[bestTerm] <= 0.0) break;
+						selectedTerms.push_back(bestTerm);
+						isSelected[bestTerm] = true;
+
+						// Project the targets onto the span of the selected terms
+						Threading::threadedExecuteIndices(Threading::numThreads(),
+							[&](Threading::ThreadedExecuteEnvironment const& environment, size_t i)
+							{
+								EntryDictionary& entry = entries[i];
+								Eigen::MatrixXd As(entry.m_A.rows(), selectedTerms.size());
+								for (size_t termID = 0; termID < selectedTerms.size(); ++termID)
+									As.col(termID) = entry.m_A.col(selectedTerms[termID]);
+								entry.m_residual = entry.m_b - As * As.colPivHouseholderQr().solve(entry.m_b);
+							},
+							entries.size());
+					}
+					return selectedTerms;
+				}
+
+				////////////////////////////////////////////////////////////////////////////////
+				/** 
+				 * Group LASSO over the entries (each term is either used by every entry or none), solved with block coordinate descent
+				 * along a decreasing regularization path, until the requested number of terms becomes active.
+				 */
+				std::vector<size_t> selectTermsLasso(PolynomialFitParameters::SparseRegressionParams const& sparseParams, 
+					std::vector<EntryDictionary>& entries, const size_t numCandidates, const size_t maxTerms, FitStatsData& resultStats)
+				{
+					const size_t numEntries = entries.size();
+
+					// Per-entry coefficients of each candidate
+					Eigen::MatrixXd coefficients = Eigen::MatrixXd::Zero(numCandidates, numEntries);
+
+					// Candidate correlations with the residuals, offset by its own contribution
+					auto candidateGradient = [&](const size_t termID)
+					{
+						Eigen::VectorXd result(numEntries);
+						for (size_t entryId = 0; entryId < numEntries; ++entryId)
+							result[entryId] = entries[entryId].m_A.col(termID).dot(entries[entryId].m_residual) + coefficients(termID, entryId);
+						return result;
+					};
+
+					// Smallest penalty at which every candidate is inactive
+					double lambda = 0.0;
+					for (size_t termID = 0; termID < numCandidates; ++termID)
+						lambda = glm::max(lambda, candidateGradient(termID).norm());
+
+					std::vector<size_t> selectedTerms;
+					for (int stepID = 0; stepID < sparseParams.m_lassoPathSteps; ++stepID)
+					{
+						lambda *= sparseParams.m_lassoPathDecay;
+
+						// Block coordinate descent, warm-started from the previous step
+						for (int sweepID = 0; sweepID < sparseParams.m_lassoMaxSweeps; ++sweepID)
+						{
+							double maxChange = 0.0;
+							for (size_t termID = 0; termID < numCandidates; ++termID)
+							{
+								// Group soft-thresholding (the columns have unit norm)
+								const Eigen::VectorXd gradient = candidateGradient(termID);
+								const double gradientNorm = gradient.norm();
+								const Eigen::VectorXd newCoefficients = gradientNorm > lambda ? 
+									Eigen::VectorXd((1.0 - lambda / gradientNorm) * gradient) : Eigen::VectorXd::Zero(numEntries);
+								const Eigen::VectorXd delta = newCoefficients - coefficients.row(termID).transpose();
+								if (delta.isZero(0.0)) continue;
+
+								// Update the residuals
+								for (size_t entryId = 0; entryId < numEntries; ++entryId)
+									entries[entryId].m_residual -= entries[entryId].m_A.col(termID) * delta[entryId];
+								coefficients.row(termID) = newCoefficients.transpose();
+								maxChange = glm::max(maxChange, delta.cwiseAbs().maxCoeff());
+							}
+							resultStats.m_numPermutationsTested += numCandidates;
+							if (maxChange < sparseParams.m_lassoTolerance) break;
+						}
+
+						// Collect the active set at the current penalty
+						std::vector<size_t> activeTerms;
+						for (size_t termID = 0; termID < numCandidates; ++termID)
+							if (coefficients.row(termID).squaredNorm() > 0.0)
+								activeTerms.push_back(termID);
+
+						// Keep the strongest terms if the step activated too many at once
+						if (activeTerms.size() > maxTerms)
+						{
+							std::stable_sort(activeTerms.begin(), activeTerms.end(), [&](const size_t a, const size_t b)
+								{ return coefficients.row(a).squaredNorm() > coefficients.row(b).squaredNorm(); });
+							activeTerms.resize(maxTerms);
+							std::sort(activeTerms.begin(), activeTerms.end());
+						}
+
+						selectedTerms = activeTerms;
+						if (selectedTerms.size() >= maxTerms) break;
+					}
+					return selectedTerms;
+				}
+
+				////////////////////////////////////////////////////////////////////////////////
+				template<size_t N>
+				FitResultN<N> fit(Scene::Scene& scene, Scene::Object* object, std::string const& variableName,
+					FitDataSetN<N> const& datasets, FitDataSetN<N> const& datasetsSubsampled,
+					PolynomialFitParameters const& fitParameters, PolynomialFitParameters::SparseRegressionParams const& sparseParams)
+				{
+					Debug::DebugOutputLevel outputLevel = fitParameters.m_debugComputation >= PolynomialFitParameters::DebugLevel::LightDebug ? Debug::Info : Debug::Debug;
+
+					const size_t numAngles = datasets.shape()[0];
+					const size_t numRotations = datasets.shape()[1];
+					const size_t numWavelengths = datasets.shape()[2];
+
+					// Candidate dictionary
+					PolynomialN<N> dictionary = DensePolynomial::makeDensePolynomial<N>(fitParameters.m_maxTermDegree, true);
+					dictionary.erase(std::remove_if(dictionary.begin(), dictionary.end(), [&](MonomialN<N> const& monomial)
+						{ return usesDisabledInputVariables(fitParameters, monomial); }), dictionary.end());
+
+					// Results of the fitting
+					FitResultN<N> result(boost::extents[numAngles][numRotations][numWavelengths]);
+					FitStatsData resultStats;
+					resultStats.m_computationTimer.start();
+
+					FitDataSetN<N> const& datasetsSubsampledFit = constructFitDataset(fitParameters, datasetsSubsampled);
+					FitDataSetN<N> const& datasetsFit = constructFitDataset(fitParameters, datasets);
+
+					// Select the terms
+					std::vector<EntryDictionary> entries = buildEntryDictionaries(dictionary, datasetsSubsampledFit);
+					const size_t maxTerms = std::min(size_t(fitParameters.m_numSparseTerms), dictionary.size());
+					std::vector<size_t> selectedTerms;
+					switch (sparseParams.m_selectionMethod)
+					{
+					case PolynomialFitParameters::SparseSelectionMethod::OrthogonalMatchingPursuit:
+						selectedTerms = selectTermsOrthogonalMatchingPursuit(entries, dictionary.size(), maxTerms, resultStats);
+						break;
+					case PolynomialFitParameters::SparseSelectionMethod::Lasso:
+						selectedTerms = selectTermsLasso(sparseParams, entries, dictionary.size(), maxTerms, resultStats);
+						break;
+					}
+
+					// Construct the resulting polynomial, falling back to a constant if nothing could be selected
+					PolynomialN<N> resultPolynomial(selectedTerms.size());
+					std::transform(selectedTerms.begin(), selectedTerms.end(), resultPolynomial.begin(), [&](const size_t termID) { return dictionary[termID]; });
+					if (resultPolynomial.empty())
+						resultPolynomial = DensePolynomial::makeDensePolynomial<N>(1, false);
+
+					Debug::log_output(outputLevel) << "Selected " << resultPolynomial.size() << " terms out of " << dictionary.size() << " candidates" << Debug::end;
+					if (fitParameters.m_debugComputation >= PolynomialFitParameters::DebugLevel::LightDebug)
+						Debug::log_debug() << "   " << resultPolynomial << Debug::end;
+
+					// Fill in the stats
+					resultStats.m_computationTimer.stop();
+
+					for (size_t angleID = 0; angleID < numAngles; ++angleID)
+					for (size_t rotationID = 0; rotationID < numRotations; ++rotationID)
+					for (size_t wavelengthID = 0; wavelengthID < numWavelengths; ++wavelengthID)
+					{
+						// Perform the final fit
+						result[angleID][rotationID][wavelengthID].m_polynomial = DensePolynomial::fitDenseCoefficients(fitParameters, resultPolynomial,
+							datasetsFit[angleID][rotationID][wavelengthID], true,
+							fitParameters.m_nonlinearFitFrequency != PolynomialFitParameters::NonlinearFitFrequency::Never);
+
+						// Evaluate the fitting errors and store the result
+						resultStats.m_numIterations = selectedTerms.size();
+						resultStats.m_numTerms = resultPolynomial.size();
+						resultStats.m_finalErrorSubSampled = getApproximationError(scene, object, fitParameters, result[angleID][rotationID][wavelengthID].m_polynomial, datasetsSubsampled[angleID][rotationID][wavelengthID], variableName);
+						resultStats.m_finalErrorFullDataset = getApproximationError(scene, object, fitParameters, result[angleID][rotationID][wavelengthID].m_polynomial, datasets[angleID][rotationID][wavelengthID], variableName);
+						result[angleID][rotationID][wavelengthID].m_fitStats = resultStats;
+					}
+
+					return result;
+				}
+			}
 		}
 
 		////////////////////////////////////////////////////////////////////////////////
@@ -6078,26 +7397,26 @@ namespace TiledLensFlare
 					result[variableID][0][0][0].resize(numDataPoints);
 				}
 
-				// Collect the samples
-				for (size_t variableID = 0; variableID < numVariables; ++variableID)
+				// Collect the samples; each compact entry is only unpacked once for all the variables
+				size_t outID = 0;
+				for (size_t angleID = 0; angleID < numAngles; ++angleID)
+				for (size_t rotationID = 0; rotationID < numRotations; ++rotationID)
+				for (size_t wavelengthID = 0; wavelengthID < numWavelengths; ++wavelengthID)
 				{
-					size_t outID = 0;
-					for (size_t angleID = 0; angleID < numAngles; ++angleID)
-					for (size_t rotationID = 0; rotationID < numRotations; ++rotationID)
-					for (size_t wavelengthID = 0; wavelengthID < numWavelengths; ++wavelengthID)
+					auto const& samples = ghostGeometry[angleID][rotationID][wavelengthID];
+					for (size_t sampleID = 0; sampleID < samples.size(); ++sampleID, ++outID)
 					{
-						auto const& samples = ghostGeometry[angleID][rotationID][wavelengthID];
-						for (size_t sampleID = 0; sampleID < samples.size(); ++sampleID)
+						const GhostGeometry::GeometryEntry sample = samples[sampleID];
+						for (size_t variableID = 0; variableID < numVariables; ++variableID)
 						{
-							GhostGeometry::GeometryEntry const& sample = samples[sampleID];
-							FitDataSamplePoint const& outSample = PolynomialsCommon::Fitting::makeSamplePoint(
+							result[variableID][0][0][0][outID] = PolynomialsCommon::Fitting::makeSamplePoint(
 								scene, object, fitParameters, camera, sample, s_polynomialInputVariables,
 								s_polynomialOutputVariables[variableID]);
-							result[variableID][0][0][0][outID++] = outSample;
 						}
 					}
-					result[variableID][0][0][0].resize(outID);
 				}
+				for (size_t variableID = 0; variableID < numVariables; ++variableID)
+					result[variableID][0][0][0].resize(outID);
 
 				// Return the result
 				return std::make_pair(result, numValidEntries);
@@ -6179,7 +7498,7 @@ namespace TiledLensFlare
 						Debug::log_info() << "Computing polynomials for \"" << variableName << "\" (" << (variableID + 1) << "/" << numVariables << ")" << Debug::end;
 
 						// Initialize the fitting
-						FitDataSet datasetSubsampled = PolynomialsCommon::Fitting::subsampleDataset(fitParameters, dataset[variableID], annealingParams.m_numSamples);
+						FitDataSet datasetSubsampled = PolynomialsCommon::Fitting::subsampleDataset(fitParameters, dataset[variableID], variableName, annealingParams.m_numSamples);
 						fitStats.m_perVariable[variableID].m_computationTimer.start();
 
 						// Perform the fitting
@@ -6226,7 +7545,7 @@ namespace TiledLensFlare
 						Debug::log_info() << "Computing polynomials for \"" << variableName << "\" (" << (variableID + 1) << "/" << numVariables << ")" << Debug::end;
 
 						// Initialize the fitting
-						FitDataSet datasetSubsampled = PolynomialsCommon::Fitting::subsampleDataset(fitParameters, dataset[variableID], numSamples);
+						FitDataSet datasetSubsampled = PolynomialsCommon::Fitting::subsampleDataset(fitParameters, dataset[variableID], variableName, numSamples);
 						fitStats.m_perVariable[variableID].m_computationTimer.start();
 
 						// Perform the fitting
@@ -6240,6 +7559,52 @@ namespace TiledLensFlare
 				}
 			}
 
+			////////////////////////////////////////////////////////////////////////////////
+			namespace SparseRegression
+			{
+				////////////////////////////////////////////////////////////////////////////////
+				void fit(Scene::Scene& scene, Scene::Object* object, PolynomialFit& polynomials,
+					FitStatsFit& fitStats, const size_t ghostID, FitDataSets const& dataset,
+					const size_t numValidEntries, PolynomialFitParameters const& fitParameters,
+					PolynomialFitParameters::SparseRegressionParams const& sparseParams)
+				{
+					const size_t numVariables = dataset.size();
+
+					Debug::DebugOutputLevel outputLevel = fitParameters.m_debugComputation >= PolynomialFitParameters::DebugLevel::LightDebug ? Debug::Info : Debug::Debug;
+
+					DateTime::ScopedTimer timer(outputLevel, numVariables, DateTime::Seconds, "Polynomial Fitting [Sparse Regression]");
+
+					// Compute the number of samples to use
+					size_t numSamples = sparseParams.m_numSamples * numValidEntries;
+					if (fitParameters.m_ghostGeometryParameters.m_shareNeighboringGeometries)
+					{
+						if (fitParameters.m_ghostGeometryParameters.m_numAngles > 1) numSamples *= 2;
+						if (fitParameters.m_ghostGeometryParameters.m_numRotations > 1) numSamples *= 2;
+					}
+
+					// Construct the output dataset
+					for (size_t variableID = 0; variableID < numVariables; ++variableID)
+					{
+						std::string const& variableName = s_polynomialOutputVariables[variableID];
+
+						// Log the progress
+						Debug::log_info() << "Computing polynomials for \"" << variableName << "\" (" << (variableID + 1) << "/" << numVariables << ")" << Debug::end;
+
+						// Initialize the fitting
+						FitDataSet datasetSubsampled = PolynomialsCommon::Fitting::subsampleDataset(fitParameters, dataset[variableID], variableName, numSamples);
+						fitStats.m_perVariable[variableID].m_computationTimer.start();
+
+						// Perform the fitting
+						auto fitResult = PolynomialsCommon::Fitting::SparseRegression::fit(scene, object,
+							variableName, dataset[variableID], datasetSubsampled, fitParameters, sparseParams);
+
+						// Finalize the fitting
+						fitStats.m_perVariable[variableID].m_computationTimer.stop();
+						storeFitResultEntry(scene, object, polynomials, fitStats, ghostID, variableID, fitResult);
+					}
+				}
+			}
+
 			////////////////////////////////////////////////////////////////////////////////
 			void fitPolynomials(Scene::Scene& scene, Scene::Object* object, PolynomialFit& polynomials, FitStatsFit& fitStats,
 				const size_t ghostID, PolynomialFitParameters const& fitParameters, FitDataSets const& datasets, const size_t numValidEntries)
@@ -6255,6 +7620,9 @@ namespace TiledLensFlare
 				case PolynomialFitParameters::PolynomialRegression:
 					PolynomialRegression::fit(scene, object, polynomials, fitStats, ghostID, datasets, numValidEntries, fitParameters, fitParameters.m_polynomialRegressionParams);
 					break;
+				case PolynomialFitParameters::SparseRegression:
+					SparseRegression::fit(scene, object, polynomials, fitStats, ghostID, datasets, numValidEntries, fitParameters, fitParameters.m_sparseRegressionParams);
+					break;
 				}
 
 				Debug::log_debug() << "Polynomial fit successfuly!" << Debug::end;
@@ -6425,14 +7793,22 @@ namespace TiledLensFlare
 						<< "ghost #" << (ghostID + 1) << "/" << numGhosts
 						<< Debug::end;
 
+					// Reuse the polynomials of an identical ghost, if they were fit before
+					const std::string ghostFilePath = GhostFilePaths::getPolynomialWeightsFullFitGhostFilePath(scene, object, ghostID);
+					if (fitParams.m_reuseGhostFits && PolynomialsCommon::GhostFitCache::loadGhostPolynomials(scene, object, ghostFilePath, polynomials, ghostID))
+						continue;
+
 					// List of ghost geometries for polynomial fitting
-					const PolynomialsCommon::PrecomputedGhostGeometry ghostGeometries = PolynomialsCommon::ComputeGhostGeometry::computeGhostGeometries(scene, object, ghostID);
+					const PolynomialsCommon::PrecomputedGhostGeometry ghostGeometries = PolynomialsCommon::ComputeGhostGeometry::computeZoomGhostGeometries(scene, object, ghostID);
 
 					// Get the data points
 					auto [datasets, numValidEntries] = Fitting::convertGhostGeometryToFitDataset(scene, object, fitParams, ghostGeometries);
 
 					// Perform the polynomial fitting
 					Fitting::fitPolynomials(scene, object, polynomials, fitStats, ghostID, fitParams, datasets, numValidEntries);
+
+					// Store the result for later incremental fits
+					PolynomialsCommon::GhostFitCache::saveGhostPolynomials(scene, object, ghostFilePath, polynomials, ghostID);
 				}
 
 				// Finalize the computation
@@ -6491,18 +7867,30 @@ namespace TiledLensFlare
 					Debug::log_debug() << "Unable to open polynomial ghost weights file: " << filePath << Debug::end;
 					return PolynomialFit{};
 				}
+				if (!PolynomialsCommon::WeightFileHeader::read(file, filePath)) return PolynomialFit{};
 
+				// Every polynomial stores at least its weight count, which bounds the number of polynomials in the file
+				const size_t maxPolynomials = PolynomialsCommon::getRemainingBytes(file) / sizeof(size_t);
 				size_t numGhosts;
 				size_t numVariables;
-				file.read((char*)&numGhosts, sizeof(numGhosts));
-				file.read((char*)&numVariables, sizeof(numVariables));
+				if (!PolynomialsCommon::readWeightFileCount(file, numGhosts, maxPolynomials) ||
+					!PolynomialsCommon::readWeightFileCount(file, numVariables, NUM_POLYNOMIAL_OUTPUT_VARIABLES) ||
+					numGhosts * numVariables > maxPolynomials)
+				{
+					Debug::log_warning() << "Invalid polynomial ghost weights file: " << filePath << Debug::end;
+					return PolynomialFit{};
+				}
 
 				PolynomialFit weights(boost::extents[numGhosts][numVariables]);
 				for (size_t ghostID = 0; ghostID < numGhosts; ++ghostID)
 				for (size_t variableID = 0; variableID < numVariables; ++variableID)
 				{
 					size_t numWeights;
-					file.read((char*)&numWeights, sizeof(numWeights));
+					if (!PolynomialsCommon::readWeightFileCount(file, numWeights, PolynomialsCommon::getRemainingBytes(file) / sizeof(Monomial)))
+					{
+						Debug::log_warning() << "Truncated polynomial ghost weights file: " << filePath << Debug::end;
+						return PolynomialFit{};
+					}
 					Polynomial polynomial{ numWeights };
 					file.read((char*)polynomial.data(), numWeights * sizeof(Monomial));
 					weights[ghostID][variableID] = polynomial;
@@ -6531,6 +7919,7 @@ namespace TiledLensFlare
 			{
 				EnginePaths::makeDirectoryStructure(filePath, true);
 				std::ofstream outFile(filePath, std::ofstream::binary);
+				PolynomialsCommon::WeightFileHeader::write(outFile);
 
 				const size_t numGhosts = polynomials.shape()[0];
 				const size_t numVariables = polynomials.shape()[1];
@@ -6565,6 +7954,7 @@ namespace TiledLensFlare
 				if (polynomials.empty())
 				{
 					object->component<TiledLensFlareComponent>().m_numPolynomialTermsFullFit = std::vector<size_t>(1000, 0);
+					++object->component<TiledLensFlareComponent>().m_ghostDataVersion;
 					return;
 				}
 
@@ -6578,6 +7968,7 @@ namespace TiledLensFlare
 				Debug::log_debug() << "Number of polynomial terms:" << Debug::end;
 
 				size_t numTotalTerms = 0;
+				++object->component<TiledLensFlareComponent>().m_ghostDataVersion;
 				object->component<TiledLensFlareComponent>().m_numPolynomialTermsFullFit.resize(numGhosts);
 				for (size_t ghostID = 0; ghostID < numGhosts; ++ghostID)
 				{
@@ -6594,7 +7985,7 @@ namespace TiledLensFlare
 
 				const size_t totalMemory =
 					numTotalTerms * sizeof(float) +  // coefficients
-					numTotalTerms * 6 * sizeof(int); // degrees;
+					numTotalTerms * NUM_POLYNOMIAL_INPUT_VARIABLES * sizeof(int); // degrees;
 				Debug::log_debug() << "Total memory needed (full model): " << Units::bytesToString(totalMemory) << Debug::end;
 
 				// Populate the data vector and upload it
@@ -6692,29 +8083,27 @@ namespace TiledLensFlare
 
 				// Resize the result vectors
 				for (size_t variableID = 0; variableID < numVariables; ++variableID)
-				{
 					result[variableID].resize(boost::extents[numAngles][numRotations][numWavelengths]);
 
-					for (size_t angleID = 0; angleID < numAngles; ++angleID)
-					for (size_t rotationID = 0; rotationID < numRotations; ++rotationID)
-					for (size_t wavelengthID = 0; wavelengthID < numWavelengths; ++wavelengthID)
-					{
-						// Extract the sample list
-						auto const& samples = ghostGeometry[angleID][rotationID][wavelengthID];
-
-						// Collect the samples
+				for (size_t angleID = 0; angleID < numAngles; ++angleID)
+				for (size_t rotationID = 0; rotationID < numRotations; ++rotationID)
+				for (size_t wavelengthID = 0; wavelengthID < numWavelengths; ++wavelengthID)
+				{
+					// Extract the sample list
+					auto const& samples = ghostGeometry[angleID][rotationID][wavelengthID];
+					for (size_t variableID = 0; variableID < numVariables; ++variableID)
 						result[variableID][angleID][rotationID][wavelengthID].resize(samples.size());
 
-						size_t outID = 0;
-						for (size_t sampleID = 0; sampleID < samples.size(); ++sampleID)
+					// Collect the samples; each compact entry is only unpacked once for all the variables
+					for (size_t sampleID = 0; sampleID < samples.size(); ++sampleID)
+					{
+						const GhostGeometry::GeometryEntry sample = samples[sampleID];
+						for (size_t variableID = 0; variableID < numVariables; ++variableID)
 						{
-							GhostGeometry::GeometryEntry const& sample = samples[sampleID];
-							FitDataSamplePoint const& outSample = PolynomialsCommon::Fitting::makeSamplePoint(
+							result[variableID][angleID][rotationID][wavelengthID][sampleID] = PolynomialsCommon::Fitting::makeSamplePoint(
 								scene, object, fitParameters, camera, sample, s_polynomialInputVariables,
 								s_polynomialOutputVariables[variableID]);
-							result[variableID][angleID][rotationID][wavelengthID][outID++] = outSample;
 						}
-						result[variableID][angleID][rotationID][wavelengthID].resize(outID);
 					}
 				}
 
@@ -6811,7 +8200,7 @@ namespace TiledLensFlare
 						Debug::log_info() << "Computing polynomials for \"" << variableName << "\" (" << (variableID + 1) << "/" << numVariables << ")" << Debug::end;
 
 						// Initialize the fitting
-						FitDataSet datasetSubsampled = PolynomialsCommon::Fitting::subsampleDataset(fitParameters, dataset[variableID], annealingParams.m_numSamples);
+						FitDataSet datasetSubsampled = PolynomialsCommon::Fitting::subsampleDataset(fitParameters, dataset[variableID], variableName, annealingParams.m_numSamples);
 						fitStats.m_perVariable[variableID].m_computationTimer.start();
 
 						// Perform the fitting
@@ -6860,7 +8249,7 @@ namespace TiledLensFlare
 						Debug::log_info() << "Computing polynomials for \"" << variableName << "\" (" << (variableID + 1) << "/" << numVariables << ")" << Debug::end;
 
 						// Initialize the fitting
-						FitDataSet datasetSubsampled = PolynomialsCommon::Fitting::subsampleDataset(fitParameters, dataset[variableID], numSamples);
+						FitDataSet datasetSubsampled = PolynomialsCommon::Fitting::subsampleDataset(fitParameters, dataset[variableID], variableName, numSamples);
 						fitStats.m_perVariable[variableID].m_computationTimer.start();
 
 						// Perform the fitting
@@ -6875,38 +8264,87 @@ namespace TiledLensFlare
 			}
 
 			////////////////////////////////////////////////////////////////////////////////
-			void fitPolynomials(Scene::Scene& scene, Scene::Object* object, PolynomialFit& polynomials, FitStatsFit& fitStats,
-				const size_t ghostID, PolynomialFitParameters const& fitParameters, FitDataSets const& datasets)
+			namespace SparseRegression
 			{
-				Debug::log_debug() << "Fitting full polynomials to data..." << Debug::end;
-
-				// Perform the fitting
-				switch (fitParameters.m_fitMethod)
+				////////////////////////////////////////////////////////////////////////////////
+				void fit(Scene::Scene& scene, Scene::Object* object, PolynomialFit& polynomials,
+					FitStatsFit& fitStats, const size_t ghostID, FitDataSets const& dataset,
+					PolynomialFitParameters const& fitParameters,
+					PolynomialFitParameters::SparseRegressionParams const& sparseParams)
 				{
-				case PolynomialFitParameters::SimulatedAnnealing:
-					SimulatedAnnealing::fit(scene, object, polynomials, fitStats, ghostID, datasets, fitParameters, fitParameters.m_annealingParams);
-					break;
-				case PolynomialFitParameters::PolynomialRegression:
-					PolynomialRegression::fit(scene, object, polynomials, fitStats, ghostID, datasets, fitParameters, fitParameters.m_polynomialRegressionParams);
-					break;
-				}
+					const size_t numVariables = dataset.size();
 
-				Debug::log_debug() << "Polynomial fit successfuly!" << Debug::end;
-			}
+					Debug::DebugOutputLevel outputLevel = fitParameters.m_debugComputation >= PolynomialFitParameters::DebugLevel::LightDebug ? Debug::Info : Debug::Debug;
 
-			////////////////////////////////////////////////////////////////////////////////
-			void saveFitStats(Scene::Scene& scene, Scene::Object* object, std::string const& fileName, std::stringstream const& ss)
-			{
-				std::string filePath = GhostFilePaths::getPolynomialWeightsPartialFitFilePath(scene, object, fileName + ".txt");
-				EnginePaths::makeDirectoryStructure(filePath, true);
-				std::ofstream of(filePath);
-				of << ss.str();
-				of.close();
-			}
+					DateTime::ScopedTimer timer(outputLevel, numVariables, DateTime::Seconds, "Polynomial Fitting [Sparse Regression]");
 
-			////////////////////////////////////////////////////////////////////////////////
-			void reportFitStats(Scene::Scene& scene, Scene::Object* object, PolynomialFit const& polynomials, FitStatsFit const& fitStats)
-			{
+					// Compute the number of samples to use
+					size_t numSamples = sparseParams.m_numSamples;
+					if (fitParameters.m_ghostGeometryParameters.m_shareNeighboringGeometries)
+					{
+						if (fitParameters.m_ghostGeometryParameters.m_numAngles > 1) numSamples *= 2;
+						if (fitParameters.m_ghostGeometryParameters.m_numRotations > 1) numSamples *= 2;
+					}
+
+					// Construct the output dataset
+					for (size_t variableID = 0; variableID < numVariables; ++variableID)
+					{
+						std::string const& variableName = s_polynomialOutputVariables[variableID];
+
+						// Log the progress
+						Debug::log_info() << "Computing polynomials for \"" << variableName << "\" (" << (variableID + 1) << "/" << numVariables << ")" << Debug::end;
+
+						// Initialize the fitting
+						FitDataSet datasetSubsampled = PolynomialsCommon::Fitting::subsampleDataset(fitParameters, dataset[variableID], variableName, numSamples);
+						fitStats.m_perVariable[variableID].m_computationTimer.start();
+
+						// Perform the fitting
+						auto fitResult = PolynomialsCommon::Fitting::SparseRegression::fit(scene, object,
+							variableName, dataset[variableID], datasetSubsampled, fitParameters, sparseParams);
+
+						// Finalize the fitting
+						fitStats.m_perVariable[variableID].m_computationTimer.stop();
+						storeFitResultEntry(scene, object, polynomials, fitStats, ghostID, variableID, fitResult);
+					}
+				}
+			}
+
+			////////////////////////////////////////////////////////////////////////////////
+			void fitPolynomials(Scene::Scene& scene, Scene::Object* object, PolynomialFit& polynomials, FitStatsFit& fitStats,
+				const size_t ghostID, PolynomialFitParameters const& fitParameters, FitDataSets const& datasets)
+			{
+				Debug::log_debug() << "Fitting full polynomials to data..." << Debug::end;
+
+				// Perform the fitting
+				switch (fitParameters.m_fitMethod)
+				{
+				case PolynomialFitParameters::SimulatedAnnealing:
+					SimulatedAnnealing::fit(scene, object, polynomials, fitStats, ghostID, datasets, fitParameters, fitParameters.m_annealingParams);
+					break;
+				case PolynomialFitParameters::PolynomialRegression:
+					PolynomialRegression::fit(scene, object, polynomials, fitStats, ghostID, datasets, fitParameters, fitParameters.m_polynomialRegressionParams);
+					break;
+				case PolynomialFitParameters::SparseRegression:
+					SparseRegression::fit(scene, object, polynomials, fitStats, ghostID, datasets, fitParameters, fitParameters.m_sparseRegressionParams);
+					break;
+				}
+
+				Debug::log_debug() << "Polynomial fit successfuly!" << Debug::end;
+			}
+
+			////////////////////////////////////////////////////////////////////////////////
+			void saveFitStats(Scene::Scene& scene, Scene::Object* object, std::string const& fileName, std::stringstream const& ss)
+			{
+				std::string filePath = GhostFilePaths::getPolynomialWeightsPartialFitFilePath(scene, object, fileName + ".txt");
+				EnginePaths::makeDirectoryStructure(filePath, true);
+				std::ofstream of(filePath);
+				of << ss.str();
+				of.close();
+			}
+
+			////////////////////////////////////////////////////////////////////////////////
+			void reportFitStats(Scene::Scene& scene, Scene::Object* object, PolynomialFit const& polynomials, FitStatsFit const& fitStats)
+			{
 				// Precompute parameters
 				PolynomialFitParameters const& fitParams = object->component<TiledLensFlareComponent>().m_polynomialFitParameters;
 				PhysicalCamera::PhysicalCameraAttributes const& camera = object->component<TiledLensFlareComponent>().m_camera;
@@ -7071,14 +8509,22 @@ namespace TiledLensFlare
 						<< "ghost #" << (ghostID + 1) << "/" << numGhosts
 						<< Debug::end;
 
+					// Reuse the polynomials of an identical ghost, if they were fit before
+					const std::string ghostFilePath = GhostFilePaths::getPolynomialWeightsPartialFitGhostFilePath(scene, object, ghostID);
+					if (fitParams.m_reuseGhostFits && PolynomialsCommon::GhostFitCache::loadGhostPolynomials(scene, object, ghostFilePath, polynomials, ghostID))
+						continue;
+
 					// List of ghost geometries for polynomial fitting
-					const PolynomialsCommon::PrecomputedGhostGeometry ghostGeometries = PolynomialsCommon::ComputeGhostGeometry::computeGhostGeometries(scene, object, ghostID);
+					const PolynomialsCommon::PrecomputedGhostGeometry ghostGeometries = PolynomialsCommon::ComputeGhostGeometry::computeZoomGhostGeometries(scene, object, ghostID);
 
 					// Get the data points
 					const FitDataSets datasets = Fitting::convertGhostGeometryToFitDataset(scene, object, fitParams, ghostGeometries);
 
 					// Perform the polynomial fitting
 					Fitting::fitPolynomials(scene, object, polynomials, fitStats, ghostID, fitParams, datasets);
+
+					// Store the result for later incremental fits
+					PolynomialsCommon::GhostFitCache::saveGhostPolynomials(scene, object, ghostFilePath, polynomials, ghostID);
 				}
 
 				// Finalize the computation
@@ -7142,17 +8588,27 @@ namespace TiledLensFlare
 					Debug::log_debug() << "Unable to open polynomial ghost weights file: " << filePath << Debug::end;
 					return PolynomialFit{};
 				}
+				if (!PolynomialsCommon::WeightFileHeader::read(file, filePath)) return PolynomialFit{};
 
+				// Every polynomial stores at least its weight count, which bounds the number of polynomials in the file
+				const size_t maxPolynomials = PolynomialsCommon::getRemainingBytes(file) / sizeof(size_t);
 				size_t numGhosts;
 				size_t numAngles;
 				size_t numRotations;
 				size_t numWavelengths;
 				size_t numVariables;
-				file.read((char*)&numGhosts, sizeof(numGhosts));
-				file.read((char*)&numAngles, sizeof(numAngles));
-				file.read((char*)&numRotations, sizeof(numRotations));
-				file.read((char*)&numWavelengths, sizeof(numWavelengths));
-				file.read((char*)&numVariables, sizeof(numVariables));
+				size_t numPolynomials = 1;
+				bool validCounts = true;
+				for (size_t* count : { &numGhosts, &numAngles, &numRotations, &numWavelengths, &numVariables })
+				{
+					validCounts = validCounts && PolynomialsCommon::readWeightFileCount(file, *count, maxPolynomials / numPolynomials);
+					numPolynomials *= std::max(*count, size_t(1));
+				}
+				if (!validCounts || numVariables > NUM_POLYNOMIAL_OUTPUT_VARIABLES)
+				{
+					Debug::log_warning() << "Invalid polynomial ghost weights file: " << filePath << Debug::end;
+					return PolynomialFit{};
+				}
 
 				PolynomialFit weights(boost::extents[numGhosts][numAngles][numRotations][numWavelengths][numVariables]);
 				for (size_t ghostID = 0; ghostID < numGhosts; ++ghostID)
@@ -7162,7 +8618,11 @@ namespace TiledLensFlare
 				for (size_t variableID = 0; variableID < numVariables; ++variableID)
 				{
 					size_t numWeights;
-					file.read((char*)&numWeights, sizeof(numWeights));
+					if (!PolynomialsCommon::readWeightFileCount(file, numWeights, PolynomialsCommon::getRemainingBytes(file) / sizeof(Monomial)))
+					{
+						Debug::log_warning() << "Truncated polynomial ghost weights file: " << filePath << Debug::end;
+						return PolynomialFit{};
+					}
 					Polynomial polynomial{ numWeights };
 					file.read((char*)polynomial.data(), numWeights * sizeof(Monomial));
 					weights[ghostID][angleID][rotationID][wavelengthID][variableID] = polynomial;
@@ -7199,6 +8659,7 @@ namespace TiledLensFlare
 			{
 				EnginePaths::makeDirectoryStructure(filePath, true);
 				std::ofstream outFile(filePath, std::ofstream::binary);
+				PolynomialsCommon::WeightFileHeader::write(outFile);
 
 				const size_t numGhosts = polynomials.shape()[0];
 				const size_t numAngles = polynomials.shape()[1];
@@ -7242,6 +8703,7 @@ namespace TiledLensFlare
 				if (polynomials.empty())
 				{
 					object->component<TiledLensFlareComponent>().m_numPolynomialTermsPartialFit = std::vector<size_t>(1000, 0);
+					++object->component<TiledLensFlareComponent>().m_ghostDataVersion;
 					return;
 				}
 			
@@ -7257,6 +8719,7 @@ namespace TiledLensFlare
 				// Calculate the number of terms necessary
 				Debug::log_debug() << "Number of polynomial terms:" << Debug::end;
 
+				++object->component<TiledLensFlareComponent>().m_ghostDataVersion;
 				object->component<TiledLensFlareComponent>().m_numPolynomialTermsPartialFit.resize(numGhosts);
 				for (size_t ghostID = 0; ghostID < numGhosts; ++ghostID)
 				{
@@ -7316,67 +8779,176 @@ namespace TiledLensFlare
 		}
 	}
 
+	////////////////////////////////////////////////////////////////////////////////
+	struct GhostParamsCache
+	{
+		// Ghost parameters of a single light, along with the inputs they were computed for
+		struct Entry
+		{
+			float m_angle;
+			float m_rotation;
+			float m_lambert;
+			uint64_t m_stateHash;
+			std::vector<Uniforms::GhostParams> m_ghostParams;
+		};
+
+		std::unordered_map<Scene::Object*, Entry> m_entries;
+	};
+
 	////////////////////////////////////////////////////////////////////////////////
 	namespace Uniforms
 	{
 		////////////////////////////////////////////////////////////////////////////////
-		std::vector<Uniforms::GhostParams> uploadGhostParametersRender(Scene::Scene& scene, Scene::Object* object,
-			LightSources::LightSourceData const& lightData)
+		template<typename T>
+		void hashGhostParamsState(uint64_t& hash, T const& value)
 		{
-			// Extract the ghost parameters
-			std::vector<PhysicalCamera::GhostIndices> const& ghostIndices = object->component<TiledLensFlareComponent>().m_ghostIndices;
+			hash = PhysicalCamera::hashCombine(hash, &value, sizeof(T));
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Hash of every non-light input of the render ghost parameters
+		uint64_t getGhostParamsStateHash(Scene::Scene& scene, Scene::Object* object)
+		{
+			TiledLensFlareComponent const& component = object->component<TiledLensFlareComponent>();
+			RenderGhostsParameters const& renderParams = component.m_renderGhostsParameters;
+			PolynomialFitParameters const& fitParams = component.m_polynomialFitParameters;
+
+			// Camera preset and aperture, along with the precompute settings that select the ghost attribs
+			uint64_t hash = PhysicalCamera::hashPrescription(component.m_camera);
+			const std::string attribPrefix = GhostFilePaths::getFilenamePrefix(scene, object, component.m_precomputeGhostsParameters, component.m_camera);
+			hash = PhysicalCamera::hashCombine(hash, attribPrefix.data(), attribPrefix.size());
+			hashGhostParamsState(hash, component.m_ghostDataVersion);
+			hashGhostParamsState(hash, component.m_ghostIndices.size());
+
+			// Ignored ghosts
+			if (auto it = component.m_commonParameters.m_ignoredGhosts.find(Common::getCamera(scene, object).m_name); it != component.m_commonParameters.m_ignoredGhosts.end())
+				hash = PhysicalCamera::hashCombine(hash, it->second.data(), it->second.size() * sizeof(int));
+
+			// Render settings
+			hashGhostParamsState(hash, renderParams.m_ghostAttribsMethod);
+			hashGhostParamsState(hash, renderParams.m_paraxialBoundsSizeMethod);
+			hashGhostParamsState(hash, renderParams.m_paraxialBoundsSlack);
+			hashGhostParamsState(hash, renderParams.m_rayCountMethod);
+			hashGhostParamsState(hash, renderParams.m_raytraceMethod);
+			hashGhostParamsState(hash, renderParams.m_rayCount);
+			hashGhostParamsState(hash, renderParams.m_rayCountReductionScale);
+			hashGhostParamsState(hash, renderParams.m_rayCountReductionPower);
+			hashGhostParamsState(hash, renderParams.m_rayCountFootprintDensity);
+			hashGhostParamsState(hash, renderParams.m_rayCountFullIntensity);
+			hashGhostParamsState(hash, renderParams.m_rayCountIntensityPower);
+			hashGhostParamsState(hash, renderParams.m_minRayCount);
+			hashGhostParamsState(hash, Common::computeRenderResolution(scene, object));
+			hashGhostParamsState(hash, renderParams.m_firstGhost);
+			hashGhostParamsState(hash, renderParams.m_numGhost);
+			hashGhostParamsState(hash, renderParams.m_numWavelengths);
+			hashGhostParamsState(hash, renderParams.m_intensityScale);
+			hashGhostParamsState(hash, renderParams.m_intensityClipping);
+			hashGhostParamsState(hash, renderParams.m_sizeClipping);
+			hashGhostParamsState(hash, renderParams.m_clipSensor);
+
+			// Polynomial settings
+			hashGhostParamsState(hash, fitParams.m_useDynamicTermCount);
+			hashGhostParamsState(hash, fitParams.m_numSparseTerms);
+			hashGhostParamsState(hash, fitParams.m_ghostGeometryParameters.m_numRotations);
+			hashGhostParamsState(hash, fitParams.m_rotatedBoundsSlackAbsolute);
+			hashGhostParamsState(hash, fitParams.m_rotatedBoundsSlackPercentage);
+
+			return hash;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Ignore list of the current optical system; only performs lookups, so it is safe to call from worker threads
+		std::vector<int> const& getIgnoredGhosts(Scene::Scene& scene, Scene::Object* object)
+		{
+			static const std::vector<int> s_noIgnoredGhosts;
+
+			auto const& ignoredGhosts = object->component<TiledLensFlareComponent>().m_commonParameters.m_ignoredGhosts;
+			auto it = ignoredGhosts.find(Common::getCamera(scene, object).m_name);
+			return it != ignoredGhosts.end() ? it->second : s_noIgnoredGhosts;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Number of ghost and channel combinations that are considered for rendering
+		size_t getNumGhostSlotsRender(Scene::Scene& scene, Scene::Object* object)
+		{
+			const int numAllGhosts = object->component<TiledLensFlareComponent>().m_ghostIndices.size();
 			const int firstGhost = object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_firstGhost;
 			const int numGhosts = object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_numGhost;
 			const int numWavelengths = object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_numWavelengths;
-			auto const& ignoredGhosts = object->component<TiledLensFlareComponent>().m_commonParameters.m_ignoredGhosts[Common::getCamera(scene, object).m_name];
+			return size_t(glm::max(glm::min(firstGhost + numGhosts, numAllGhosts) - firstGhost, 0) * numWavelengths);
+		}
 
-			std::vector<Uniforms::GhostParams> ghostParams;
+		////////////////////////////////////////////////////////////////////////////////
+		// Parameters of a single ghost and channel, or nothing if the ghost is culled; the grid start id is left unset
+		std::optional<Uniforms::GhostParams> computeSingleGhostParametersRender(Scene::Scene& scene, Scene::Object* object,
+			LightSources::LightSourceData const& lightData, std::vector<int> const& ignoredGhosts, const size_t ghostSlotID)
+		{
+			// Extract the ghost parameters
+			std::vector<PhysicalCamera::GhostIndices> const& ghostIndices = object->component<TiledLensFlareComponent>().m_ghostIndices;
+			const int firstGhost = object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_firstGhost;
+			const int numWavelengths = object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_numWavelengths;
+			const int ghostID = firstGhost + int(ghostSlotID) / numWavelengths;
+			const int channelID = int(ghostSlotID) % numWavelengths;
 
-			int gridStartID = 0;
-			for (int ghostID = firstGhost; ghostID < firstGhost + numGhosts && ghostID < ghostIndices.size(); ++ghostID)
-			for (int channelID = 0; channelID < numWavelengths; ++channelID)
-			{
-				// Ghost attributes
-				GhostAttribs::RenderGhostAttribs ghostAttribs = GhostAttribs::getGhostAttribs(scene, object, ghostID, channelID, lightData);
+			// Ghost attributes
+			GhostAttribs::RenderGhostAttribs ghostAttribs = GhostAttribs::getGhostAttribs(scene, object, ghostID, channelID, lightData);
 
-				// Clip low intensity ghosts
-				if (!GhostAttribs::isGhostValid(scene, object, ghostAttribs) || !GhostAttribs::isGhostVisible(scene, object, ghostAttribs))
-					continue;
+			// Clip low intensity ghosts
+			if (!GhostAttribs::isGhostValid(scene, object, ghostAttribs) || !GhostAttribs::isGhostVisible(scene, object, ghostAttribs))
+				return std::nullopt;
 
-				// Ignore ghosts on the ignore list
-				if (std::find(ignoredGhosts.begin(), ignoredGhosts.end(), ghostID) != ignoredGhosts.end())
-					continue;
+			// Ignore ghosts on the ignore list
+			if (std::find(ignoredGhosts.begin(), ignoredGhosts.end(), ghostID) != ignoredGhosts.end())
+				return std::nullopt;
 
-				// Store the ghost parameters
-				GhostParams uniformDataGhostParams;
-				uniformDataGhostParams.m_ghostIndices = glm::ivec2(ghostIndices[ghostID][1], ghostIndices[ghostID][0]);
-				uniformDataGhostParams.m_minPupil = ghostAttribs.m_pupilMin;
-				uniformDataGhostParams.m_maxPupil = ghostAttribs.m_pupilMax;
-				uniformDataGhostParams.m_centerPupil = ghostAttribs.m_pupilCenter;
-				uniformDataGhostParams.m_radiusPupil = ghostAttribs.m_pupilRadius;
-				uniformDataGhostParams.m_minSensor = ghostAttribs.m_sensorMin;
-				uniformDataGhostParams.m_maxSensor = ghostAttribs.m_sensorMax;
-				uniformDataGhostParams.m_rayCount = ghostAttribs.m_rayGridSize;
-				uniformDataGhostParams.m_ghostId = ghostID;
-				uniformDataGhostParams.m_channelId = channelID;
-				uniformDataGhostParams.m_lambda = object->component<TiledLensFlareComponent>().m_camera.m_wavelengths[numWavelengths][channelID];
-				uniformDataGhostParams.m_intensityScale = ghostAttribs.m_intensityScale;
-				uniformDataGhostParams.m_gridStartId = gridStartID;
-				if (object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_useDynamicTermCount)
+			// Store the ghost parameters
+			GhostParams uniformDataGhostParams;
+			uniformDataGhostParams.m_ghostIndices = glm::ivec2(ghostIndices[ghostID][1], ghostIndices[ghostID][0]);
+			uniformDataGhostParams.m_minPupil = ghostAttribs.m_pupilMin;
+			uniformDataGhostParams.m_maxPupil = ghostAttribs.m_pupilMax;
+			uniformDataGhostParams.m_centerPupil = ghostAttribs.m_pupilCenter;
+			uniformDataGhostParams.m_radiusPupil = ghostAttribs.m_pupilRadius;
+			uniformDataGhostParams.m_minSensor = ghostAttribs.m_sensorMin;
+			uniformDataGhostParams.m_maxSensor = ghostAttribs.m_sensorMax;
+			uniformDataGhostParams.m_rayCount = ghostAttribs.m_rayGridSize;
+			uniformDataGhostParams.m_ghostId = ghostID;
+			uniformDataGhostParams.m_channelId = channelID;
+			uniformDataGhostParams.m_lambda = object->component<TiledLensFlareComponent>().m_camera.m_wavelengths[numWavelengths][channelID];
+			uniformDataGhostParams.m_intensityScale = ghostAttribs.m_intensityScale;
+			uniformDataGhostParams.m_gridStartId = 0;
+			uniformDataGhostParams.m_numGridRows = ghostAttribs.m_rayGridSize;
+			if (object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_useDynamicTermCount)
+			{
+				if (object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_raytraceMethod == RenderGhostsParameters::PolynomialFullFit)
 				{
-					if (object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_raytraceMethod == RenderGhostsParameters::PolynomialFullFit)
-					{
-						uniformDataGhostParams.m_numPolynomialTerms = object->component<TiledLensFlareComponent>().m_numPolynomialTermsFullFit[ghostID];
-					}
-					if (object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_raytraceMethod == RenderGhostsParameters::PolynomialPartialFit)
-					{
-						uniformDataGhostParams.m_numPolynomialTerms = object->component<TiledLensFlareComponent>().m_numPolynomialTermsPartialFit[ghostID];
-					}
+					uniformDataGhostParams.m_numPolynomialTerms = object->component<TiledLensFlareComponent>().m_numPolynomialTermsFullFit[ghostID];
 				}
-				else
+				if (object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_raytraceMethod == RenderGhostsParameters::PolynomialPartialFit)
 				{
-					uniformDataGhostParams.m_numPolynomialTerms = object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_numSparseTerms;
+					uniformDataGhostParams.m_numPolynomialTerms = object->component<TiledLensFlareComponent>().m_numPolynomialTermsPartialFit[ghostID];
 				}
+			}
+			else
+			{
+				uniformDataGhostParams.m_numPolynomialTerms = object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_numSparseTerms;
+			}
+			return uniformDataGhostParams;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Compacts the parameters of the visible ghosts of a light and assigns their ray grid start ids
+		template<typename It>
+		std::vector<Uniforms::GhostParams> compactGhostParametersRender(It begin, It end)
+		{
+			std::vector<Uniforms::GhostParams> ghostParams;
+
+			int gridStartID = 0;
+			for (It it = begin; it != end; ++it)
+			{
+				if (!it->has_value()) continue;
+
+				GhostParams uniformDataGhostParams = it->value();
+				uniformDataGhostParams.m_gridStartId = gridStartID;
 				ghostParams.push_back(uniformDataGhostParams);
 
 				// Increment the ray grid start ID
@@ -7386,6 +8958,61 @@ namespace TiledLensFlare
 			return ghostParams;
 		}
 
+		////////////////////////////////////////////////////////////////////////////////
+		// Cache entry of the light, or nullptr if ghost parameter reuse is disabled
+		GhostParamsCache::Entry* getGhostParamsCacheEntry(Scene::Scene& scene, Scene::Object* object, LightSources::LightSourceData const& lightData)
+		{
+			if (!object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_reuseGhostParams)
+				return nullptr;
+
+			auto& ghostParamsCache = object->component<TiledLensFlareComponent>().m_ghostParamsCache;
+			if (ghostParamsCache == nullptr)
+				ghostParamsCache = std::make_shared<GhostParamsCache>();
+			return &ghostParamsCache->m_entries[lightData.m_lightSource];
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Drops the cached parameters of lights that are no longer present
+		void evictGhostParamsCacheEntries(Scene::Scene& scene, Scene::Object* object, std::vector<LightSources::LightSourceData> const& lightSources)
+		{
+			auto& ghostParamsCache = object->component<TiledLensFlareComponent>().m_ghostParamsCache;
+			if (ghostParamsCache == nullptr)
+				return;
+
+			for (auto it = ghostParamsCache->m_entries.begin(); it != ghostParamsCache->m_entries.end();)
+			{
+				const bool present = std::any_of(lightSources.begin(), lightSources.end(),
+					[&](LightSources::LightSourceData const& lightData) { return lightData.m_lightSource == it->first; });
+				it = present ? std::next(it) : ghostParamsCache->m_entries.erase(it);
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Whether the cached parameters are still usable: the light barely moved and nothing else changed
+		bool isGhostParamsCacheEntryValid(Scene::Scene& scene, Scene::Object* object, GhostParamsCache::Entry const* entry,
+			LightSources::LightSourceData const& lightData, const uint64_t stateHash)
+		{
+			const float angleTolerance = object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_ghostParamsAngleTolerance;
+			const float lambertTolerance = object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_ghostParamsLambertTolerance;
+			return entry != nullptr && entry->m_stateHash == stateHash && !entry->m_ghostParams.empty() &&
+				glm::abs(entry->m_angle - lightData.m_angle) <= angleTolerance &&
+				glm::abs(entry->m_rotation - lightData.m_rotation) <= angleTolerance &&
+				glm::abs(entry->m_lambert - lightData.m_lambert) <= lambertTolerance;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		void storeGhostParamsCacheEntry(GhostParamsCache::Entry* entry, LightSources::LightSourceData const& lightData, 
+			const uint64_t stateHash, std::vector<Uniforms::GhostParams> const& ghostParams)
+		{
+			if (entry == nullptr) return;
+
+			entry->m_angle = lightData.m_angle;
+			entry->m_rotation = lightData.m_rotation;
+			entry->m_lambert = lightData.m_lambert;
+			entry->m_stateHash = stateHash;
+			entry->m_ghostParams = ghostParams;
+		}
+
 		////////////////////////////////////////////////////////////////////////////////
 		Uniforms::RenderGhostsLensUniforms uploadLensUniformsRender(Scene::Scene& scene, Scene::Object* object, LightSources::LightSourceData const& lightData)
 		{
@@ -7456,6 +9083,448 @@ namespace TiledLensFlare
 			lensFlareDataCommonTiled.m_sampleBaseScene = !Common::needsTempTexture(scene, object) ? 1 : 0;
 			return lensFlareDataCommonTiled;
 		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		/** Per-light uniforms of every light source, stored as one array per uniform block. */
+		struct LightUniformsRender
+		{
+			// Ghost parameters of every light, stored back to back; the ones of light i are in [offsets[i], offsets[i + 1])
+			std::vector<GhostParams> m_ghostParams;
+			std::vector<size_t> m_ghostParamsOffsets;
+
+			// Lens and common uniforms of each light
+			std::vector<RenderGhostsLensUniforms> m_lensUniforms;
+			std::vector<RenderGhostsCommonUniforms> m_commonUniforms;
+
+			size_t getNumGhostParams(const size_t lightID) const
+			{
+				return m_ghostParamsOffsets[lightID + 1] - m_ghostParamsOffsets[lightID];
+			}
+
+			const GhostParams* getGhostParams(const size_t lightID) const
+			{
+				return m_ghostParams.data() + m_ghostParamsOffsets[lightID];
+			}
+		};
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Uniformly scales down the footprint-based ray grids of every light to fit in the frame's ray budget;
+		// the budget is only exceeded if the grids at their minimum size already overflow it. Returns whether the grids were changed
+		bool applyRayBudget(Scene::Scene& scene, Scene::Object* object, std::vector<GhostParams>& ghostParams, std::vector<size_t> const& offsets)
+		{
+			RenderGhostsParameters const& renderParams = object->component<TiledLensFlareComponent>().m_renderGhostsParameters;
+			if (renderParams.m_rayCountMethod != RenderGhostsParameters::DynamicFootprintBased || renderParams.m_rayBudget <= 0)
+				return false;
+
+			size_t numRays = 0;
+			for (auto const& ghost : ghostParams)
+				numRays += size_t(ghost.m_rayCount) * size_t(ghost.m_rayCount);
+			if (numRays <= size_t(renderParams.m_rayBudget))
+				return false;
+
+			// Shrink each grid edge by the same factor; grids that reach the minimum size are held there, 
+			// and the rest of the budget is shared among the remaining grids until no new grid is clamped
+			std::vector<bool> clamped(ghostParams.size(), false);
+			size_t clampedRays = 0, freeRays = numRays;
+			float scale = 1.0f;
+			for (bool clampedAny = true; clampedAny;)
+			{
+				clampedAny = false;
+				const size_t remainingBudget = size_t(renderParams.m_rayBudget) > clampedRays ? size_t(renderParams.m_rayBudget) - clampedRays : 0;
+				scale = freeRays > 0 ? glm::sqrt(float(remainingBudget) / float(freeRays)) : 0.0f;
+				for (size_t i = 0; i < ghostParams.size(); ++i)
+				{
+					const int minRayCount = glm::min(renderParams.m_minRayCount, ghostParams[i].m_rayCount);
+					if (clamped[i] || int(ghostParams[i].m_rayCount * scale) > minRayCount)
+						continue;
+
+					clamped[i] = clampedAny = true;
+					clampedRays += size_t(minRayCount) * size_t(minRayCount);
+					freeRays -= size_t(ghostParams[i].m_rayCount) * size_t(ghostParams[i].m_rayCount);
+				}
+			}
+			for (size_t i = 0; i < ghostParams.size(); ++i)
+				ghostParams[i].m_rayCount = clamped[i] ? glm::min(renderParams.m_minRayCount, ghostParams[i].m_rayCount) : int(ghostParams[i].m_rayCount * scale);
+
+			// Reassign the grid start ids within each light
+			for (size_t lightID = 0; lightID + 1 < offsets.size(); ++lightID)
+			{
+				int gridStartID = 0;
+				for (size_t i = offsets[lightID]; i < offsets[lightID + 1]; ++i)
+				{
+					ghostParams[i].m_gridStartId = gridStartID;
+					gridStartID += ghostParams[i].m_rayCount * ghostParams[i].m_rayCount;
+				}
+			}
+			return true;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Prepares the uniforms of every light in one parallel pass over lights x ghosts
+		LightUniformsRender prepareLightUniformsRender(Scene::Scene& scene, Scene::Object* object,
+			std::vector<LightSources::LightSourceData> const& lightSources)
+		{
+			const size_t numLights = lightSources.size();
+			const size_t numGhostSlots = getNumGhostSlotsRender(scene, object);
+			std::vector<int> const& ignoredGhosts = getIgnoredGhosts(scene, object);
+
+			// Look up the cached ghost parameters up front, since the cache cannot be modified from multiple threads
+			const uint64_t stateHash = getGhostParamsStateHash(scene, object);
+			evictGhostParamsCacheEntries(scene, object, lightSources);
+			std::vector<GhostParamsCache::Entry*> cacheEntries(numLights);
+			std::vector<size_t> computedLights;
+			for (size_t lightID = 0; lightID < numLights; ++lightID)
+			{
+				cacheEntries[lightID] = getGhostParamsCacheEntry(scene, object, lightSources[lightID]);
+				if (!isGhostParamsCacheEntryValid(scene, object, cacheEntries[lightID], lightSources[lightID], stateHash))
+					computedLights.push_back(lightID);
+			}
+
+			// Evaluate every ghost of the lights that need updating
+			std::vector<std::optional<GhostParams>> ghostSlots(computedLights.size() * numGhostSlots);
+			Threading::threadedExecuteIndices(Threading::numThreads(),
+				[&](Threading::ThreadedExecuteEnvironment const& environment, const size_t computedLightID, const size_t ghostSlotID)
+				{
+					ghostSlots[computedLightID * numGhostSlots + ghostSlotID] = computeSingleGhostParametersRender(scene, object,
+						lightSources[computedLights[computedLightID]], ignoredGhosts, ghostSlotID);
+				},
+				computedLights.size(),
+				numGhostSlots);
+
+			// Compact the visible ghosts of each light and update the cache
+			std::vector<std::vector<GhostParams>> lightGhostParams(numLights);
+			for (size_t computedLightID = 0; computedLightID < computedLights.size(); ++computedLightID)
+			{
+				const size_t lightID = computedLights[computedLightID];
+				auto slotsBegin = ghostSlots.begin() + computedLightID * numGhostSlots;
+				lightGhostParams[lightID] = compactGhostParametersRender(slotsBegin, slotsBegin + numGhostSlots);
+				storeGhostParamsCacheEntry(cacheEntries[lightID], lightSources[lightID], stateHash, lightGhostParams[lightID]);
+			}
+			for (size_t lightID = 0; lightID < numLights; ++lightID)
+				if (std::find(computedLights.begin(), computedLights.end(), lightID) == computedLights.end())
+					lightGhostParams[lightID] = cacheEntries[lightID]->m_ghostParams;
+
+			// Concatenate the ghost parameters
+			LightUniformsRender result;
+			result.m_ghostParamsOffsets.resize(numLights + 1, 0);
+			for (size_t lightID = 0; lightID < numLights; ++lightID)
+				result.m_ghostParamsOffsets[lightID + 1] = result.m_ghostParamsOffsets[lightID] + lightGhostParams[lightID].size();
+			result.m_ghostParams.reserve(result.m_ghostParamsOffsets[numLights]);
+			for (auto const& ghostParams : lightGhostParams)
+				result.m_ghostParams.insert(result.m_ghostParams.end(), ghostParams.begin(), ghostParams.end());
+
+			// Share the ray budget among all lights
+			if (applyRayBudget(scene, object, result.m_ghostParams, result.m_ghostParamsOffsets))
+				for (size_t lightID = 0; lightID < numLights; ++lightID)
+					lightGhostParams[lightID].assign(result.m_ghostParams.begin() + result.m_ghostParamsOffsets[lightID], 
+						result.m_ghostParams.begin() + result.m_ghostParamsOffsets[lightID + 1]);
+
+			// The lens description only depends on the camera; compute it once and fill in the light-specific parts
+			result.m_lensUniforms.resize(numLights);
+			result.m_commonUniforms.resize(numLights);
+			if (numLights == 0) return result;
+
+			const RenderGhostsLensUniforms lensUniforms = uploadLensUniformsRender(scene, object, lightSources[0]);
+			Threading::threadedExecuteIndices(Threading::numThreads(),
+				[&](Threading::ThreadedExecuteEnvironment const& environment, const size_t lightID)
+				{
+					LightSources::LightSourceData const& lightData = lightSources[lightID];
+					result.m_lensUniforms[lightID] = lensUniforms;
+					result.m_lensUniforms[lightID].m_color = lightData.m_lightColor;
+					result.m_lensUniforms[lightID].m_rayDir = lightData.m_toLight;
+					result.m_lensUniforms[lightID].m_lightRotation = lightData.m_rotation;
+					result.m_lensUniforms[lightID].m_lightAngle = lightData.m_angle;
+					result.m_commonUniforms[lightID] = uploadCommonUniformsRender(scene, object, lightGhostParams[lightID]);
+				},
+				numLights);
+
+			return result;
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	struct GhostDataHotReload
+	{
+		// Size and modification time of a watched file
+		struct FileStamp
+		{
+			uint64_t m_fileSize = 0;
+			int64_t m_lastWriteTime = 0;
+
+			bool operator==(FileStamp const& other) const
+			{
+				return m_fileSize == other.m_fileSize && m_lastWriteTime == other.m_lastWriteTime;
+			}
+
+			bool operator!=(FileStamp const& other) const
+			{
+				return !(*this == other);
+			}
+		};
+
+		// Stamps of a single watched file
+		struct WatchedFile
+		{
+			// Stamp of the contents currently in use
+			FileStamp m_loadedStamp;
+
+			// Stamp observed during the previous poll
+			FileStamp m_polledStamp;
+		};
+
+		// Data read back by a single background poll
+		struct PollResult
+		{
+			std::unordered_map<std::string, PrecomputeGhostAttribs> m_ghostAttribs;
+			std::optional<PolynomialsFull::PolynomialFit> m_weightsFullFit;
+			std::optional<PolynomialsPartial::PolynomialFit> m_weightsPartialFit;
+			std::vector<std::string> m_reloadedFiles;
+
+			// Weight file paths the poll was started with
+			std::string m_weightsFullFitPath;
+			std::string m_weightsPartialFitPath;
+		};
+
+		// State of each watched file; only accessed by the background poll while one is in flight
+		std::unordered_map<std::string, WatchedFile> m_watchedFiles;
+
+		// Weight files watched by the previous poll
+		std::vector<std::string> m_activeWeightsFiles;
+
+		// Whether the initial set of stamps has been recorded
+		bool m_initialized = false;
+
+		// The background poll currently in flight
+		std::future<PollResult> m_pendingPoll;
+
+		// When the last poll was started
+		std::chrono::steady_clock::time_point m_lastPollTime;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////
+	namespace HotReload
+	{
+		////////////////////////////////////////////////////////////////////////////////
+		GhostDataHotReload::FileStamp getFileStamp(std::filesystem::path const& filePath)
+		{
+			GhostDataHotReload::FileStamp result;
+			std::error_code ec;
+			result.m_fileSize = std::filesystem::file_size(filePath, ec);
+			if (ec) return GhostDataHotReload::FileStamp{};
+			result.m_lastWriteTime = std::filesystem::last_write_time(filePath, ec).time_since_epoch().count();
+			return result;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Files are only reloaded once their stamp is unchanged between two polls, so that
+		// files still being written or copied over the network are not picked up half-way.
+		bool needsReload(GhostDataHotReload& state, std::string const& filePath)
+		{
+			const GhostDataHotReload::FileStamp stamp = getFileStamp(filePath);
+			if (stamp.m_fileSize == 0) return false;
+
+			auto [it, inserted] = state.m_watchedFiles.try_emplace(filePath);
+			GhostDataHotReload::WatchedFile& watchedFile = it->second;
+
+			// The files present at startup were already loaded by the resource initializers
+			if (inserted && !state.m_initialized)
+			{
+				watchedFile.m_loadedStamp = watchedFile.m_polledStamp = stamp;
+				return false;
+			}
+
+			// Wait for the file to settle
+			if (stamp != watchedFile.m_polledStamp)
+			{
+				watchedFile.m_polledStamp = stamp;
+				return false;
+			}
+
+			if (stamp == watchedFile.m_loadedStamp)
+				return false;
+
+			watchedFile.m_loadedStamp = stamp;
+			return true;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Weight files that just became active were loaded along with the parameter change, so they are 
+		// treated as up-to-date; if the file does not exist yet, it is picked up once it is written.
+		void updateActiveWeightsFiles(GhostDataHotReload& state, std::vector<std::string> const& weightsFiles)
+		{
+			for (auto const& filePath : weightsFiles)
+			{
+				if (filePath.empty() || std::find(state.m_activeWeightsFiles.begin(), state.m_activeWeightsFiles.end(), filePath) != state.m_activeWeightsFiles.end())
+					continue;
+
+				GhostDataHotReload::WatchedFile& watchedFile = state.m_watchedFiles[filePath];
+				watchedFile.m_loadedStamp = watchedFile.m_polledStamp = getFileStamp(filePath);
+			}
+			state.m_activeWeightsFiles = weightsFiles;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		GhostDataHotReload::PollResult pollFiles(Scene::Scene& scene, Scene::Object* object, GhostDataHotReload* state,
+			std::string weightsFullFitPath, std::string weightsPartialFitPath)
+		{
+			GhostDataHotReload::PollResult result;
+			result.m_weightsFullFitPath = weightsFullFitPath;
+			result.m_weightsPartialFitPath = weightsPartialFitPath;
+
+			// Ghost attribute files
+			std::error_code ec;
+			const std::filesystem::path root = EnginePaths::generatedFilesFolder() / "TiledLensFlare" / "GhostAttribs";
+			for (auto const& ghostAttribs : std::filesystem::directory_iterator(root, ec))
+			{
+				if (ghostAttribs.path().extension() != ".dat" || !needsReload(*state, ghostAttribs.path().string()))
+					continue;
+
+				for (auto const& [attribName, attribs] : GhostAttribs::readGhostAttribsFile(ghostAttribs.path().string()))
+					result.m_ghostAttribs[attribName] = attribs;
+				result.m_reloadedFiles.push_back(ghostAttribs.path().string());
+			}
+
+			// Polynomial weight files
+			updateActiveWeightsFiles(*state, { weightsFullFitPath, weightsPartialFitPath });
+			if (!weightsFullFitPath.empty() && needsReload(*state, weightsFullFitPath))
+			{
+				if (auto weights = PolynomialsFull::Serialization::loadGhostWeights(scene, object, weightsFullFitPath); !weights.empty())
+				{
+					result.m_weightsFullFit = std::move(weights);
+					result.m_reloadedFiles.push_back(weightsFullFitPath);
+				}
+			}
+
+			if (!weightsPartialFitPath.empty() && needsReload(*state, weightsPartialFitPath))
+			{
+				if (auto weights = PolynomialsPartial::Serialization::loadGhostWeights(scene, object, weightsPartialFitPath); !weights.empty())
+				{
+					result.m_weightsPartialFit = std::move(weights);
+					result.m_reloadedFiles.push_back(weightsPartialFitPath);
+				}
+			}
+
+			state->m_initialized = true;
+
+			return result;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Only watch the weights of the active raytrace method; the file paths depend on the current parameters
+		std::pair<std::string, std::string> getWatchedWeightsFilePaths(Scene::Scene& scene, Scene::Object* object)
+		{
+			std::string weightsFullFitPath, weightsPartialFitPath;
+			const auto raytraceMethod = object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_raytraceMethod;
+			if (raytraceMethod == RenderGhostsParameters::RaytraceMethod::PolynomialFullFit)
+				weightsFullFitPath = GhostFilePaths::getPolynomialWeightsFullFitFilePath(scene, object);
+			if (raytraceMethod == RenderGhostsParameters::RaytraceMethod::PolynomialPartialFit)
+				weightsPartialFitPath = GhostFilePaths::getPolynomialWeightsPartialFitFilePath(scene, object);
+			return { weightsFullFitPath, weightsPartialFitPath };
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		void applyPollResult(Scene::Scene& scene, Scene::Object* object, GhostDataHotReload::PollResult& result)
+		{
+			// Drop the weights if the parameters changed while the poll was in flight
+			auto const& [weightsFullFitPath, weightsPartialFitPath] = getWatchedWeightsFilePaths(scene, object);
+			if (result.m_weightsFullFit.has_value() && result.m_weightsFullFitPath != weightsFullFitPath)
+			{
+				Debug::log_debug() << "Discarding stale polynomial weights: " << result.m_weightsFullFitPath << Debug::end;
+				result.m_weightsFullFit.reset();
+			}
+			if (result.m_weightsPartialFit.has_value() && result.m_weightsPartialFitPath != weightsPartialFitPath)
+			{
+				Debug::log_debug() << "Discarding stale polynomial weights: " << result.m_weightsPartialFitPath << Debug::end;
+				result.m_weightsPartialFit.reset();
+			}
+
+			for (auto const& fileName : result.m_reloadedFiles)
+				Debug::log_info() << "Reloading changed ghost data file: " << fileName << Debug::end;
+
+			// Swap in the new ghost attributes
+			if (!result.m_ghostAttribs.empty())
+			{
+				GhostAttribs::storeGhostAttribs(scene, object, result.m_ghostAttribs);
+				GhostAttribs::setDynamicIntensityScale(scene, object);
+			}
+
+			// Upload the new polynomial weights
+			if (result.m_weightsFullFit.has_value())
+				PolynomialsFull::Serialization::uploadGhostWeights(scene, object, result.m_weightsFullFit.value());
+			if (result.m_weightsPartialFit.has_value())
+				PolynomialsPartial::Serialization::uploadGhostWeights(scene, object, result.m_weightsPartialFit.value());
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		void updateHotReload(Scene::Scene& scene, Scene::Object* object)
+		{
+			auto& component = object->component<TiledLensFlareComponent>();
+			if (!component.m_commonParameters.m_hotReloadGhostData)
+				return;
+
+			if (component.m_ghostDataHotReload == nullptr)
+				component.m_ghostDataHotReload = std::make_shared<GhostDataHotReload>();
+			GhostDataHotReload& state = *component.m_ghostDataHotReload;
+
+			// Swap in the results of the previous poll once it finishes
+			if (state.m_pendingPoll.valid())
+			{
+				if (state.m_pendingPoll.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+					return;
+
+				try
+				{
+					GhostDataHotReload::PollResult result = state.m_pendingPoll.get();
+					applyPollResult(scene, object, result);
+				}
+				catch (std::exception const& e)
+				{
+					Debug::log_error() << "Failed to hot reload the ghost data: " << e.what() << Debug::end;
+				}
+			}
+
+			// Wait for the poll interval to elapse
+			const auto now = std::chrono::steady_clock::now();
+			if (now - state.m_lastPollTime < std::chrono::duration<float>(component.m_commonParameters.m_hotReloadInterval))
+				return;
+			state.m_lastPollTime = now;
+
+			// Stat and parse the files in the background; the pending future keeps the state alive until the poll returns
+			auto const& [weightsFullFitPath, weightsPartialFitPath] = getWatchedWeightsFilePaths(scene, object);
+			state.m_pendingPoll = std::async(std::launch::async, pollFiles, std::ref(scene), object, &state,
+				weightsFullFitPath, weightsPartialFitPath);
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	// Recomputes the derived camera data, transfer matrices and ghost list if the camera or the ghost pruning settings changed
+	void updateCameraData(Scene::Scene& scene, Scene::Object* object)
+	{
+		if (!object->component<TiledLensFlareComponent>().m_cameraChanged) return;
+
+		// Extract the camera
+		auto& camera = object->component<TiledLensFlareComponent>().m_camera;
+
+		// Bake the aperture textures of analytic aperture shapes
+		PhysicalCamera::bakeApertureTextures(scene, object->component<TiledLensFlareComponent>().m_cameraPresets, camera);
+
+		// Update the refraction indices and derived data
+		PhysicalCamera::propagateCoatingInformation(camera);
+		PhysicalCamera::computeDerivedData(camera);
+
+		// Store the ghost indices
+		object->component<TiledLensFlareComponent>().m_ghostIndices = camera.m_ghosts;
+
+		// Compute the ray transfer matrices
+		const bool pruneGhosts = object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_pruneGhosts;
+		if (pruneGhosts || object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_ghostAttribsMethod == RenderGhostsParameters::GhostAttribsMethod::ParaxialGhostAttribs)
+			TransferMatrices::computeRaytraceLensFlareTransferMatrices(scene, object);
+
+		// Drop the ghosts that are not expected to be visible
+		if (pruneGhosts)
+			GhostPruning::pruneGhosts(scene, object);
+
+		object->component<TiledLensFlareComponent>().m_cameraChanged = false;
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -7542,6 +9611,7 @@ namespace TiledLensFlare
 
 			Asset::loadShader(scene, "LensFlare/RayTraceLensFlare/RenderGhosts", "compute_grid", "RayTraceLensFlare/compute_grid", shaderParametersDirect);
 			Asset::loadShader(scene, "LensFlare/RayTraceLensFlare/RenderGhosts", "render_ghosts", "RayTraceLensFlare/render_ghosts", shaderParametersDirect);
+			Asset::loadShader(scene, "LensFlare/RayTraceLensFlare/RenderGhosts", "render_starburst", "RayTraceLensFlare/render_starburst", shaderParametersDirect);
 
 			// Tiled rasterization shaders
 			Asset::ShaderParameters shaderParametersTiled;
@@ -7713,6 +9783,8 @@ namespace TiledLensFlare
 
 			if (presets.find(camera.m_name) != presets.end())
 				camera = presets[camera.m_name];
+
+			object->component<TiledLensFlareComponent>().m_cameraChanged = true;
 		}
 
 		////////////////////////////////////////////////////////////////////////////////
@@ -7801,19 +9873,11 @@ namespace TiledLensFlare
 	////////////////////////////////////////////////////////////////////////////////
 	void updateObject(Scene::Scene& scene, Scene::Object* simulationSettings, Scene::Object* object)
 	{
-		// Extract the camera
-		auto& camera = object->component<TiledLensFlareComponent>().m_camera;
-
-		// Keep the refraction indices updated
-		PhysicalCamera::computeWavelengths(camera);
-		PhysicalCamera::propagateCoatingInformation(camera);
-
-		// Compute and store the ghost indices
-		object->component<TiledLensFlareComponent>().m_ghostIndices = PhysicalCamera::enumerateGhosts(camera);
+		// Keep the camera data and the ghost list up-to-date
+		updateCameraData(scene, object);
 
-		// Compute the ray transfer matrices
-		if (object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_ghostAttribsMethod == RenderGhostsParameters::GhostAttribsMethod::ParaxialGhostAttribs)
-			TransferMatrices::computeRaytraceLensFlareTransferMatrices(scene, object);
+		// Pick up ghost data files that changed on disk
+		HotReload::updateHotReload(scene, object);
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -7843,6 +9907,7 @@ namespace TiledLensFlare
 				object->component<TiledLensFlareComponent>().m_cameraPresets,
 				object->component<TiledLensFlareComponent>().m_camera);
 			cameraChanged |= descriptionChanged;
+			object->component<TiledLensFlareComponent>().m_cameraChanged |= descriptionChanged || systemChanged || lensesChanged;
 
 			EditorSettings::editorProperty<std::string>(scene, object, "MainTabBar_SelectedTab") = ImGui::CurrentTabItemName();
 			ImGui::EndTabItem();
@@ -7867,6 +9932,9 @@ namespace TiledLensFlare
 				}
 				ImGui::TreePop();
 			}
+			ImGui::Checkbox("Hot Reload Ghost Data", &object->component<TiledLensFlareComponent>().m_commonParameters.m_hotReloadGhostData);
+			if (object->component<TiledLensFlareComponent>().m_commonParameters.m_hotReloadGhostData)
+				ImGui::SliderFloat("Hot Reload Interval", &object->component<TiledLensFlareComponent>().m_commonParameters.m_hotReloadInterval, 0.5f, 60.0f);
 			EditorSettings::editorProperty<std::string>(scene, object, "MainTabBar_SelectedTab") = ImGui::CurrentTabItemName();
 			ImGui::EndTabItem();
 		}
@@ -7876,7 +9944,7 @@ namespace TiledLensFlare
 		{
 			ImGui::TextDisabled("Properties");
 
-			ImGui::Combo("Ghost Attribs", &object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_ghostAttribsMethod,
+			cameraChanged |= ImGui::Combo("Ghost Attribs", &object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_ghostAttribsMethod,
 				RenderGhostsParameters::GhostAttribsMethod_meta);
 			if (object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_ghostAttribsMethod == RenderGhostsParameters::GhostAttribsMethod::ParaxialGhostAttribs)
 			{
@@ -7910,6 +9978,14 @@ namespace TiledLensFlare
 				ImGui::SliderFloat("Ray Count Reduction Scale", &object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_rayCountReductionScale, 0.0f, 4.0f);
 				ImGui::SliderFloat("Ray Count Reduction Power", &object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_rayCountReductionPower, 0.0f, 4.0f);
 			}
+			if (object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_rayCountMethod == RenderGhostsParameters::DynamicFootprintBased)
+			{
+				ImGui::SliderFloat("Rays per Footprint Pixel", &object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_rayCountFootprintDensity, 0.0f, 2.0f);
+				ImGui::SliderFloat("Full Density Intensity", &object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_rayCountFullIntensity, 0.0f, 1.0f, "%.5f", ImGuiSliderFlags_Logarithmic);
+				ImGui::SliderFloat("Intensity Falloff Power", &object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_rayCountIntensityPower, 0.0f, 2.0f);
+				ImGui::SliderInt("Min Ray Count", &object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_minRayCount, 2, 64);
+				ImGui::DragInt("Ray Budget", &object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_rayBudget, 1024.0f, 0, 1 << 26);
+			}
 
 			ImGui::Checkbox("Lock Angle", &object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_lockAngle);
 			ImGui::SameLine();
@@ -7922,6 +9998,13 @@ namespace TiledLensFlare
 			if (object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_lockRotation)
 				ImGui::DragFloatAngle("Fixed Rotation", &object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_fixedRotation, 0.01f, 0.0f, 360.0f);
 
+			ImGui::Checkbox("Reuse Ghost Parameters", &object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_reuseGhostParams);
+			if (object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_reuseGhostParams)
+			{
+				ImGui::SliderAngle("Angle Tolerance", &object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_ghostParamsAngleTolerance, 0.0f, 1.0f);
+				ImGui::SliderFloat("Lambert Tolerance", &object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_ghostParamsLambertTolerance, 0.0f, 0.01f, "%.5f");
+			}
+
 			ImGui::Separator();
 			ImGui::TextDisabled("Ghosts");
 
@@ -7982,6 +10065,13 @@ namespace TiledLensFlare
 
 			ImGui::SliderFloat("Film Stretch", &object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_filmStretch, 0.0f, 4.0f);
 
+			ImGui::Checkbox("Render Starburst", &object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_renderStarburst);
+			if (object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_renderStarburst)
+			{
+				ImGui::SliderFloat("Starburst Size", &object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_starburstSize, 0.0f, 2.0f);
+				ImGui::SliderFloat("Starburst Intensity", &object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_starburstIntensity, 0.0f, 16.0f);
+			}
+
 			if (ImGui::SliderFloat("Resolution Scaling", &object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_resolutionScaling, 0.25f, 4.0f))
 			{
 				DelayedJobs::postJob(scene, object, "Recreate Textures", [](Scene::Scene& scene, Scene::Object& object)
@@ -7998,6 +10088,18 @@ namespace TiledLensFlare
 					Common::computeBlurKernels(scene, &object);
 				});
 			}
+			if (Common::needsBlurring(scene, object) && ImGui::Button("Profile CPU Blur"))
+			{
+				DelayedJobs::postJob(scene, object, "Profile CPU Blur", [](Scene::Scene& scene, Scene::Object& object)
+				{
+					// Read back the accumulation buffer and blur it on the CPU
+					const glm::ivec2 maxResolution = Common::computeMaxResolution(scene, &object);
+					std::vector<float> pixels(size_t(maxResolution.x) * size_t(maxResolution.y) * 4);
+					glBindTexture(GL_TEXTURE_2D, scene.m_textures["TiledLensFlare_Accumulation_0"].m_texture);
+					glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_FLOAT, pixels.data());
+					blurResultCpu(scene, &object, pixels.data(), maxResolution, 4);
+				});
+			}
 			ImGui::Checkbox("Wireframe", &object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_wireframe);
 			ImGui::SameLine();
 			ImGui::Checkbox("Statistics", &object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_readBackStatistics);
@@ -8009,8 +10111,11 @@ namespace TiledLensFlare
 		// Polynomial fit settings
 		if (ImGui::BeginTabItem("Polynomial Fit", activeTab.c_str()))
 		{
-			ImGui::SliderInt("Ray Count", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_ghostGeometryParameters.m_rayCount, 5, 1024); polynomialParamsChanged |= ImGui::IsItemDeactivatedAfterChange();
+			// The fitting path traces whole grids at once, so keep them within the precompute chunk size
+			const int maxFitRayCount = glm::clamp(int(glm::sqrt(float(object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_maxChunkRays))), 5, 1024);
+			ImGui::SliderInt("Ray Count", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_ghostGeometryParameters.m_rayCount, 5, maxFitRayCount); polynomialParamsChanged |= ImGui::IsItemDeactivatedAfterChange();
 			ImGui::SliderInt("Number of Channels", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_ghostGeometryParameters.m_numChannels, 1, 3); polynomialParamsChanged |= ImGui::IsItemDeactivatedAfterChange();
+			polynomialParamsChanged |= ImGui::Checkbox("Fit Zoom Range", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_ghostGeometryParameters.m_fitZoomRange);
 			ImGui::SliderInt("First Ghost", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_ghostGeometryParameters.m_firstGhost, 0, numGhosts - 1); polynomialParamsChanged |= ImGui::IsItemDeactivatedAfterChange();
 			ImGui::SliderInt("Number of Ghosts", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_ghostGeometryParameters.m_numGhost, 1, numGhosts); polynomialParamsChanged |= ImGui::IsItemDeactivatedAfterChange();
 			ImGui::SliderInt("Number of Angles", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_ghostGeometryParameters.m_numAngles, 0, 181); polynomialParamsChanged |= ImGui::IsItemDeactivatedAfterChange();
@@ -8041,6 +10146,8 @@ namespace TiledLensFlare
 			polynomialParamsChanged |= ImGui::Checkbox("Share Neighbors", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_ghostGeometryParameters.m_shareNeighboringGeometries);
 			ImGui::SameLine();
 			polynomialParamsChanged |= ImGui::Checkbox("Smoothen Data", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_ghostGeometryParameters.m_smoothenData);
+			ImGui::SameLine();
+			polynomialParamsChanged |= ImGui::Checkbox("Half Precision Storage", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_ghostGeometryParameters.m_halfPrecisionStorage);
 
 			ImGui::Separator();
 
@@ -8066,6 +10173,10 @@ namespace TiledLensFlare
 			ImGui::SameLine();
 			shaderChanged |= ImGui::Checkbox("Groupshared Memory", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_useGroupSharedMemory);
 			ImGui::Checkbox("Eval Entries in Parallel", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_evaluateEntriesInParallel);
+			ImGui::SameLine();
+			ImGui::Checkbox("Reuse Ghost Fits", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_reuseGhostFits);
+			ImGui::DragInt("Random Seed", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_randomSeed);
+			polynomialParamsChanged |= ImGui::IsItemDeactivatedAfterChange();
 
 			ImGui::Separator();
 
@@ -8082,6 +10193,21 @@ namespace TiledLensFlare
 				ImGui::SliderInt("Max Depth", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_polynomialRegressionParams.m_recursionDepth, 1, 32); polynomialParamsChanged |= ImGui::IsItemDeactivatedAfterChange();
 				ImGui::SliderInt("Simplifcation Threshold", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_polynomialRegressionParams.m_simplificationThreshold, 1, 32);
 				ImGui::Checkbox("Fixed Term Number", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_polynomialRegressionParams.m_fixedTermNumber);
+				ImGui::SliderFloat("Validation Ratio", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_polynomialRegressionParams.m_validationRatio, 0.0f, 0.5f); polynomialParamsChanged |= ImGui::IsItemDeactivatedAfterChange();
+				ImGui::SliderInt("Validation Patience", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_polynomialRegressionParams.m_validationPatience, 1, 16); polynomialParamsChanged |= ImGui::IsItemDeactivatedAfterChange();
+			}
+			if (object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_fitMethod == PolynomialFitParameters::FitMethod::SparseRegression)
+			{
+				ImGui::SliderInt("Num Samples", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_sparseRegressionParams.m_numSamples, 1, 10000); polynomialParamsChanged |= ImGui::IsItemDeactivatedAfterChange();
+				polynomialParamsChanged |= ImGui::Combo("Selection Method", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_sparseRegressionParams.m_selectionMethod,
+					PolynomialFitParameters::SparseSelectionMethod_meta);
+				if (object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_sparseRegressionParams.m_selectionMethod == PolynomialFitParameters::SparseSelectionMethod::Lasso)
+				{
+					ImGui::SliderInt("Path Steps", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_sparseRegressionParams.m_lassoPathSteps, 1, 1000); polynomialParamsChanged |= ImGui::IsItemDeactivatedAfterChange();
+					ImGui::SliderFloat("Path Decay", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_sparseRegressionParams.m_lassoPathDecay, 0.5f, 1.0f); polynomialParamsChanged |= ImGui::IsItemDeactivatedAfterChange();
+					ImGui::SliderInt("Max Sweeps", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_sparseRegressionParams.m_lassoMaxSweeps, 1, 1000); polynomialParamsChanged |= ImGui::IsItemDeactivatedAfterChange();
+					ImGui::SliderFloat("Tolerance", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_sparseRegressionParams.m_lassoTolerance, 0.0f, 1e-2f, "%.8f"); polynomialParamsChanged |= ImGui::IsItemDeactivatedAfterChange();
+				}
 			}
 
 			ImGui::Combo("Debug Level", &object->component<TiledLensFlareComponent>().m_polynomialFitParameters.m_debugComputation,
@@ -8121,6 +10247,7 @@ namespace TiledLensFlare
 			{
 				DelayedJobs::postJob(scene, object, "Fit Full Polynomials", [](Scene::Scene& scene, Scene::Object& object)
 				{
+					updateCameraData(scene, &object);
 					PolynomialsFull::performFit(scene, &object);
 				});
 			}
@@ -8131,6 +10258,7 @@ namespace TiledLensFlare
 			{
 				DelayedJobs::postJob(scene, object, "Fit Partial Polynomials", [](Scene::Scene& scene, Scene::Object& object)
 				{
+					updateCameraData(scene, &object);
 					PolynomialsPartial::performFit(scene, &object);
 				});
 			}
@@ -8142,11 +10270,18 @@ namespace TiledLensFlare
 		// Precompute settings
 		if (ImGui::BeginTabItem("Precompute", activeTab.c_str()))
 		{
-			precomputeParamsChanged |= ImGui::SliderInt("Ray Count", &object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_rayCount, 5, 513);
+			precomputeParamsChanged |= ImGui::SliderInt("Ray Count", &object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_rayCount, 5, 8193);
+			precomputeParamsChanged |= ImGui::DragInt("Max Chunk Rays", &object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_maxChunkRays, 1024.0f, 1024, 1 << 26);
 			precomputeParamsChanged |= ImGui::SliderInt("Refinement Steps", &object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_refinementSteps, 0, 5);
 			precomputeParamsChanged |= ImGui::SliderInt("Number of Channels", &object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_numChannels, 1, 3);
 			precomputeParamsChanged |= ImGui::SliderInt("First Ghost", &object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_firstGhost, 0, numGhosts - 1);
 			precomputeParamsChanged |= ImGui::SliderInt("Number of Ghosts", &object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_numGhost, 1, numGhosts);
+			cameraChanged |= ImGui::Checkbox("Prune Ghosts", &object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_pruneGhosts);
+			if (object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_pruneGhosts)
+			{
+				ImGui::SliderFloat("Prune Threshold", &object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_pruneThreshold, 0.0f, 1.0f, "%.6f", ImGuiSliderFlags_Logarithmic); cameraChanged |= ImGui::IsItemDeactivatedAfterChange();
+				ImGui::SliderInt("Ghost Budget", &object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_ghostBudget, 0, PhysicalCamera::getNumGhosts(object->component<TiledLensFlareComponent>().m_camera)); cameraChanged |= ImGui::IsItemDeactivatedAfterChange();
+			}
 			precomputeParamsChanged |= ImGui::SliderAngle("Max Angle", &object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_maxAngle, 0.0f, 90.0f);
 			precomputeParamsChanged |= ImGui::SliderAngle("Angle Step", &object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_angleStep, 0.0f, 1.0f, "%.2f deg");
 			precomputeParamsChanged |= ImGui::SliderFloat("Pupil Expansion", &object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_pupilExpansion, 0.0f, 2.0f);
@@ -8166,6 +10301,8 @@ namespace TiledLensFlare
 			ImGui::Checkbox("Compute Ghost Attribs", &object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_computeGhostAttribs);
 			ImGui::SameLine();
 			ImGui::Checkbox("Save Ghost Attribs", &object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_saveGhostAttribs);
+			ImGui::SameLine();
+			ImGui::Checkbox("Reuse Ghost Attribs", &object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_reuseGhostAttribs);
 
 			ImGui::Checkbox("Save Full Geometry", &object->component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_saveFullGhostGeometry);
 			ImGui::SameLine();
@@ -8177,6 +10314,7 @@ namespace TiledLensFlare
 			{
 				DelayedJobs::postJob(scene, object, "Compute Ghost Attribs", [](Scene::Scene& scene, Scene::Object& object)
 				{
+					updateCameraData(scene, &object);
 					GhostAttribs::computeAllGhostAttribs(scene, &object);
 				});
 			}
@@ -8212,6 +10350,9 @@ namespace TiledLensFlare
 		// End the tab bar
 		ImGui::EndTabBar();
 
+		// Refresh the ghost list before any job that depends on it runs
+		object->component<TiledLensFlareComponent>().m_cameraChanged |= cameraChanged;
+
 		if (shaderChanged || polynomialParamsChanged)
 		{
 			DelayedJobs::postJob(scene, object, "Reload Shaders", [](Scene::Scene& scene, Scene::Object& object)
@@ -8224,6 +10365,7 @@ namespace TiledLensFlare
 		{
 			DelayedJobs::postJob(scene, object, "Update Buffers", [](Scene::Scene& scene, Scene::Object& object)
 			{
+				updateCameraData(scene, &object);
 				InitResources::updateGPUBuffers(scene, &object);
 			});
 		}
@@ -8295,6 +10437,111 @@ namespace TiledLensFlare
 		RenderSettings::renderFullscreenPlaneOpenGL(scene, simulationSettings, renderSettings);
 	}
 
+	////////////////////////////////////////////////////////////////////////////////
+	namespace CpuBlur
+	{
+		// Number of image rows processed by a single work item
+		static constexpr int s_rowsPerWorkItem = 16;
+
+		////////////////////////////////////////////////////////////////////////////////
+		int getKernelRadius(std::vector<glm::vec2> const& kernel)
+		{
+			int radius = 0;
+			for (auto const& tap : kernel)
+				radius = glm::max(radius, int(glm::abs(tap.y)));
+			return radius;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// Each row is copied into a buffer padded with the clamped edge texels, after which
+		// every tap is a single vectorized multiply-add over the entire (interleaved) row.
+		void blurRows(float const* src, float* dst, const glm::ivec2 resolution, const int numChannels, std::vector<glm::vec2> const& kernel)
+		{
+			const int radius = getKernelRadius(kernel);
+			const Eigen::Index rowLength = Eigen::Index(resolution.x) * numChannels;
+			const size_t numWorkItems = (resolution.y + s_rowsPerWorkItem - 1) / s_rowsPerWorkItem;
+
+			Threading::threadedExecuteIndices(Threading::numThreads(),
+				[&](Threading::ThreadedExecuteEnvironment const& environment, const size_t workItemID)
+				{
+					Eigen::ArrayXf paddedRow(rowLength + 2 * radius * numChannels);
+
+					const int firstRow = int(workItemID) * s_rowsPerWorkItem;
+					const int lastRow = glm::min(firstRow + s_rowsPerWorkItem, resolution.y);
+					for (int y = firstRow; y < lastRow; ++y)
+					{
+						Eigen::Map<const Eigen::ArrayXf> srcRow(src + y * rowLength, rowLength);
+						Eigen::Map<Eigen::ArrayXf> dstRow(dst + y * rowLength, rowLength);
+
+						// Pad the row with the edge texels
+						paddedRow.segment(radius * numChannels, rowLength) = srcRow;
+						for (int x = 0; x < radius; ++x)
+						{
+							paddedRow.segment(x * numChannels, numChannels) = srcRow.head(numChannels);
+							paddedRow.segment((radius + resolution.x + x) * numChannels, numChannels) = srcRow.tail(numChannels);
+						}
+
+						// Accumulate the taps
+						dstRow.setZero();
+						for (auto const& tap : kernel)
+							dstRow += tap.x * paddedRow.segment((radius + int(tap.y)) * numChannels, rowLength);
+					}
+				},
+				numWorkItems);
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		// The vertical pass is evaluated one output row at a time, with each tap accumulating an
+		// entire source row; this keeps the memory accesses contiguous and the inner loop vectorized.
+		void blurColumns(float const* src, float* dst, const glm::ivec2 resolution, const int numChannels, std::vector<glm::vec2> const& kernel)
+		{
+			const Eigen::Index rowLength = Eigen::Index(resolution.x) * numChannels;
+			const size_t numWorkItems = (resolution.y + s_rowsPerWorkItem - 1) / s_rowsPerWorkItem;
+
+			Threading::threadedExecuteIndices(Threading::numThreads(),
+				[&](Threading::ThreadedExecuteEnvironment const& environment, const size_t workItemID)
+				{
+					const int firstRow = int(workItemID) * s_rowsPerWorkItem;
+					const int lastRow = glm::min(firstRow + s_rowsPerWorkItem, resolution.y);
+					for (int y = firstRow; y < lastRow; ++y)
+					{
+						Eigen::Map<Eigen::ArrayXf> dstRow(dst + y * rowLength, rowLength);
+
+						dstRow.setZero();
+						for (auto const& tap : kernel)
+						{
+							const int sourceRow = glm::clamp(y + int(tap.y), 0, resolution.y - 1);
+							dstRow += tap.x * Eigen::Map<const Eigen::ArrayXf>(src + sourceRow * rowLength, rowLength);
+						}
+					}
+				},
+				numWorkItems);
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		void blurImage(float* pixels, const glm::ivec2 resolution, const int numChannels, std::vector<glm::vec2> const& kernel)
+		{
+			if (kernel.size() <= 1 || resolution.x <= 0 || resolution.y <= 0)
+				return;
+
+			std::vector<float> intermediate(size_t(resolution.x) * size_t(resolution.y) * size_t(numChannels));
+			blurRows(pixels, intermediate.data(), resolution, numChannels, kernel);
+			blurColumns(intermediate.data(), pixels, resolution, numChannels, kernel);
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	void blurResultCpu(Scene::Scene& scene, Scene::Object* object, float* pixels, const glm::ivec2 resolution, const int numChannels)
+	{
+		if (!Common::needsBlurring(scene, object))
+			return;
+
+		DateTime::ScopedTimer timer = DateTime::ScopedTimer(Debug::Debug, 1, DateTime::Milliseconds, "CPU Blur");
+
+		// The linear kernel relies on bilinear texture filtering, so the CPU passes use the discrete taps
+		CpuBlur::blurImage(pixels, resolution, numChannels, object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_blurKernelDiscrete);
+	}
+
 	////////////////////////////////////////////////////////////////////////////////
 	void blurResult(Scene::Scene& scene, Scene::Object* simulationSettings, Scene::Object* renderSettings, Scene::Object* camera, Scene::Object* object)
 	{
@@ -8382,6 +10629,60 @@ namespace TiledLensFlare
 		}
 	}
 
+	////////////////////////////////////////////////////////////////////////////////
+	// Adds the aperture diffraction pattern around the image of each light, on top of the resolved ghosts
+	void renderStarburst(Scene::Scene& scene, Scene::Object* simulationSettings, Scene::Object* renderSettings, Scene::Object* camera, Scene::Object* object)
+	{
+		if (!object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_renderStarburst)
+			return;
+
+		Profiler::ScopedGpuPerfCounter perfCounter(scene, "Starburst");
+
+		// Render and max resolutions
+		const glm::ivec2 finalResolution = Common::computeFinalResolution(scene, object);
+
+		// Set the OpenGL state
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_ONE, GL_ONE);
+		glDisable(GL_DEPTH_TEST);
+		glDisable(GL_CULL_FACE);
+		glBindVertexArray(scene.m_meshes["plane.obj"].m_vao);
+
+		// Bind the diffraction texture
+		glActiveTexture(GPU::TextureEnums::TEXTURE_POST_PROCESS_2_ENUM);
+		glBindTexture(GL_TEXTURE_2D, scene.m_textures[object->component<TiledLensFlareComponent>().m_camera.m_apertureFFT].m_texture);
+
+		// Bind the output buffer
+		glBindFramebuffer(GL_FRAMEBUFFER, scene.m_gbuffer[renderSettings->component<RenderSettings::RenderSettingsComponent>().m_gbufferWrite].m_colorBuffersPerLayer[scene.m_gbuffer[renderSettings->component<RenderSettings::RenderSettingsComponent>().m_gbufferWrite].m_readBuffer][0]);
+		glViewport(0, 0, finalResolution.x, finalResolution.y);
+
+		// Bind the starburst shader
+		Scene::bindShader(scene, "RayTraceLensFlare/render_starburst");
+
+		// Size of the quad in NDC
+		const float starburstSize = object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_starburstSize;
+		const glm::vec2 halfSize = glm::vec2(starburstSize * float(finalResolution.y) / float(finalResolution.x), starburstSize);
+		glUniform2fv(1, 1, glm::value_ptr(halfSize));
+
+		// Render the starburst of each light source that is in front of the camera
+		const glm::mat4 projection = Camera::getProjectionMatrix(renderSettings, camera);
+		for (auto const& lightData : LightSources::getLightSourceData(scene, renderSettings, camera, object))
+		{
+			const glm::vec4 lightPosClip = projection * glm::vec4(lightData.m_toLight, 0.0f);
+			if (lightPosClip.w <= 0.0f) continue;
+
+			const glm::vec2 center = glm::vec2(lightPosClip) / lightPosClip.w;
+			const glm::vec3 color = lightData.m_lightColor * object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_starburstIntensity;
+			glUniform2fv(0, 1, glm::value_ptr(center));
+			glUniform3fv(2, 1, glm::value_ptr(color));
+
+			glDrawArrays(GL_TRIANGLES, 0, 6);
+		}
+
+		// Reset the OpenGL state
+		glBindVertexArray(0);
+	}
+
 	////////////////////////////////////////////////////////////////////////////////
 	void renderObjectOpenGLDirect(Scene::Scene& scene, Scene::Object* simulationSettings, Scene::Object* renderSettings, Scene::Object* camera, std::string const& functionName, Scene::Object* object)
 	{
@@ -8435,8 +10736,10 @@ namespace TiledLensFlare
 
 		// Render lens flare for each light source
 		std::vector<LightSources::LightSourceData> lightSources = LightSources::getLightSourceData(scene, renderSettings, camera, object);
-		for (LightSources::LightSourceData const& lightData : lightSources)
+		const Uniforms::LightUniformsRender lightUniforms = Uniforms::prepareLightUniformsRender(scene, object, lightSources);
+		for (size_t lightID = 0; lightID < lightSources.size(); ++lightID)
 		{
+			LightSources::LightSourceData const& lightData = lightSources[lightID];
 			Profiler::ScopedGpuPerfCounter perfCounter(scene, lightData.m_lightSource->m_name);
 
 			//Debug::log_debug() << lightData.m_lightSource->m_name << ": "
@@ -8444,19 +10747,19 @@ namespace TiledLensFlare
 			//	<< "rotation: " << lightData.m_rotation << " rad (" << glm::degrees(lightData.m_rotation) << ")" << Debug::end;
 
 			// Upload the common parameters
-			std::vector<Uniforms::GhostParams> ghostParams = Uniforms::uploadGhostParametersRender(scene, object, lightData);
-			uploadBufferData(scene, "TiledLensFlareTracedGhostParams", ghostParams);
+			const size_t numGhostParams = lightUniforms.getNumGhostParams(lightID);
+			uploadBufferData(scene, "TiledLensFlareTracedGhostParams", numGhostParams * sizeof(Uniforms::GhostParams), lightUniforms.getGhostParams(lightID));
 
-			Uniforms::RenderGhostsLensUniforms lensFlareDataLens = Uniforms::uploadLensUniformsRender(scene, object, lightData);
+			Uniforms::RenderGhostsLensUniforms const& lensFlareDataLens = lightUniforms.m_lensUniforms[lightID];
 			uploadBufferData(scene, "TiledLensFlareLens", lensFlareDataLens);
 
-			Uniforms::RenderGhostsCommonUniforms lensFlareDataCommon = Uniforms::uploadCommonUniformsRender(scene, object, ghostParams);
+			Uniforms::RenderGhostsCommonUniforms const& lensFlareDataCommon = lightUniforms.m_commonUniforms[lightID];
 			uploadBufferData(scene, "TiledLensFlareCommon", lensFlareDataCommon);
 
 			Uniforms::RenderGhostsCommonUniformsDirect lensFlareDataCommonDirect = Uniforms::uploadCommonUniformsRenderDirect(scene, object);
 			uploadBufferData(scene, "TiledLensFlareCommonDirect", lensFlareDataCommonDirect);
 
-			Profiler::storeData(scene, { "No. Ghosts" }, (int)ghostParams.size());
+			Profiler::storeData(scene, { "No. Ghosts" }, (int)numGhostParams);
 
 			if ((object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_raytraceMethod == RenderGhostsParameters::PolynomialFullFit ||
 				object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_raytraceMethod == RenderGhostsParameters::PolynomialPartialFit) &&
@@ -8484,7 +10787,7 @@ namespace TiledLensFlare
 
 				// Dispatch the computation
 				const int maxRayCount = lensFlareDataCommon.m_maxRayGridSize;
-				glm::ivec3 numWorkGroups = Common::getNumWorkGroups(glm::ivec3(8, 8, 1), glm::ivec3(maxRayCount, maxRayCount, ghostParams.size()));
+				glm::ivec3 numWorkGroups = Common::getNumWorkGroups(glm::ivec3(8, 8, 1), glm::ivec3(maxRayCount, maxRayCount, numGhostParams));
 				glDispatchCompute(numWorkGroups.x, numWorkGroups.y, numWorkGroups.z);
 
 				glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
@@ -8497,7 +10800,7 @@ namespace TiledLensFlare
 				// Bind the ghost rendering shader
 				Scene::bindShader(scene, "RayTraceLensFlare/render_ghosts");
 
-				for (size_t ghostID = 0; ghostID < ghostParams.size(); ++ghostID)
+				for (size_t ghostID = 0; ghostID < numGhostParams; ++ghostID)
 				{
 					Profiler::ScopedGpuPerfCounter perfCounter(scene, "Ghost #" + std::to_string(ghostID));
 
@@ -8505,7 +10808,7 @@ namespace TiledLensFlare
 					glUniform1i(0, ghostID);
 
 					// Render the tessellated quad
-					int rayCount = ghostParams[ghostID].m_rayCount;
+					int rayCount = lightUniforms.getGhostParams(lightID)[ghostID].m_rayCount;
 					int vertexCount = (rayCount - 1) * (rayCount - 1) * 6;
 					glDrawArrays(GL_TRIANGLES, 0, vertexCount);
 				}
@@ -8527,6 +10830,9 @@ namespace TiledLensFlare
 			else
 				blitResult(scene, simulationSettings, renderSettings, camera, object);
 		}
+
+		// Add the starburst on top
+		renderStarburst(scene, simulationSettings, renderSettings, camera, object);
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -8600,8 +10906,10 @@ namespace TiledLensFlare
 
 		// Render lens flare for each light source
 		std::vector<LightSources::LightSourceData> lightSources = LightSources::getLightSourceData(scene, renderSettings, camera, object);
-		for (LightSources::LightSourceData const& lightData : lightSources)
+		const Uniforms::LightUniformsRender lightUniforms = Uniforms::prepareLightUniformsRender(scene, object, lightSources);
+		for (size_t lightID = 0; lightID < lightSources.size(); ++lightID)
 		{
+			LightSources::LightSourceData const& lightData = lightSources[lightID];
 			Profiler::ScopedGpuPerfCounter perfCounter(scene, lightData.m_lightSource->m_name);
 
 			//Debug::log_debug() << lightData.m_lightSource->m_name << ": "
@@ -8609,13 +10917,13 @@ namespace TiledLensFlare
 			//	<< "rotation: " << lightData.m_rotation << " rad (" << glm::degrees(lightData.m_rotation) << ")" << Debug::end;
 
 			// Upload the common parameters
-			std::vector<Uniforms::GhostParams> ghostParams = Uniforms::uploadGhostParametersRender(scene, object, lightData);
-			uploadBufferData(scene, "TiledLensFlareTracedGhostParams", ghostParams);
+			const size_t numGhostParams = lightUniforms.getNumGhostParams(lightID);
+			uploadBufferData(scene, "TiledLensFlareTracedGhostParams", numGhostParams * sizeof(Uniforms::GhostParams), lightUniforms.getGhostParams(lightID));
 
-			Uniforms::RenderGhostsLensUniforms lensFlareDataLens = Uniforms::uploadLensUniformsRender(scene, object, lightData);
+			Uniforms::RenderGhostsLensUniforms const& lensFlareDataLens = lightUniforms.m_lensUniforms[lightID];
 			uploadBufferData(scene, "TiledLensFlareLens", lensFlareDataLens);
 
-			Uniforms::RenderGhostsCommonUniforms lensFlareDataCommon = Uniforms::uploadCommonUniformsRender(scene, object, ghostParams);
+			Uniforms::RenderGhostsCommonUniforms const& lensFlareDataCommon = lightUniforms.m_commonUniforms[lightID];
 			uploadBufferData(scene, "TiledLensFlareCommon", lensFlareDataCommon);
 
 
@@ -8648,13 +10956,13 @@ namespace TiledLensFlare
 				// Dispatch the computation
 				const int maxRayCount = lensFlareDataCommon.m_maxRayGridSize;
 				const int groupSize = object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_traceRaysGroupSize;
-				glm::ivec3 numWorkGroups = Common::getNumWorkGroups(glm::ivec3(groupSize - 1, groupSize - 1, 1), glm::ivec3(maxRayCount, maxRayCount, ghostParams.size()));
+				glm::ivec3 numWorkGroups = Common::getNumWorkGroups(glm::ivec3(groupSize - 1, groupSize - 1, 1), glm::ivec3(maxRayCount, maxRayCount, numGhostParams));
 				glDispatchCompute(numWorkGroups.x, numWorkGroups.y, numWorkGroups.z);
 
 				glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
 			}
 
-			Profiler::storeData(scene, { "No. Ghosts" }, (int)ghostParams.size());
+			Profiler::storeData(scene, { "No. Ghosts" }, (int)numGhostParams);
 		}
 
 		{
@@ -8709,6 +11017,9 @@ namespace TiledLensFlare
 			RenderSettings::swapGbufferBuffers(scene, simulationSettings, renderSettings);
 		}
 
+		// Add the starburst on top
+		renderStarburst(scene, simulationSettings, renderSettings, camera, object);
+
 		// Read back statistics
 		if (object->component<TiledLensFlareComponent>().m_renderGhostsParameters.m_readBackStatistics)
 		{
@@ -8785,16 +11096,22 @@ namespace TiledLensFlare
 
 				// Common settings
 				object.component<TiledLensFlareComponent>().m_commonParameters.m_physicalPupilSizeMethod = CommonParameters::PhysicalPupilSizeMethod::ParaxialTracedPupil;
+				object.component<TiledLensFlareComponent>().m_commonParameters.m_hotReloadGhostData = true;
+				object.component<TiledLensFlareComponent>().m_commonParameters.m_hotReloadInterval = 2.0f;
 
 				// Camera
 				object.component<TiledLensFlareComponent>().m_camera.m_name = "heliar-tronnier";
 
 				// Precompute parameters
 				object.component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_rayCount = 1024;
+				object.component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_maxChunkRays = 1 << 20;
 				object.component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_refinementSteps = 0;
 				object.component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_numChannels = 3;
 				object.component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_firstGhost = 0;
 				object.component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_numGhost = 999;
+				object.component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_pruneGhosts = false;
+				object.component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_pruneThreshold = 1e-3f;
+				object.component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_ghostBudget = 0;
 				object.component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_maxAngle = glm::radians(60.0f);
 				object.component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_angleStep = glm::radians(0.5f);
 				object.component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_pupilExpansion = 1.0f;
@@ -8807,8 +11124,9 @@ namespace TiledLensFlare
 				object.component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_slackRays = 0.0f;
 				object.component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_terminateOnFirstInvalid = true;
 				object.component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_clipSensor = true;
-				object.component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_computeGhostAttribs = true;
+				object.component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_computeGhostAttribs = false;
 				object.component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_saveGhostAttribs = true;
+				object.component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_reuseGhostAttribs = true;
 				object.component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_saveFullGhostGeometry = false;
 				object.component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_saveValidGhostGeometry = false;
 				object.component<TiledLensFlareComponent>().m_precomputeGhostsParameters.m_saveBoundedGhostGeometry = false;
@@ -8831,6 +11149,11 @@ namespace TiledLensFlare
 				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_rayCount = 128;
 				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_rayCountReductionScale = 1.0f;
 				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_rayCountReductionPower = 0.5f;
+				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_rayCountFootprintDensity = 0.5f;
+				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_rayCountFullIntensity = 0.01f;
+				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_rayCountIntensityPower = 0.25f;
+				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_minRayCount = 8;
+				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_rayBudget = 4 << 20;
 				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_numQuadMergeSteps = 4;
 				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_quadMergeEdgeThreshold = 0.0005;
 				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_clipRays = true;
@@ -8849,11 +11172,17 @@ namespace TiledLensFlare
 				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_refractionClipping = glm::radians(180.0f);
 				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_clipSensor = true;
 				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_filmStretch = 1.0f;
+				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_renderStarburst = false;
+				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_starburstSize = 0.5f;
+				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_starburstIntensity = 1.0f;
 				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_resolutionScaling = 1.0f;
 				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_lockAngle = false;
 				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_lockRotation = false;
 				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_fixedAngle = glm::radians(0.0f);
 				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_fixedRotation = glm::radians(0.0f);
+				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_reuseGhostParams = true;
+				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_ghostParamsAngleTolerance = glm::radians(0.01f);
+				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_ghostParamsLambertTolerance = 1e-4f;
 
 				// Tile sizes and other parameters
 				object.component<TiledLensFlareComponent>().m_renderGhostsParameters.m_tileSize = 8;
@@ -8874,9 +11203,12 @@ namespace TiledLensFlare
 				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_useDynamicTermCount = true;
 				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_useGroupSharedMemory = true;
 				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_evaluateEntriesInParallel = false;
+				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_randomSeed = 0;
+				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_reuseGhostFits = true;
 				//  - ghost geometry
 				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_ghostGeometryParameters.m_rayCount = 80;
 				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_ghostGeometryParameters.m_numChannels = 3;
+				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_ghostGeometryParameters.m_fitZoomRange = false;
 				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_ghostGeometryParameters.m_firstGhost = 0;
 				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_ghostGeometryParameters.m_numGhost = 999;
 				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_ghostGeometryParameters.m_numAngles = 241;
@@ -8901,6 +11233,7 @@ namespace TiledLensFlare
 				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_ghostGeometryParameters.m_validSampleRatio = 0.5f;
 				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_ghostGeometryParameters.m_smoothenData = false;
 				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_ghostGeometryParameters.m_shareNeighboringGeometries = false;
+				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_ghostGeometryParameters.m_halfPrecisionStorage = false;
 				//  - common fitting
 				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_fitMethod = PolynomialFitParameters::FitMethod::PolynomialRegression;
 				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_denseFitLinearMethod = PolynomialFitParameters::DenseFitLinearMethod::LDLT;
@@ -8927,6 +11260,8 @@ namespace TiledLensFlare
 				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_polynomialRegressionParams.m_recursionDepth = 5;
 				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_polynomialRegressionParams.m_fixedTermNumber = false;
 				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_polynomialRegressionParams.m_simplificationThreshold = 1;
+				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_polynomialRegressionParams.m_validationRatio = 0.0f;
+				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_polynomialRegressionParams.m_validationPatience = 3;
 				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_polynomialRegressionParams.m_outputVariableParams =
 				{
 					//                    expErrThr, expErrDec, simplErrInc, stopErrDecThr, stopErrThr
@@ -8938,6 +11273,13 @@ namespace TiledLensFlare
 					{ "clip_factor",    { 0.0f,      2e-5f,     -1e-5f,      5e-6f,          5e-6f } },
 					{ "intensity",      { 0.0f,      2e-7f,     -1e-7f,      1e-8f,          1e-8f } },
 				};
+				//  - sparse regression
+				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_sparseRegressionParams.m_numSamples = 3200;
+				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_sparseRegressionParams.m_selectionMethod = PolynomialFitParameters::SparseSelectionMethod::OrthogonalMatchingPursuit;
+				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_sparseRegressionParams.m_lassoPathSteps = 100;
+				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_sparseRegressionParams.m_lassoPathDecay = 0.9f;
+				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_sparseRegressionParams.m_lassoMaxSweeps = 100;
+				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_sparseRegressionParams.m_lassoTolerance = 1e-6f;
 				//  - simulated annealing
 				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_annealingParams.m_numSamples = 3200;
 				object.component<TiledLensFlareComponent>().m_polynomialFitParameters.m_annealingParams.m_numIterations = 10000;
@@ -32,6 +32,12 @@ namespace TiledLensFlare
 
 		// List of ghosts to ignore for each optical system
 		std::unordered_map<std::string, std::vector<int>> m_ignoredGhosts;
+
+		// Whether the ghost attribute and polynomial weight files should be reloaded when they change on disk
+		bool m_hotReloadGhostData;
+
+		// How often (in seconds) the watched files are checked for changes
+		float m_hotReloadInterval;
 	};
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -44,7 +50,7 @@ namespace TiledLensFlare
 		meta_enum(ShadingMethod, int, Shaded, Uncolored, Unshaded, PupilCoords, SensorCoords, UVCoords, RelativeRadius, ApertureDist, ClipFactor, Validity);
 		meta_enum(OverlayMethod, int, DisableOverlay, TractabilityOverlay, ValidityOverlay, SensorBoundsOverlay);
 		meta_enum(GridMethod, int, FixedGrid, AdaptiveGrid);
-		meta_enum(RayCountMethod, int, FixedCount, DynamicSensorSizeBased);
+		meta_enum(RayCountMethod, int, FixedCount, DynamicSensorSizeBased, DynamicFootprintBased);
 		meta_enum(RenderMethod, int, Direct, Tiled);
 		meta_enum(RaytraceMethod, int, Analytical, PolynomialFullFit, PolynomialPartialFit);
 		meta_enum(IntensityMethod, int, DynamicIntensity, FixedIntensity);
@@ -80,6 +86,14 @@ namespace TiledLensFlare
 		float m_rayCountReductionScale;
 		float m_rayCountReductionPower;
 
+		// Footprint-based ray count parameters: rays per pixel along the footprint edge, the average intensity
+		// that receives the full density, the falloff below it, the smallest grid and the total rays per frame (0 = unlimited)
+		float m_rayCountFootprintDensity;
+		float m_rayCountFullIntensity;
+		float m_rayCountIntensityPower;
+		int m_minRayCount;
+		int m_rayBudget;
+
 		// First and last ghosts to render
 		int m_firstGhost;
 		int m_numGhost;
@@ -105,6 +119,11 @@ namespace TiledLensFlare
 		// Film stretch factor
 		float m_filmStretch;
 
+		// Starburst around each light, rendered from the aperture diffraction (FFT) texture; the size is relative to the screen height
+		bool m_renderStarburst;
+		float m_starburstSize;
+		float m_starburstIntensity;
+
 		// Resolution scale factor to apply to the intermediate buffer
 		float m_resolutionScaling;
 
@@ -150,6 +169,15 @@ namespace TiledLensFlare
 		float m_fixedAngle = 0.0f;
 		float m_fixedRotation = 0.0f;
 
+		// Whether the ghost parameters of a light should be kept from the previous frame, if it barely moved
+		bool m_reuseGhostParams;
+
+		// Largest change in the incident angle and rotation of a light that still allows reusing its ghost parameters
+		float m_ghostParamsAngleTolerance;
+
+		// Largest change in the lambertian factor of a light that still allows reusing its ghost parameters
+		float m_ghostParamsLambertTolerance;
+
 		// ---- Private members
 		std::vector<glm::vec2> m_blurKernelLinear;
 		std::vector<glm::vec2> m_blurKernelDiscrete;
@@ -161,6 +189,9 @@ namespace TiledLensFlare
 		// Number of rays used
 		int m_rayCount;
 
+		// Maximum number of rays traced and kept in memory at once
+		int m_maxChunkRays;
+
 		// Angle of incidence sampling
 		float m_maxAngle;
 		float m_angleStep;
@@ -172,6 +203,15 @@ namespace TiledLensFlare
 		int m_firstGhost;
 		int m_numGhost;
 
+		// Whether ghosts should be pruned based on their paraxial energy estimate
+		bool m_pruneGhosts;
+
+		// Minimum energy of the kept ghosts, relative to the brightest ghost
+		float m_pruneThreshold;
+
+		// Maximum number of ghosts to keep (0: no limit)
+		int m_ghostBudget;
+
 		// Clip factors
 		float m_radiusClipping;
 		float m_irisClipping;
@@ -195,12 +235,15 @@ namespace TiledLensFlare
 		// Whether we should terminate on the first invalid incidence angle or not
 		bool m_terminateOnFirstInvalid;
 
-		// Whether we want to compute the ghost attribs or not
+		// Whether we want to (re)compute all the ghost attribs or not
 		bool m_computeGhostAttribs;
 
 		// Whether we want to save the ghost attribs or not
 		bool m_saveGhostAttribs;
 
+		// Whether only the attribs missing for a ghost (by content hash) should be computed, reusing the existing ones
+		bool m_reuseGhostAttribs;
+
 		// Whether we want to also save the resulting ghost geometry or not
 		bool m_saveFullGhostGeometry;
 
@@ -214,7 +257,8 @@ namespace TiledLensFlare
 	////////////////////////////////////////////////////////////////////////////////
 	struct PolynomialFitParameters
 	{
-		meta_enum(FitMethod, int, SimulatedAnnealing, PolynomialRegression);
+		meta_enum(FitMethod, int, SimulatedAnnealing, PolynomialRegression, SparseRegression);
+		meta_enum(SparseSelectionMethod, int, OrthogonalMatchingPursuit, Lasso);
 		meta_enum(DenseFitLinearMethod, int, SkipLinear, BDCSVD, JacobiSVD, PartialPivLU, FullPivLU, ColPivHouseholderQr, FullPivHouseholderQr, LLT, LDLT, CompleteOrthogonalDecomposition);
 		meta_enum(DenseFitNonlinearMethod, int, SkipNonLinear, LevMar, HybridNonlinearSolver, GradientDescent, NAG, RMSProp, Adam, Nadam);
 		meta_enum(NonlinearFitFrequency, int, EveryIteration, AfterOptimization, Never);
@@ -242,6 +286,9 @@ namespace TiledLensFlare
 			// Number of light wavelengths
 			int m_numChannels;
 
+			// Whether the whole zoom range of the camera should be covered, using the zoom position as an input
+			bool m_fitZoomRange;
+
 			// First and number of ghosts to process
 			int m_firstGhost;
 			int m_numGhost;
@@ -278,6 +325,9 @@ namespace TiledLensFlare
 			// Whether the fitting data should be smoothened or not
 			bool m_smoothenData;
 
+			// Whether the precomputed geometry should be stored with half-precision attributes
+			bool m_halfPrecisionStorage;
+
 			// Whether zero-weighted variables should be included or not
 			bool m_includeZeroWeightedDataset;
 			bool m_includeZeroWeightedFit;
@@ -320,6 +370,12 @@ namespace TiledLensFlare
 		// Whether individual entries should be evaluated in parallel or not
 		bool m_evaluateEntriesInParallel;
 
+		// Seed of the random streams used by the fitting (subsampling, annealing)
+		int m_randomSeed;
+
+		// Whether per-ghost fits cached for an identical ghost (same content hash) should be reused or not
+		bool m_reuseGhostFits;
+
 		// Minimum and maximum extent of the coefficient values
 		glm::vec2 m_coefficientLimits;
 
@@ -384,6 +440,12 @@ namespace TiledLensFlare
 			// When to start looking for simplifications
 			int m_simplificationThreshold;
 
+			// Fraction of the subsampled samples held out for validation (0 disables it)
+			float m_validationRatio;
+
+			// Number of iterations without validation improvement before stopping
+			int m_validationPatience;
+
 			// Per-variable parameters for the output variables
 			struct OutputVariableParams
 			{
@@ -408,6 +470,24 @@ namespace TiledLensFlare
 
 		} m_polynomialRegressionParams;
 
+		// Sparse regression parameters
+		struct SparseRegressionParams
+		{
+			// Number of samples to use from the wholte dataset
+			int m_numSamples;
+
+			// How the terms are selected from the candidate dictionary
+			SparseSelectionMethod m_selectionMethod;
+
+			// Number of steps along the LASSO regularization path, and the penalty decay between consecutive steps
+			int m_lassoPathSteps;
+			float m_lassoPathDecay;
+
+			// Maximum number of coordinate descent sweeps per path step, and the coefficient change to stop at
+			int m_lassoMaxSweeps;
+			float m_lassoTolerance;
+		} m_sparseRegressionParams;
+
 		// Whether the computation should be debugged or not
 		DebugLevel m_debugComputation;
 	};
@@ -549,6 +629,14 @@ namespace TiledLensFlare
 		return ostream;
 	}
 
+	////////////////////////////////////////////////////////////////////////////////
+	/** Per-light ghost parameters retained between frames. */
+	struct GhostParamsCache;
+
+	////////////////////////////////////////////////////////////////////////////////
+	/** File watcher state for hot reloading the ghost data. */
+	struct GhostDataHotReload;
+
 	////////////////////////////////////////////////////////////////////////////////
 	/** A directional light component. */
 	struct TiledLensFlareComponent
@@ -576,6 +664,9 @@ namespace TiledLensFlare
 		// Resulting vector
 		std::vector<PhysicalCamera::GhostIndices> m_ghostIndices;
 
+		// Whether the camera changed since its derived data was last computed
+		bool m_cameraChanged = true;
+
 		// Ghost transfer matrices for matrix lens flare
 		std::vector<std::vector<std::vector<glm::mat2>>> m_transferMatrices;
 
@@ -587,6 +678,15 @@ namespace TiledLensFlare
 
 		// Number of polynomial terms for full fit
 		std::vector<size_t> m_numPolynomialTermsPartialFit;
+
+		// Incremented whenever the ghost attributes or the polynomial term counts change
+		size_t m_ghostDataVersion = 0;
+
+		// Ghost parameters of each light source from the previous frames
+		std::shared_ptr<GhostParamsCache> m_ghostParamsCache;
+
+		// Watched ghost data files and the pending background reload
+		std::shared_ptr<GhostDataHotReload> m_ghostDataHotReload;
 	};
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -601,6 +701,10 @@ namespace TiledLensFlare
 	////////////////////////////////////////////////////////////////////////////////
 	void generateGui(Scene::Scene& scene, Scene::Object* guiSettings, Scene::Object* object);
 
+	////////////////////////////////////////////////////////////////////////////////
+	/** Applies the flare blur to an interleaved float image in place on the CPU, using the same kernel as the GPU blur. */
+	void blurResultCpu(Scene::Scene& scene, Scene::Object* object, float* pixels, const glm::ivec2 resolution, const int numChannels);
+
 	////////////////////////////////////////////////////////////////////////////////
 	void renderObjectOpenGL(Scene::Scene& scene, Scene::Object* simulationSettings, Scene::Object* renderSettings, Scene::Object* camera, std::string const& functionName, Scene::Object* object);
 
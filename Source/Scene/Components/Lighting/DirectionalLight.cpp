@@ -19,6 +19,7 @@ namespace DirectionalLight
 		shaderParameters.m_defines =
 		{
 			"LIGHT_TYPE DIRECTIONAL",
+			"MAX_SHADOW_CASCADES " + std::to_string(ShadowMap::MAX_CASCADES),
 			"VOXEL_GBUFFER_TEXTURE_FORMAT " + RenderSettings::voxelGbufferGlShaderFormat(scene),
 			"VOXEL_RADIANCE_TEXTURE_FORMAT " + RenderSettings::voxelRadianceGlShaderFormat(scene)
 		};
@@ -126,18 +127,79 @@ namespace DirectionalLight
 		return result;
 	}
 
+	////////////////////////////////////////////////////////////////////////////////
+	void updateCascadedShadowMapSlices(Scene::Scene& scene, Scene::Object* object)
+	{
+		// Access the main camera
+		auto renderSettings = Scene::findFirstObject(scene, Scene::OBJECT_TYPE_RENDER_SETTINGS);
+		auto camera = renderSettings->component<RenderSettings::RenderSettingsComponent>().m_rendering.m_mainCamera;
+
+		// Collect the visible receivers and the casters, and distribute the splits based on them
+		auto const& geometry = ShadowMap::collectCascadeGeometry(scene, renderSettings, camera, object);
+		auto& splits = object->component<ShadowMap::ShadowMapComponent>().m_cascadeSplits;
+		splits = ShadowMap::computeCascadeSplits(scene, object, geometry);
+
+		// Create one slice per cascade, plus one covering the entire scene for the voxel radiance injection
+		const size_t numCascades = splits.size() - 1;
+		auto& slices = object->component<ShadowMap::ShadowMapComponent>().m_slices;
+		slices.resize(numCascades + 1);
+
+		// Configure the slices, laid out next to each other
+		const glm::ivec2 resolution = glm::ivec2(object->component<ShadowMap::ShadowMapComponent>().m_resolution);
+		const glm::vec3 direction = lightSourceDirection(scene, object);
+		for (size_t sliceId = 0; sliceId < numCascades; ++sliceId)
+		{
+			auto& slice = slices[sliceId];
+			slice.m_startCoords = glm::ivec2(sliceId, 0) * resolution;
+			slice.m_extents = resolution;
+
+			// The cascades follow the camera, so only re-render the slices that actually moved
+			const ShadowMap::ShadowMapTransform transform = ShadowMap::fitCascadeTransform(scene, object, geometry, direction, splits[sliceId], splits[sliceId + 1]);
+			if (transform.m_transform != slice.m_transform.m_transform) slice.m_needsUpdate = true;
+			slice.m_transform = transform;
+		}
+
+		// The scene slice only moves with the light or the scene bounds
+		auto& sceneSlice = slices[numCascades];
+		sceneSlice.m_startCoords = glm::ivec2(numCascades, 0) * resolution;
+		sceneSlice.m_extents = resolution;
+		const ShadowMap::ShadowMapTransform sceneTransform = lightSourceTransform(scene, object);
+		if (sceneTransform.m_transform != sceneSlice.m_transform.m_transform) sceneSlice.m_needsUpdate = true;
+		sceneSlice.m_transform = sceneTransform;
+	}
+
 	////////////////////////////////////////////////////////////////////////////////
 	void updateShadowMapSlices(Scene::Scene& scene, Scene::Object* object)
 	{
-		// Create the corrent number of slices
 		auto& slices = object->component<ShadowMap::ShadowMapComponent>().m_slices;
-		slices.resize(1);
+		const size_t previousNumSlices = slices.size();
 
-		// Configure the slices
-		auto& slice = slices.front();
-		slice.m_startCoords = glm::ivec2(0, 0);
-		slice.m_extents = glm::ivec2(object->component<ShadowMap::ShadowMapComponent>().m_resolution);
-		slice.m_transform = lightSourceTransform(scene, object);
+		// Fit the cascades to the camera, if possible
+		auto renderSettings = Scene::findFirstObject(scene, Scene::OBJECT_TYPE_RENDER_SETTINGS);
+		if (object->component<ShadowMap::ShadowMapComponent>().m_layout == ShadowMap::ShadowMapComponent::Cascaded &&
+			renderSettings->component<RenderSettings::RenderSettingsComponent>().m_rendering.m_mainCamera != nullptr)
+		{
+			updateCascadedShadowMapSlices(scene, object);
+		}
+		else
+		{
+			// Create the corrent number of slices
+			slices.resize(1);
+			object->component<ShadowMap::ShadowMapComponent>().m_cascadeSplits.clear();
+
+			// Configure the slices
+			auto& slice = slices.front();
+			slice.m_startCoords = glm::ivec2(0, 0);
+			slice.m_extents = glm::ivec2(object->component<ShadowMap::ShadowMapComponent>().m_resolution);
+			slice.m_transform = lightSourceTransform(scene, object);
+		}
+
+		// The shadow map atlas must be resized whenever the slices are added or removed
+		if (previousNumSlices != 0 && slices.size() != previousNumSlices)
+		{
+			updateShadowMapTexture(scene, object);
+			ShadowMap::regenerateShadowMap(scene, object);
+		}
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -164,6 +226,12 @@ namespace DirectionalLight
 		lightingChanged |= ImGui::DragFloat("Ambient Intensity", &object->component<DirectionalLight::DirectionalLightComponent>().m_ambientIntensity, 0.01f);
 		lightingChanged |= ImGui::DragFloat("Diffuse Intensity", &object->component<DirectionalLight::DirectionalLightComponent>().m_diffuseIntensity, 0.01f);
 		lightingChanged |= ImGui::DragFloat("Specular Intensity", &object->component<DirectionalLight::DirectionalLightComponent>().m_specularItensity, 0.01f);
+		bool cascaded = object->component<ShadowMap::ShadowMapComponent>().m_layout == ShadowMap::ShadowMapComponent::Cascaded;
+		if (ImGui::Checkbox("Cascaded Shadow Map", &cascaded))
+		{
+			object->component<ShadowMap::ShadowMapComponent>().m_layout = cascaded ? ShadowMap::ShadowMapComponent::Cascaded : ShadowMap::ShadowMapComponent::Traditional;
+			recreateShadowMap = true;
+		}
 		auto shadowMapChanged = ShadowMap::generateGui(scene, guiSettings, object);
 		recreateShadowMap |= shadowMapChanged[0];
 		refreshShadowMap |= shadowMapChanged[1];
@@ -183,7 +251,8 @@ namespace DirectionalLight
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
-	std::vector<UniformData> getLightBatches(Scene::Scene& scene, Scene::Object* renderSettings, Scene::Object* object)
+	// The voxel radiance injection covers the entire scene, so it only uses the scene slice and ignores the cascades
+	std::vector<UniformData> getLightBatches(Scene::Scene& scene, Scene::Object* renderSettings, Scene::Object* object, const bool voxelInjection = false)
 	{
 		// Uniform structure for holding the light source info
 		DirectionalLight::UniformData lightData;
@@ -195,6 +264,7 @@ namespace DirectionalLight
 		lightData.m_diffuseIntensity = object->component<DirectionalLight::DirectionalLightComponent>().m_diffuseIntensity;
 		lightData.m_specularIntensity = object->component<DirectionalLight::DirectionalLightComponent>().m_specularItensity;
 		lightData.m_castsShadow = castsShadow(renderSettings, object) ? 1.0f : 0.0f;
+		lightData.m_numCascades = 0;
 		if (castsShadow(renderSettings, object))
 		{
 			lightData.m_shadowAlgorithm = object->component<ShadowMap::ShadowMapComponent>().m_algorithm;
@@ -204,7 +274,23 @@ namespace DirectionalLight
 			lightData.m_shadowLightBleedBias = object->component<ShadowMap::ShadowMapComponent>().m_lightBleedBias;
 			lightData.m_shadowMomentsBias = object->component<ShadowMap::ShadowMapComponent>().m_momentsBias;
 			lightData.m_shadowExponentialConstants = object->component<ShadowMap::ShadowMapComponent>().m_exponentialConstants;
-			lightData.m_lightSpaceTransform = object->component<ShadowMap::ShadowMapComponent>().m_slices[0].m_transform.m_transform;
+
+			// The scene slice follows the cascades, if any
+			auto const& splits = object->component<ShadowMap::ShadowMapComponent>().m_cascadeSplits;
+			auto const& slices = object->component<ShadowMap::ShadowMapComponent>().m_slices;
+			const int numCascades = splits.empty() ? 0 : glm::min(int(slices.size()) - 1, ShadowMap::MAX_CASCADES);
+			auto const& sceneSlice = slices[numCascades];
+			lightData.m_lightSpaceTransform = sceneSlice.m_transform.m_transform;
+			lightData.m_lightSpaceUvTransform = numCascades > 0 ? glm::vec4(sceneSlice.m_textureOffset, sceneSlice.m_textureScale) : glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+
+			// Append the cascades
+			lightData.m_numCascades = voxelInjection ? 0 : numCascades;
+			for (int i = 0; i < lightData.m_numCascades; ++i)
+			{
+				lightData.m_cascadeSplits[i] = splits[i + 1];
+				lightData.m_cascadeTransforms[i] = slices[i].m_transform.m_transform;
+				lightData.m_cascadeUvTransforms[i] = glm::vec4(slices[i].m_textureOffset, slices[i].m_textureScale);
+			}
 		}
 
 		// Return the final result
@@ -243,7 +329,7 @@ namespace DirectionalLight
 		unsigned numWorkGroups = (glm::ceil(renderSettings->component<RenderSettings::RenderSettingsComponent>().m_buffers.m_numVoxels / 8.0f));
 
 		// Construct light batches
-		auto const& lightBatches = getLightBatches(scene, renderSettings, object);
+		auto const& lightBatches = getLightBatches(scene, renderSettings, object, true);
 		for (auto const& lightData : lightBatches)
 		{
 			// Upload the parameters
@@ -55,6 +55,11 @@ namespace DirectionalLight
 		GLfloat m_shadowMomentsBias;
 		alignas(sizeof(glm::vec2)) glm::vec2 m_shadowExponentialConstants;
 		alignas(sizeof(glm::vec4)) glm::mat4 m_lightSpaceTransform;
+		glm::vec4 m_lightSpaceUvTransform;
+		GLint m_numCascades;
+		alignas(sizeof(glm::vec4)) glm::vec4 m_cascadeSplits;
+		glm::mat4 m_cascadeTransforms[ShadowMap::MAX_CASCADES];
+		glm::vec4 m_cascadeUvTransforms[ShadowMap::MAX_CASCADES];
 	};
 
 	////////////////////////////////////////////////////////////////////////////////
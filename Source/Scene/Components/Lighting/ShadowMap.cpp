@@ -25,6 +25,14 @@ namespace ShadowMap
 		shadowSettingsChanged |= ImGui::DragFloat("Polygon Offset Linear", &object->component<ShadowMap::ShadowMapComponent>().m_polygonOffsetLinear, 0.01f, 0.0f);
 		shadowSettingsChanged |= ImGui::DragFloat2("Clip Plane Offset", glm::value_ptr(object->component<ShadowMap::ShadowMapComponent>().m_clipPlaneOffset), 0.1f);
 		shadowSettingsChanged |= ImGui::DragFloat2("Clip Plane Scale", glm::value_ptr(object->component<ShadowMap::ShadowMapComponent>().m_clipPlaneScale), 0.1f);
+		if (object->component<ShadowMap::ShadowMapComponent>().m_layout == ShadowMap::ShadowMapComponent::Cascaded)
+		{
+			textureSettingsChanged |= ImGui::SliderInt("Cascades", &object->component<ShadowMap::ShadowMapComponent>().m_numCascades, 1, ShadowMap::MAX_CASCADES);
+			shadowSettingsChanged |= ImGui::Combo("Cascade Split Method", &object->component<ShadowMap::ShadowMapComponent>().m_cascadeSplitMethod, ShadowMap::ShadowMapComponent::CascadeSplitMethod_meta);
+			if (object->component<ShadowMap::ShadowMapComponent>().m_cascadeSplitMethod == ShadowMap::ShadowMapComponent::Practical)
+				shadowSettingsChanged |= ImGui::SliderFloat("Cascade Split Lambda", &object->component<ShadowMap::ShadowMapComponent>().m_cascadeSplitLambda, 0.0f, 1.0f);
+			shadowSettingsChanged |= ImGui::Checkbox("Fit Cascades to Scene", &object->component<ShadowMap::ShadowMapComponent>().m_fitCascadesToScene);
+		}
 		textureSettingsChanged |= ImGui::Combo("Shadow Map Algorithm", &object->component<ShadowMap::ShadowMapComponent>().m_algorithm, ShadowMap::ShadowMapComponent::ShadowMapAlgorithm_meta);
 		if (object->component<ShadowMap::ShadowMapComponent>().m_algorithm == ShadowMap::ShadowMapComponent::Basic ||
 			object->component<ShadowMap::ShadowMapComponent>().m_algorithm == ShadowMap::ShadowMapComponent::Moments)
@@ -327,6 +335,221 @@ namespace ShadowMap
 		}, false, false);
 	}
 
+	////////////////////////////////////////////////////////////////////////////////
+	CascadeGeometry collectCascadeGeometry(Scene::Scene& scene, Scene::Object* renderSettings, Scene::Object* camera, Scene::Object* object)
+	{
+		CascadeGeometry result;
+
+		// Store the camera properties
+		result.m_view = Camera::getViewMatrix(camera);
+		result.m_inverseView = glm::inverse(result.m_view);
+		result.m_tanHalfFovy = glm::tan(camera->component<Camera::CameraComponent>().m_fovy * 0.5f);
+		result.m_aspectRatio = Camera::getAspectRatio(renderSettings, camera);
+		result.m_near = RenderSettings::metersToUnits(renderSettings, camera->component<Camera::CameraComponent>().m_near);
+		result.m_far = RenderSettings::metersToUnits(renderSettings, camera->component<Camera::CameraComponent>().m_far);
+
+		// View frustum of the camera
+		const BVH::Frustum viewFrustum = BVH::Frustum(Camera::getProjectionMatrix(renderSettings, camera) * result.m_view);
+
+		// List of materials to ignore
+		auto const& ignoreMaterials = object->component<ShadowMap::ShadowMapComponent>().m_ignoreMaterials;
+
+		// Collect the bounds of the individual submeshes
+		for (auto meshObject : Scene::filterObjects(scene, Scene::OBJECT_TYPE_MESH, true, false))
+		{
+			if (!Mesh::isMeshValid(scene, meshObject)) continue;
+
+			const glm::mat4 model = Transform::getModelMatrix(meshObject);
+			auto const& mesh = scene.m_meshes[meshObject->component<Mesh::MeshComponent>().m_meshName];
+			for (auto const& subMesh : mesh.m_subMeshes)
+			{
+				// Ignore invisible submeshes
+				auto const& material = scene.m_materials[meshObject->component<Mesh::MeshComponent>().m_materials[subMesh.m_materialId]];
+				if (material.m_opacity < 0.01f) continue;
+
+				// World-space bounds of the submesh
+				const BVH::AABB aabb = subMesh.m_aabb.transform(model);
+
+				// Every submesh not on the ignore list casts shadows
+				if (std::find(ignoreMaterials.begin(), ignoreMaterials.end(), material.m_name) == ignoreMaterials.end())
+					result.m_casters.push_back(aabb);
+
+				// Only the submeshes visible from the camera receive shadows
+				if (viewFrustum.intersection(aabb) == BVH::Outside) continue;
+
+				const BVH::AABB viewAabb = aabb.transform(result.m_view);
+				result.m_receivers.push_back(aabb);
+				result.m_receiverDepths.push_back(glm::clamp(glm::vec2(-viewAabb.m_max.z, -viewAabb.m_min.z), result.m_near, result.m_far));
+			}
+		}
+
+		return result;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	std::vector<float> computeCascadeSplits(Scene::Scene& scene, Scene::Object* object, CascadeGeometry const& geometry)
+	{
+		// Number of cascades
+		const int numCascades = glm::clamp(object->component<ShadowMap::ShadowMapComponent>().m_numCascades, 1, ShadowMap::MAX_CASCADES);
+
+		// Depth range to distribute the splits in; this is the range covered by the visible receivers, when fitting to the scene
+		glm::vec2 depthRange = glm::vec2(geometry.m_near, geometry.m_far);
+		if (object->component<ShadowMap::ShadowMapComponent>().m_fitCascadesToScene && !geometry.m_receiverDepths.empty())
+		{
+			depthRange = glm::vec2(FLT_MAX, -FLT_MAX);
+			for (auto const& depths : geometry.m_receiverDepths)
+				depthRange = glm::vec2(glm::min(depthRange.x, depths.x), glm::max(depthRange.y, depths.y));
+		}
+		const float near = glm::max(depthRange.x, glm::max(geometry.m_near, 1e-4f));
+		const float far = glm::max(depthRange.y, near * 1.001f);
+
+		// Uniform and logarithmic split distribution
+		auto uniformSplit = [&](float t) { return near + (far - near) * t; };
+		auto logarithmicSplit = [&](float t) { return near * glm::pow(far / near, t); };
+
+		// Compute the splits
+		std::vector<float> result(numCascades + 1);
+		result.front() = near;
+		result.back() = far;
+		auto splitMethod = object->component<ShadowMap::ShadowMapComponent>().m_cascadeSplitMethod;
+		if (splitMethod == ShadowMap::ShadowMapComponent::DepthDistribution)
+		{
+			// Accumulate the receiver coverage into logarithmic depth bins; this yields logarithmic splits for
+			// evenly covered depth ranges, while empty depth ranges receive no resolution at all
+			static const int s_numBins = 64;
+			const float logNear = glm::log(near);
+			const float logRange = glm::log(far) - logNear;
+			std::vector<float> coverage(s_numBins, 0.0f);
+			for (auto const& depths : geometry.m_receiverDepths)
+			{
+				// Range of bins covered by the receiver
+				const float binStart = glm::clamp((glm::log(glm::max(depths.x, near)) - logNear) / logRange, 0.0f, 1.0f) * s_numBins;
+				const float binEnd = glm::clamp((glm::log(glm::max(depths.y, near)) - logNear) / logRange, 0.0f, 1.0f) * s_numBins;
+				const float binLength = binEnd - binStart;
+
+				// Each receiver contributes the same total weight, distributed evenly along its depth range
+				if (binLength < 1e-3f)
+				{
+					coverage[glm::clamp(int(binStart), 0, s_numBins - 1)] += 1.0f;
+					continue;
+				}
+				for (int bin = int(binStart); bin < glm::min(int(glm::ceil(binEnd)), s_numBins); ++bin)
+					coverage[bin] += (glm::min(binEnd, float(bin + 1)) - glm::max(binStart, float(bin))) / binLength;
+			}
+
+			// Place the splits at equal quantiles of the coverage distribution
+			const float totalCoverage = std::accumulate(coverage.begin(), coverage.end(), 0.0f);
+			float accumulatedCoverage = 0.0f;
+			int bin = 0;
+			for (int i = 1; i < numCascades; ++i)
+			{
+				// Fall back to the logarithmic splits without any receivers
+				if (totalCoverage <= 0.0f)
+				{
+					result[i] = logarithmicSplit(float(i) / float(numCascades));
+					continue;
+				}
+
+				// Find the bin containing the quantile
+				const float target = totalCoverage * float(i) / float(numCascades);
+				while (bin < s_numBins - 1 && accumulatedCoverage + coverage[bin] < target)
+					accumulatedCoverage += coverage[bin++];
+
+				// Interpolate within the bin
+				const float t = coverage[bin] > 0.0f ? glm::clamp((target - accumulatedCoverage) / coverage[bin], 0.0f, 1.0f) : 0.0f;
+				result[i] = glm::exp(logNear + logRange * (float(bin) + t) / float(s_numBins));
+			}
+		}
+		else
+		{
+			for (int i = 1; i < numCascades; ++i)
+			{
+				const float t = float(i) / float(numCascades);
+				if (splitMethod == ShadowMap::ShadowMapComponent::Uniform)
+					result[i] = uniformSplit(t);
+				else if (splitMethod == ShadowMap::ShadowMapComponent::Logarithmic)
+					result[i] = logarithmicSplit(t);
+				else if (splitMethod == ShadowMap::ShadowMapComponent::Practical)
+					result[i] = glm::mix(uniformSplit(t), logarithmicSplit(t), object->component<ShadowMap::ShadowMapComponent>().m_cascadeSplitLambda);
+			}
+		}
+
+		return result;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	ShadowMapTransform fitCascadeTransform(Scene::Scene& scene, Scene::Object* object, CascadeGeometry const& geometry, glm::vec3 direction, float splitNear, float splitFar)
+	{
+		// Light-space view matrix
+		const glm::vec3 up = glm::abs(direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+		const glm::mat4 view = glm::lookAt(glm::vec3(0.0f), direction, up);
+		const glm::mat4 viewToLight = view * geometry.m_inverseView;
+
+		// Light-space bounds of the view frustum slice
+		BVH::AABB sliceBounds = BVH::AABB(glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX));
+		for (float depth : { splitNear, splitFar })
+		for (int corner = 0; corner < 4; ++corner)
+		{
+			const glm::vec2 ndc = glm::vec2((corner & 1) ? 1.0f : -1.0f, (corner & 2) ? 1.0f : -1.0f);
+			const glm::vec3 positionVS = glm::vec3(ndc * depth * geometry.m_tanHalfFovy * glm::vec2(geometry.m_aspectRatio, 1.0f), -depth);
+			sliceBounds = sliceBounds.extend(glm::vec3(viewToLight * glm::vec4(positionVS, 1.0f)));
+		}
+
+		// Tighten the slice to the bounds of the receivers overlapping it
+		BVH::AABB bounds = sliceBounds;
+		if (object->component<ShadowMap::ShadowMapComponent>().m_fitCascadesToScene)
+		{
+			BVH::AABB receiverBounds = BVH::AABB(glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX));
+			for (size_t i = 0; i < geometry.m_receivers.size(); ++i)
+			{
+				if (geometry.m_receiverDepths[i].y < splitNear || geometry.m_receiverDepths[i].x > splitFar) continue;
+				receiverBounds = receiverBounds.extend(geometry.m_receivers[i].transform(view));
+			}
+
+			const BVH::AABB fittedBounds = BVH::AABB(glm::max(sliceBounds.m_min, receiverBounds.m_min), glm::min(sliceBounds.m_max, receiverBounds.m_max));
+			if (glm::all(glm::lessThanEqual(fittedBounds.m_min, fittedBounds.m_max)))
+				bounds = fittedBounds;
+		}
+
+		// Pull the near plane back to every caster that projects onto the cascade
+		for (auto const& caster : geometry.m_casters)
+		{
+			const BVH::AABB casterBounds = caster.transform(view);
+			if (casterBounds.m_max.x < bounds.m_min.x || casterBounds.m_min.x > bounds.m_max.x ||
+				casterBounds.m_max.y < bounds.m_min.y || casterBounds.m_min.y > bounds.m_max.y ||
+				casterBounds.m_max.z < bounds.m_min.z)
+				continue;
+			bounds.m_max.z = glm::max(bounds.m_max.z, casterBounds.m_max.z);
+		}
+
+		// Pad the bounds by a few texels to leave room for the shadow filtering
+		static const float s_paddingTexels = 2.0f;
+		const float resolution = float(object->component<ShadowMap::ShadowMapComponent>().m_resolution);
+		const glm::vec3 padding = bounds.getSize() * s_paddingTexels / resolution;
+		bounds.m_min -= padding;
+		bounds.m_max += padding;
+
+		// Snap the bounds to whole texels, so that the shadows don't shimmer as the camera moves; the texel size 
+		// is rounded up to a fraction of an octave so that it stays the same under small changes of the fitted bounds
+		static const float s_texelSizeStepsPerOctave = 8.0f;
+		const glm::vec2 extents = glm::max(glm::vec2(bounds.getSize()), glm::vec2(1e-4f));
+		const glm::vec2 texelSize = glm::exp2(glm::ceil(glm::log2(extents / (resolution - 1.0f)) * s_texelSizeStepsPerOctave) / s_texelSizeStepsPerOctave);
+		const glm::vec2 snappedMin = glm::floor(glm::vec2(bounds.m_min) / texelSize) * texelSize;
+		bounds.m_min = glm::vec3(snappedMin, bounds.m_min.z);
+		bounds.m_max = glm::vec3(snappedMin + texelSize * resolution, bounds.m_max.z);
+
+		// Generate the result
+		ShadowMap::ShadowMapTransform result;
+		result.m_near = -bounds.m_max.z;
+		result.m_far = -bounds.m_min.z;
+		result.m_isPerspective = false;
+		result.m_view = view;
+		result.m_projection = glm::ortho(bounds.m_min.x, bounds.m_max.x, bounds.m_min.y, bounds.m_max.y, result.m_near, result.m_far);
+		result.m_transform = result.m_projection * result.m_view;
+		result.m_frustum = BVH::Frustum(result.m_transform);
+		return result;
+	}
+
 	////////////////////////////////////////////////////////////////////////////////
 	void updateBlurKernels(Scene::Scene& scene, Scene::Object* object)
 	{
@@ -15,6 +15,10 @@ namespace ShadowMap
 	static constexpr const char* DISPLAY_NAME = "Shadow Caster";
 	static constexpr const char* CATEGORY = "Lighting";
 
+	////////////////////////////////////////////////////////////////////////////////
+	// Maximum number of cascades supported by the cascaded layout
+	static const int MAX_CASCADES = 4;
+
 	////////////////////////////////////////////////////////////////////////////////
 	/** Represents the transformation properties for a shadow map slice. */
 	struct ShadowMapTransform
@@ -77,6 +81,9 @@ namespace ShadowMap
 		// Shadow map precision
 		meta_enum(ShadowMapLayout, int, Traditional, DualParaboloid, CubeMaps, Cascaded);
 
+		// How the cascade splits are distributed along the view depth
+		meta_enum(CascadeSplitMethod, int, Uniform, Logarithmic, Practical, DepthDistribution);
+
 		// Whether the light source should cast shadows or not
 		bool m_castsShadow = false;
 
@@ -120,6 +127,18 @@ namespace ShadowMap
 		// List of materials to ignore
 		std::vector<std::string> m_ignoreMaterials;
 
+		// Number of cascades to use with the cascaded layout
+		int m_numCascades = 4;
+
+		// How to distribute the cascade splits
+		CascadeSplitMethod m_cascadeSplitMethod = DepthDistribution;
+
+		// Blend factor between the uniform and logarithmic splits for the practical split scheme
+		float m_cascadeSplitLambda = 0.75f;
+
+		// Whether the cascades should be fitted to the visible receivers and casters or the view frustum only
+		bool m_fitCascadesToScene = true;
+
 		// ---- Private members
 
 		// Discrete and linear blur kernels
@@ -143,6 +162,31 @@ namespace ShadowMap
 
 		// Size of the built shadow map
 		glm::ivec2 m_shadowMapDimensions;
+
+		// View-space distances of the cascade splits
+		std::vector<float> m_cascadeSplits;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////
+	/** Scene geometry used for fitting the shadow cascades. */
+	struct CascadeGeometry
+	{
+		// World-space bounds of the receivers visible from the camera
+		std::vector<BVH::AABB> m_receivers;
+
+		// View-space depth range of each receiver, clamped to the camera's clip range
+		std::vector<glm::vec2> m_receiverDepths;
+
+		// World-space bounds of the shadow casters
+		std::vector<BVH::AABB> m_casters;
+
+		// Camera properties
+		glm::mat4 m_view;
+		glm::mat4 m_inverseView;
+		float m_tanHalfFovy;
+		float m_aspectRatio;
+		float m_near;
+		float m_far;
 	};
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -166,6 +210,15 @@ namespace ShadowMap
 	////////////////////////////////////////////////////////////////////////////////
 	std::vector<Scene::Object*> getShadowCasters(Scene::Scene& scene);
 
+	////////////////////////////////////////////////////////////////////////////////
+	CascadeGeometry collectCascadeGeometry(Scene::Scene& scene, Scene::Object* renderSettings, Scene::Object* camera, Scene::Object* object);
+
+	////////////////////////////////////////////////////////////////////////////////
+	std::vector<float> computeCascadeSplits(Scene::Scene& scene, Scene::Object* object, CascadeGeometry const& geometry);
+
+	////////////////////////////////////////////////////////////////////////////////
+	ShadowMapTransform fitCascadeTransform(Scene::Scene& scene, Scene::Object* object, CascadeGeometry const& geometry, glm::vec3 direction, float splitNear, float splitFar);
+
 	////////////////////////////////////////////////////////////////////////////////
 	void updateBlurKernels(Scene::Scene& scene, Scene::Object* object);
 
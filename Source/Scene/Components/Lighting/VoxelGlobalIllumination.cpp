@@ -8,6 +8,7 @@ namespace VoxelGlobalIllumination
 	DEFINE_COMPONENT(VOXEL_GLOBAL_ILLUMINATION);
 	DEFINE_OBJECT(VOXEL_GLOBAL_ILLUMINATION);
 	REGISTER_OBJECT_UPDATE_CALLBACK(VOXEL_GLOBAL_ILLUMINATION, AFTER, RENDER_SETTINGS);
+	REGISTER_OBJECT_RENDER_CALLBACK(VOXEL_GLOBAL_ILLUMINATION, "Voxel Basepass [Static Voxels]", OpenGL, BEFORE, "Voxel Basepass [Mesh]", 2, &VoxelGlobalIllumination::uploadStaticVoxelsOpenGL, &RenderSettings::voxelBasePassTypePreConditionOpenGL, &RenderSettings::firstCallObjectCondition, nullptr, nullptr);
 	REGISTER_OBJECT_RENDER_CALLBACK(VOXEL_GLOBAL_ILLUMINATION, "Voxel Lighting [Inject Indirect]", OpenGL, BEFORE, "Voxel Lighting [End]", 2, &VoxelGlobalIllumination::injectIndirectLightingOpenGL, &VoxelGlobalIllumination::injectIndirectLightingTypePreConditionOpenGL, &RenderSettings::firstCallObjectCondition, nullptr, nullptr);
 	REGISTER_OBJECT_RENDER_CALLBACK(VOXEL_GLOBAL_ILLUMINATION, "Lighting [Voxel GI]", OpenGL, AFTER, "Lighting [Begin]", 2, &VoxelGlobalIllumination::lightingOpenGL, &VoxelGlobalIllumination::lightingTypePreConditionOpenGL, &RenderSettings::firstCallObjectCondition, VoxelGlobalIllumination::lightingBeginOpenGL, VoxelGlobalIllumination::lightingEndOpenGL);
 
@@ -58,13 +59,483 @@ namespace VoxelGlobalIllumination
 	////////////////////////////////////////////////////////////////////////////////
 	void releaseObject(Scene::Scene& scene, Scene::Object& object)
 	{
+		object.component<VoxelGlobalIllumination::VoxelGlobalIlluminationComponent>().m_staticVoxelCache = nullptr;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	struct StaticVoxelCache
+	{
+		// Geometry of a mesh, read back from the GPU
+		struct MeshData
+		{
+			std::vector<glm::vec3> m_positions;
+			std::vector<glm::vec3> m_normals;
+			std::vector<GLuint> m_indices;
+		};
+
+		// Material attributes averaged over the surface
+		struct MaterialData
+		{
+			glm::vec3 m_albedo;
+			glm::vec3 m_surface;
+			float m_opacity;
+
+			bool operator==(MaterialData const& other) const
+			{
+				return m_albedo == other.m_albedo && m_surface == other.m_surface && m_opacity == other.m_opacity;
+			}
+		};
+
+		// State of a static mesh when it was voxelized
+		struct CachedObject
+		{
+			Scene::Object* m_object;
+			std::string m_meshName;
+			glm::mat4 m_model;
+			std::vector<MaterialData> m_materials;
+
+			bool operator==(CachedObject const& other) const
+			{
+				return m_object == other.m_object && m_meshName == other.m_meshName && m_model == other.m_model && m_materials == other.m_materials;
+			}
+		};
+
+		// Static meshes in the cache
+		std::vector<CachedObject> m_objects;
+
+		// Voxel grid layout the cache was built for
+		glm::vec3 m_worldMin{ 0.0f };
+		float m_voxelSize = 0.0f;
+		int m_numVoxels = 0;
+
+		// Whether a rebuild was explicitly requested
+		bool m_dirty = true;
+
+		// Packed RGBA8 voxel gbuffer contents, in the same layout as the GPU voxelizer writes them
+		std::vector<GLuint> m_albedo;
+		std::vector<GLuint> m_normal;
+		std::vector<GLuint> m_specular;
+
+		// Objects whose voxels are in the packed buffers
+		std::unordered_set<Scene::Object*> m_voxelizedObjects;
+
+		// Mesh geometry and average texture colors, kept between rebuilds
+		std::unordered_map<std::string, MeshData> m_meshData;
+		std::unordered_map<std::string, glm::vec4> m_textureAverages;
+	};
+
+	////////////////////////////////////////////////////////////////////////////////
+	namespace CpuVoxelizer
+	{
+		// Number of voxel grid slices processed by a single work item
+		static constexpr int s_slabDepth = 4;
+
+		////////////////////////////////////////////////////////////////////////////////
+		/** A triangle in voxel space, set up for the triangle/voxel overlap test of Schwarz and Seidel. */
+		struct Triangle
+		{
+			// Plane test
+			glm::vec3 m_normal;
+			float m_planeD1;
+			float m_planeD2;
+
+			// Edge tests in the XY, YZ and ZX projections
+			glm::vec2 m_edgeNormalsXY[3];
+			glm::vec2 m_edgeNormalsYZ[3];
+			glm::vec2 m_edgeNormalsZX[3];
+			float m_edgeDistXY[3];
+			float m_edgeDistYZ[3];
+			float m_edgeDistZX[3];
+
+			// Voxel bounds
+			glm::ivec3 m_minVoxel;
+			glm::ivec3 m_maxVoxel;
+
+			// Attributes written to the voxel gbuffer
+			glm::vec3 m_albedo;
+			glm::vec3 m_normal01;
+			glm::vec3 m_surface;
+		};
+
+		////////////////////////////////////////////////////////////////////////////////
+		/** Sums of the voxel attributes for a single voxel. */
+		struct VoxelAccumulator
+		{
+			glm::vec3 m_albedo{ 0.0f };
+			glm::vec3 m_normal{ 0.0f };
+			glm::vec3 m_surface{ 0.0f };
+			int m_count = 0;
+		};
+
+		////////////////////////////////////////////////////////////////////////////////
+		template<typename T>
+		std::vector<T> readBackBuffer(GLuint buffer, size_t count)
+		{
+			std::vector<T> result(count);
+			glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+			glGetBufferSubData(GL_COPY_READ_BUFFER, 0, sizeof(T) * count, result.data());
+			glBindBuffer(GL_COPY_READ_BUFFER, 0);
+			return result;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		StaticVoxelCache::MeshData const& getMeshData(Scene::Scene& scene, StaticVoxelCache& cache, std::string const& meshName)
+		{
+			if (auto it = cache.m_meshData.find(meshName); it != cache.m_meshData.end())
+				return it->second;
+
+			GPU::Mesh const& mesh = scene.m_meshes[meshName];
+			StaticVoxelCache::MeshData& meshData = cache.m_meshData[meshName];
+			meshData.m_positions = readBackBuffer<glm::vec3>(mesh.m_vboPosition, mesh.m_vertexCount);
+			meshData.m_normals = readBackBuffer<glm::vec3>(mesh.m_vboNormal, mesh.m_vertexCount);
+			meshData.m_indices = readBackBuffer<GLuint>(mesh.m_ibo, mesh.m_indexCount);
+			return meshData;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		/** Average color of a texture, taken from its smallest mip level. */
+		glm::vec4 getTextureAverage(Scene::Scene& scene, StaticVoxelCache& cache, std::string const& textureName)
+		{
+			if (auto cached = cache.m_textureAverages.find(textureName); cached != cache.m_textureAverages.end())
+				return cached->second;
+
+			// Textures that are not loaded yet are treated as white, without caching them
+			auto it = scene.m_textures.find(textureName);
+			if (it == scene.m_textures.end() || it->second.m_type != GL_TEXTURE_2D)
+				return glm::vec4(1.0f);
+
+			glm::vec4 average(1.0f);
+			const int mipLevel = int(glm::floor(glm::log2(float(glm::max(1, glm::max(it->second.m_width, it->second.m_height))))));
+			glBindTexture(GL_TEXTURE_2D, it->second.m_texture);
+
+			GLint width = 0, height = 0;
+			glGetTexLevelParameteriv(GL_TEXTURE_2D, mipLevel, GL_TEXTURE_WIDTH, &width);
+			glGetTexLevelParameteriv(GL_TEXTURE_2D, mipLevel, GL_TEXTURE_HEIGHT, &height);
+			if (width > 0 && height > 0)
+			{
+				std::vector<glm::vec4> texels(width * height);
+				glGetTexImage(GL_TEXTURE_2D, mipLevel, GL_RGBA, GL_FLOAT, texels.data());
+				average = std::accumulate(texels.begin(), texels.end(), glm::vec4(0.0f)) / float(texels.size());
+			}
+			cache.m_textureAverages[textureName] = average;
+			return average;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		/** Evaluates the material function of the voxel basepass shader with the textures replaced by their average colors. */
+		StaticVoxelCache::MaterialData evaluateMaterial(Scene::Scene& scene, Scene::Object* renderSettings, StaticVoxelCache& cache, GPU::Material const& material)
+		{
+			StaticVoxelCache::MaterialData result;
+			result.m_albedo = material.m_diffuse;
+			result.m_opacity = material.m_opacity;
+			result.m_surface = glm::vec3(material.m_metallic, material.m_roughness, material.m_specular);
+
+			// Albedo map
+			if (!material.m_diffuseMap.empty() && material.m_diffuseMap != "default_diffuse_map")
+			{
+				const glm::vec4 albedoMap = glm::pow(getTextureAverage(scene, cache, material.m_diffuseMap), glm::vec4(renderSettings->component<RenderSettings::RenderSettingsComponent>().m_lighting.m_gamma));
+				result.m_albedo *= glm::vec3(albedoMap);
+				result.m_opacity *= albedoMap.a;
+			}
+
+			// Alpha map
+			if (!material.m_alphaMap.empty() && material.m_alphaMap != "default_alpha_map" &&
+				renderSettings->component<RenderSettings::RenderSettingsComponent>().m_features.m_transparencyMethod != RenderSettings::DisableTransparency)
+			{
+				result.m_opacity *= getTextureAverage(scene, cache, material.m_alphaMap).r;
+			}
+
+			// Specular map
+			if (!material.m_specularMap.empty() && material.m_specularMap != "default_specular_map")
+			{
+				const glm::vec4 specularMap = getTextureAverage(scene, cache, material.m_specularMap);
+				if (glm::any(glm::greaterThan(material.m_metallicMask, glm::vec4(0.0f)))) result.m_surface.x = glm::dot(specularMap, material.m_metallicMask);
+				if (glm::any(glm::greaterThan(material.m_roughnessMask, glm::vec4(0.0f)))) result.m_surface.y = glm::dot(specularMap, material.m_roughnessMask);
+				if (glm::any(glm::greaterThan(material.m_specularMask, glm::vec4(0.0f)))) result.m_surface.z = glm::dot(specularMap, material.m_specularMask);
+			}
+
+			return result;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		/** Collects the static meshes along with the state they would be voxelized with. */
+		std::vector<StaticVoxelCache::CachedObject> collectStaticObjects(Scene::Scene& scene, Scene::Object* renderSettings, StaticVoxelCache& cache)
+		{
+			std::vector<StaticVoxelCache::CachedObject> result;
+			for (auto meshObject : Scene::filterObjects(scene, Scene::OBJECT_TYPE_MESH, true, false))
+			{
+				if (!meshObject->component<Mesh::MeshComponent>().m_static || !Mesh::isMeshValid(scene, meshObject)) continue;
+
+				StaticVoxelCache::CachedObject cachedObject;
+				cachedObject.m_object = meshObject;
+				cachedObject.m_meshName = meshObject->component<Mesh::MeshComponent>().m_meshName;
+				cachedObject.m_model = Transform::getModelMatrix(meshObject);
+				for (auto const& materialName : meshObject->component<Mesh::MeshComponent>().m_materials)
+					cachedObject.m_materials.push_back(evaluateMaterial(scene, renderSettings, cache, scene.m_materials[materialName]));
+				result.push_back(cachedObject);
+			}
+			return result;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		Triangle setupTriangle(glm::vec3 const& v0, glm::vec3 const& v1, glm::vec3 const& v2, int numVoxels)
+		{
+			Triangle triangle;
+
+			const glm::vec3 vertices[3] = { v0, v1, v2 };
+			const glm::vec3 edges[3] = { v1 - v0, v2 - v1, v0 - v2 };
+
+			// Plane through the triangle, offset to the two critical corners of the voxel
+			triangle.m_normal = glm::cross(edges[0], edges[1]);
+			const glm::vec3 criticalPoint = glm::vec3(glm::greaterThan(triangle.m_normal, glm::vec3(0.0f)));
+			triangle.m_planeD1 = glm::dot(triangle.m_normal, criticalPoint - v0);
+			triangle.m_planeD2 = glm::dot(triangle.m_normal, glm::vec3(1.0f) - criticalPoint - v0);
+
+			// Edge functions of the three projections, pointing inwards
+			const float signX = triangle.m_normal.x >= 0.0f ? 1.0f : -1.0f;
+			const float signY = triangle.m_normal.y >= 0.0f ? 1.0f : -1.0f;
+			const float signZ = triangle.m_normal.z >= 0.0f ? 1.0f : -1.0f;
+			for (int i = 0; i < 3; ++i)
+			{
+				triangle.m_edgeNormalsXY[i] = glm::vec2(-edges[i].y, edges[i].x) * signZ;
+				triangle.m_edgeNormalsYZ[i] = glm::vec2(-edges[i].z, edges[i].y) * signX;
+				triangle.m_edgeNormalsZX[i] = glm::vec2(-edges[i].x, edges[i].z) * signY;
+				triangle.m_edgeDistXY[i] = -glm::dot(triangle.m_edgeNormalsXY[i], glm::vec2(vertices[i].x, vertices[i].y)) +
+					glm::max(0.0f, triangle.m_edgeNormalsXY[i].x) + glm::max(0.0f, triangle.m_edgeNormalsXY[i].y);
+				triangle.m_edgeDistYZ[i] = -glm::dot(triangle.m_edgeNormalsYZ[i], glm::vec2(vertices[i].y, vertices[i].z)) +
+					glm::max(0.0f, triangle.m_edgeNormalsYZ[i].x) + glm::max(0.0f, triangle.m_edgeNormalsYZ[i].y);
+				triangle.m_edgeDistZX[i] = -glm::dot(triangle.m_edgeNormalsZX[i], glm::vec2(vertices[i].z, vertices[i].x)) +
+					glm::max(0.0f, triangle.m_edgeNormalsZX[i].x) + glm::max(0.0f, triangle.m_edgeNormalsZX[i].y);
+			}
+
+			// The edge tests are only exact within the bounding box of the triangle
+			triangle.m_minVoxel = glm::clamp(glm::ivec3(glm::floor(glm::min(v0, glm::min(v1, v2)))), glm::ivec3(0), glm::ivec3(numVoxels - 1));
+			triangle.m_maxVoxel = glm::clamp(glm::ivec3(glm::floor(glm::max(v0, glm::max(v1, v2)))), glm::ivec3(0), glm::ivec3(numVoxels - 1));
+
+			return triangle;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		bool overlaps(Triangle const& triangle, glm::vec3 const& voxel)
+		{
+			const float planeDist = glm::dot(triangle.m_normal, voxel);
+			if ((planeDist + triangle.m_planeD1) * (planeDist + triangle.m_planeD2) > 0.0f)
+				return false;
+
+			for (int i = 0; i < 3; ++i)
+			{
+				if (glm::dot(triangle.m_edgeNormalsXY[i], glm::vec2(voxel.x, voxel.y)) + triangle.m_edgeDistXY[i] < 0.0f) return false;
+				if (glm::dot(triangle.m_edgeNormalsYZ[i], glm::vec2(voxel.y, voxel.z)) + triangle.m_edgeDistYZ[i] < 0.0f) return false;
+				if (glm::dot(triangle.m_edgeNormalsZX[i], glm::vec2(voxel.z, voxel.x)) + triangle.m_edgeDistZX[i] < 0.0f) return false;
+			}
+			return true;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		/** Transforms the triangles of the static meshes to voxel space. */
+		std::vector<Triangle> gatherTriangles(Scene::Scene& scene, StaticVoxelCache& cache)
+		{
+			// Geometry and submesh of a single work item
+			struct Job
+			{
+				StaticVoxelCache::CachedObject const* m_object;
+				StaticVoxelCache::MeshData const* m_meshData;
+				GPU::SubMesh const* m_subMesh;
+				size_t m_firstTriangle;
+			};
+
+			// Read back the geometry and lay out the triangles of each submesh
+			std::vector<Job> jobs;
+			size_t numTriangles = 0;
+			for (auto const& object : cache.m_objects)
+			{
+				StaticVoxelCache::MeshData const& meshData = getMeshData(scene, cache, object.m_meshName);
+				for (auto const& subMesh : scene.m_meshes[object.m_meshName].m_subMeshes)
+				{
+					if (subMesh.m_materialId >= object.m_materials.size() || object.m_materials[subMesh.m_materialId].m_opacity < 0.02f) continue;
+					jobs.push_back(Job{ &object, &meshData, &subMesh, numTriangles });
+					numTriangles += subMesh.m_indexCount / 3;
+				}
+			}
+
+			const glm::vec3 worldMin = cache.m_worldMin;
+			const float voxelSize = cache.m_voxelSize;
+			const int numVoxels = cache.m_numVoxels;
+
+			std::vector<Triangle> triangles(numTriangles);
+			std::vector<char> valid(numTriangles, 0);
+			Threading::threadedExecuteIndices(Threading::numThreads(),
+				[&](Threading::ThreadedExecuteEnvironment const& environment, const size_t jobID)
+				{
+					Job const& job = jobs[jobID];
+					StaticVoxelCache::MaterialData const& material = job.m_object->m_materials[job.m_subMesh->m_materialId];
+					const glm::mat3 normalMatrix = glm::inverseTranspose(glm::mat3(job.m_object->m_model));
+
+					for (unsigned i = 0; i < job.m_subMesh->m_indexCount / 3; ++i)
+					{
+						glm::vec3 positions[3];
+						glm::vec3 normal(0.0f);
+						for (int v = 0; v < 3; ++v)
+						{
+							const GLuint vertexID = job.m_subMesh->m_vertexStartID + job.m_meshData->m_indices[job.m_subMesh->m_indexStartID + 3 * i + v];
+							const glm::vec3 worldPosition = glm::vec3(job.m_object->m_model * glm::vec4(job.m_meshData->m_positions[vertexID], 1.0f));
+							positions[v] = (worldPosition - worldMin) / voxelSize;
+							normal += normalMatrix * job.m_meshData->m_normals[vertexID];
+						}
+
+						Triangle& triangle = triangles[job.m_firstTriangle + i];
+						triangle = setupTriangle(positions[0], positions[1], positions[2], numVoxels);
+
+						// Skip degenerate triangles
+						if (glm::dot(triangle.m_normal, triangle.m_normal) <= 0.0f) continue;
+
+						// Fall back to the face normal if the vertex normals cancel out
+						if (glm::dot(normal, normal) <= 0.0f) normal = triangle.m_normal;
+
+						triangle.m_albedo = material.m_albedo * material.m_opacity;
+						triangle.m_normal01 = glm::normalize(normal) * 0.5f + 0.5f;
+						triangle.m_surface = material.m_surface;
+						valid[job.m_firstTriangle + i] = 1;
+					}
+				},
+				jobs.size());
+
+			// Drop the degenerate triangles
+			std::vector<Triangle> result;
+			result.reserve(numTriangles);
+			for (size_t i = 0; i < numTriangles; ++i)
+				if (valid[i]) result.push_back(triangles[i]);
+			return result;
+		}
 
+		////////////////////////////////////////////////////////////////////////////////
+		GLuint packRGBA8(glm::vec3 const& sum, int count)
+		{
+			const glm::uvec3 rgb = glm::uvec3(glm::clamp(sum / float(count), 0.0f, 1.0f) * 255.0f);
+			return rgb.r | (rgb.g << 8) | (rgb.b << 16) | (GLuint(glm::min(count, 255)) << 24);
+		}
+
+		////////////////////////////////////////////////////////////////////////////////
+		/** Voxelizes the triangles into the packed voxel gbuffer of the cache. */
+		void voxelize(StaticVoxelCache& cache, std::vector<Triangle> const& triangles)
+		{
+			const int numVoxels = cache.m_numVoxels;
+			const size_t sliceSize = size_t(numVoxels) * numVoxels;
+			const int numSlabs = (numVoxels + s_slabDepth - 1) / s_slabDepth;
+
+			// Bin the triangles into the slabs they touch
+			std::vector<std::vector<size_t>> slabTriangles(numSlabs);
+			for (size_t i = 0; i < triangles.size(); ++i)
+				for (int slab = triangles[i].m_minVoxel.z / s_slabDepth; slab <= triangles[i].m_maxVoxel.z / s_slabDepth; ++slab)
+					slabTriangles[slab].push_back(i);
+
+			cache.m_albedo.assign(sliceSize * numVoxels, 0);
+			cache.m_normal.assign(sliceSize * numVoxels, 0);
+			cache.m_specular.assign(sliceSize * numVoxels, 0);
+
+			// Each work item owns a slab of the grid, so no synchronization is needed
+			Threading::threadedExecuteIndices(Threading::numThreads(),
+				[&](Threading::ThreadedExecuteEnvironment const& environment, const size_t slabID)
+				{
+					const int firstSlice = int(slabID) * s_slabDepth;
+					const int lastSlice = glm::min(firstSlice + s_slabDepth, numVoxels) - 1;
+					std::vector<VoxelAccumulator> voxels(sliceSize * (lastSlice - firstSlice + 1));
+
+					for (size_t triangleID : slabTriangles[slabID])
+					{
+						Triangle const& triangle = triangles[triangleID];
+						for (int z = glm::max(triangle.m_minVoxel.z, firstSlice); z <= glm::min(triangle.m_maxVoxel.z, lastSlice); ++z)
+						for (int y = triangle.m_minVoxel.y; y <= triangle.m_maxVoxel.y; ++y)
+						for (int x = triangle.m_minVoxel.x; x <= triangle.m_maxVoxel.x; ++x)
+						{
+							if (!overlaps(triangle, glm::vec3(x, y, z))) continue;
+
+							VoxelAccumulator& voxel = voxels[(z - firstSlice) * sliceSize + size_t(y) * numVoxels + x];
+							voxel.m_albedo += triangle.m_albedo;
+							voxel.m_normal += triangle.m_normal01;
+							voxel.m_surface += triangle.m_surface;
+							++voxel.m_count;
+						}
+					}
+
+					// Pack the averages the same way the GPU voxelizer stores them
+					const size_t offset = size_t(firstSlice) * sliceSize;
+					for (size_t i = 0; i < voxels.size(); ++i)
+					{
+						if (voxels[i].m_count == 0) continue;
+						cache.m_albedo[offset + i] = packRGBA8(voxels[i].m_albedo, voxels[i].m_count);
+						cache.m_normal[offset + i] = packRGBA8(voxels[i].m_normal, voxels[i].m_count);
+						cache.m_specular[offset + i] = packRGBA8(voxels[i].m_surface, voxels[i].m_count);
+					}
+				},
+				size_t(numSlabs));
+		}
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
-	void updateObject(Scene::Scene& scene, Scene::Object* simulationSettings, Scene::Object* object)
+	/** Whether the cached voxels can be uploaded to the current voxel gbuffer. */
+	bool isStaticVoxelCacheUsable(Scene::Scene& scene, Scene::Object* renderSettings, Scene::Object* object)
 	{
+		auto const& cache = object->component<VoxelGlobalIllumination::VoxelGlobalIlluminationComponent>().m_staticVoxelCache;
+		return object->component<VoxelGlobalIllumination::VoxelGlobalIlluminationComponent>().m_cacheStaticVoxels && cache && !cache->m_albedo.empty() &&
+			cache->m_numVoxels == renderSettings->component<RenderSettings::RenderSettingsComponent>().m_buffers.m_numVoxels &&
+			RenderSettings::voxelGbufferGlTextureFormat(scene, renderSettings) == GL_RGBA8;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	void updateStaticVoxelCache(Scene::Scene& scene, Scene::Object* object)
+	{
+		auto& component = object->component<VoxelGlobalIllumination::VoxelGlobalIlluminationComponent>();
+		if (!component.m_cacheStaticVoxels) return;
+
+		Profiler::ScopedCpuPerfCounter perfCounter(scene, "Static Voxel Cache");
+
+		// Extract the render settings object
+		Scene::Object* renderSettings = findFirstObject(scene, Scene::OBJECT_TYPE_RENDER_SETTINGS);
+		auto const& renderSettingsComponent = renderSettings->component<RenderSettings::RenderSettingsComponent>();
+
+		// The cached voxels can only be uploaded to 8-bit voxel gbuffers
+		if (RenderSettings::voxelGbufferGlTextureFormat(scene, renderSettings) != GL_RGBA8) return;
 
+		if (!component.m_staticVoxelCache)
+			component.m_staticVoxelCache = std::make_shared<StaticVoxelCache>();
+		StaticVoxelCache& cache = *component.m_staticVoxelCache;
+
+		// Rebuild only if the static meshes or the voxel grid layout changed
+		std::vector<StaticVoxelCache::CachedObject> objects = CpuVoxelizer::collectStaticObjects(scene, renderSettings, cache);
+		const glm::vec3 worldMin = renderSettingsComponent.m_sceneAabb.m_min;
+		const int numVoxels = renderSettingsComponent.m_buffers.m_numVoxels;
+		const float voxelSize = renderSettingsComponent.m_voxelGridExtents / numVoxels;
+		if (!cache.m_dirty && cache.m_objects == objects && cache.m_worldMin == worldMin && cache.m_voxelSize == voxelSize && cache.m_numVoxels == numVoxels)
+			return;
+
+		DateTime::ScopedTimer timer = DateTime::ScopedTimer(Debug::Debug, 1, DateTime::Milliseconds, "Static Voxelization");
+
+		cache.m_objects = std::move(objects);
+		cache.m_worldMin = worldMin;
+		cache.m_voxelSize = voxelSize;
+		cache.m_numVoxels = numVoxels;
+		cache.m_dirty = false;
+
+		cache.m_voxelizedObjects.clear();
+		for (auto const& cachedObject : cache.m_objects)
+			cache.m_voxelizedObjects.insert(cachedObject.m_object);
+
+		if (voxelSize > 0.0f)
+			CpuVoxelizer::voxelize(cache, CpuVoxelizer::gatherTriangles(scene, cache));
+		else
+			cache.m_albedo.clear();
+
+		Debug::log_debug() << "Voxelized " << cache.m_objects.size() << " static meshes at " << numVoxels << "^3 voxels" << Debug::end;
+
+		// Re-voxelize the dynamic meshes on top of the new static voxels
+		RenderSettings::updateVoxelGrid(scene, renderSettings);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	void updateObject(Scene::Scene& scene, Scene::Object* simulationSettings, Scene::Object* object)
+	{
+		updateStaticVoxelCache(scene, object);
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -97,6 +568,47 @@ namespace VoxelGlobalIllumination
 		hasIndirectBounce |= object->component<VoxelGlobalIllumination::VoxelGlobalIlluminationComponent>().m_numDiffuseBounces > 1;
 
 		if (hasIndirectBounce && lightingChanged) RenderSettings::updateVoxelGridRadiance(scene);
+
+		if (ImGui::Checkbox("Cache Static Voxels (CPU)", &object->component<VoxelGlobalIllumination::VoxelGlobalIlluminationComponent>().m_cacheStaticVoxels))
+		{
+			object->component<VoxelGlobalIllumination::VoxelGlobalIlluminationComponent>().m_staticVoxelCache = nullptr;
+			RenderSettings::updateVoxelGrid(scene);
+		}
+		if (object->component<VoxelGlobalIllumination::VoxelGlobalIlluminationComponent>().m_staticVoxelCache && ImGui::Button("Rebuild Static Voxels"))
+		{
+			object->component<VoxelGlobalIllumination::VoxelGlobalIlluminationComponent>().m_staticVoxelCache->m_dirty = true;
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	bool isMeshVoxelizedOnCpu(Scene::Scene& scene, Scene::Object* object)
+	{
+		Scene::Object* renderSettings = findFirstObject(scene, Scene::OBJECT_TYPE_RENDER_SETTINGS);
+		for (auto voxelGI : Scene::filterObjects(scene, Scene::OBJECT_TYPE_VOXEL_GLOBAL_ILLUMINATION, true, false))
+		{
+			if (isStaticVoxelCacheUsable(scene, renderSettings, voxelGI) &&
+				voxelGI->component<VoxelGlobalIllumination::VoxelGlobalIlluminationComponent>().m_staticVoxelCache->m_voxelizedObjects.count(object) > 0)
+				return true;
+		}
+		return false;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	void uploadStaticVoxelsOpenGL(Scene::Scene& scene, Scene::Object* simulationSettings, Scene::Object* renderSettings, Scene::Object* camera, std::string const& functionName, Scene::Object* object)
+	{
+		if (!isStaticVoxelCacheUsable(scene, renderSettings, object)) return;
+
+		Profiler::ScopedGpuPerfCounter perfCounter(scene, "Static Voxels");
+
+		// Overwrite the cleared voxel gbuffer with the cached static voxels; the dynamic meshes are averaged on top of them
+		StaticVoxelCache const& cache = *object->component<VoxelGlobalIllumination::VoxelGlobalIlluminationComponent>().m_staticVoxelCache;
+		const GLsizei numVoxels = cache.m_numVoxels;
+		glBindTexture(GL_TEXTURE_3D, scene.m_voxelGrid.m_albedoTexture);
+		glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, 0, numVoxels, numVoxels, numVoxels, GL_RGBA, GL_UNSIGNED_BYTE, cache.m_albedo.data());
+		glBindTexture(GL_TEXTURE_3D, scene.m_voxelGrid.m_normalTexture);
+		glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, 0, numVoxels, numVoxels, numVoxels, GL_RGBA, GL_UNSIGNED_BYTE, cache.m_normal.data());
+		glBindTexture(GL_TEXTURE_3D, scene.m_voxelGrid.m_specularTexture);
+		glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, 0, numVoxels, numVoxels, numVoxels, GL_RGBA, GL_UNSIGNED_BYTE, cache.m_specular.data());
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
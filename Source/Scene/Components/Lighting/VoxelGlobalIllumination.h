@@ -23,6 +23,10 @@ namespace VoxelGlobalIllumination
 		float m_weight;
 	};
 
+	////////////////////////////////////////////////////////////////////////////////
+	/** Voxel gbuffer of the static meshes, voxelized on the CPU. */
+	struct StaticVoxelCache;
+
 	////////////////////////////////////////////////////////////////////////////////
 	/** A directional light component. */
 	struct VoxelGlobalIlluminationComponent
@@ -70,6 +74,14 @@ namespace VoxelGlobalIllumination
 		// Light contribution methods
 		LightContribution m_diffuseContribution = BRDF;
 		LightContribution m_specularContribution = BRDF;
+
+		// Whether meshes flagged as static should be voxelized once on the CPU and cached
+		bool m_cacheStaticVoxels = false;
+
+		// ---- Private members
+
+		// Cached voxel gbuffer of the static meshes
+		std::shared_ptr<StaticVoxelCache> m_staticVoxelCache;
 	};
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -132,6 +144,12 @@ namespace VoxelGlobalIllumination
 	////////////////////////////////////////////////////////////////////////////////
 	void generateGui(Scene::Scene& scene, Scene::Object* guiSettings, Scene::Object* object);
 
+	////////////////////////////////////////////////////////////////////////////////
+	bool isMeshVoxelizedOnCpu(Scene::Scene& scene, Scene::Object* object);
+
+	////////////////////////////////////////////////////////////////////////////////
+	void uploadStaticVoxelsOpenGL(Scene::Scene& scene, Scene::Object* simulationSettings, Scene::Object* renderSettings, Scene::Object* camera, std::string const& functionName, Scene::Object* object);
+
 	////////////////////////////////////////////////////////////////////////////////
 	bool injectIndirectLightingTypePreConditionOpenGL(Scene::Scene& scene, Scene::Object* simulationSettings, Scene::Object* renderSettings, Scene::Object* camera, std::string const& functionName);
 
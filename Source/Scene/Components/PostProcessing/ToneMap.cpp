@@ -39,6 +39,10 @@ namespace ToneMap
 	{
 		// Shader loading parameters
 		Asset::ShaderParameters shaderParameters;
+		shaderParameters.m_defines =
+		{
+			"LUMINANCE_HISTOGRAM_BINS " + std::to_string(LUMINANCE_HISTOGRAM_BINS)
+		};
 		shaderParameters.m_enums = Asset::generateMetaEnumDefines
 		(
 			ToneMap::TonemapComponent::ExposureMethod_meta,
@@ -53,6 +57,10 @@ namespace ToneMap
 		// Luminance mipmap generation program
 		Asset::loadShader(scene, "PostProcessing/ToneMap", "generate_luminance_mipmap", "ToneMap/generate_luminance_mipmap", shaderParameters);
 
+		// Luminance histogram programs
+		Asset::loadShader(scene, "PostProcessing/ToneMap", "luminance_histogram", "ToneMap/luminance_histogram", shaderParameters);
+		Asset::loadShader(scene, "PostProcessing/ToneMap", "luminance_histogram_average", "ToneMap/luminance_histogram_average", shaderParameters);
+
 		// Tone mapping program
 		Asset::loadShader(scene, "PostProcessing/ToneMap", "tonemap", "ToneMap/tonemap", shaderParameters);
 	}
@@ -61,6 +69,8 @@ namespace ToneMap
 	void initGPUBuffers(Scene::Scene& scene, Scene::Object* = nullptr)
 	{
 		Scene::createGPUBuffer(scene, "ToneMap", GL_UNIFORM_BUFFER, false, true, GPU::UniformBufferIndices::UNIFORM_BUFFER_GENERIC_1);
+		Scene::createGPUBuffer(scene, "ToneMapLuminanceHistogram", GL_SHADER_STORAGE_BUFFER, true, true, GPU::UniformBufferIndices::UNIFORM_BUFFER_GENERIC_2,
+			GL_DYNAMIC_STORAGE_BIT, sizeof(LuminanceHistogram), sizeof(GLuint));
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -388,6 +398,12 @@ namespace ToneMap
 				ImGui::Combo("Adaptation Method", &object->component<ToneMap::TonemapComponent>().m_adaptationMethod, ToneMap::TonemapComponent::AdaptationMethod_meta);
 				ImGui::SliderFloat("Adaptation Rate", &object->component<ToneMap::TonemapComponent>().m_adaptationRate, 0.0f, 16.0f);
 				ImGui::SliderFloat("Minimum Avg. Luminance", &object->component<ToneMap::TonemapComponent>().m_minAvgLuminance, 0.0f, 0.5f);
+				ImGui::Combo("Average Luminance Method", &object->component<ToneMap::TonemapComponent>().m_averageLuminanceMethod, ToneMap::TonemapComponent::AverageLuminanceMethod_meta);
+				if (object->component<ToneMap::TonemapComponent>().m_averageLuminanceMethod == ToneMap::TonemapComponent::HistogramAverage)
+				{
+					ImGui::DragFloatRange2("Histogram Log Luminance", &object->component<ToneMap::TonemapComponent>().m_histogramMinLogLuminance, &object->component<ToneMap::TonemapComponent>().m_histogramMaxLogLuminance, 0.1f, -20.0f, 20.0f);
+					ImGui::DragFloatRange2("Histogram Percentiles", &object->component<ToneMap::TonemapComponent>().m_histogramLowPercentile, &object->component<ToneMap::TonemapComponent>().m_histogramHighPercentile, 0.005f, 0.0f, 1.0f);
+				}
 				ImGui::SliderFloat("Local Luminance Mip Offset", &object->component<ToneMap::TonemapComponent>().m_localLuminanceMipOffset, 0.0f, numMipLevels(scene));
 				ImGui::SliderFloat("Max Local Luminance Contribution", &object->component<ToneMap::TonemapComponent>().m_maxLocalLuminanceContribution, 0.0f, 1.0f);
 				
@@ -614,6 +630,76 @@ namespace ToneMap
 			}
 		}
 
+		// Replace the global average luminance with the histogram-based one
+		if (object->component<ToneMap::TonemapComponent>().m_exposureMethod == ToneMap::TonemapComponent::AutoExposure &&
+			object->component<ToneMap::TonemapComponent>().m_averageLuminanceMethod == ToneMap::TonemapComponent::HistogramAverage)
+		{
+			Profiler::ScopedGpuPerfCounter perfCounter(scene, "Luminance Histogram");
+
+			const float minLogLuminance = object->component<ToneMap::TonemapComponent>().m_histogramMinLogLuminance;
+			const float logLuminanceRange = glm::max(object->component<ToneMap::TonemapComponent>().m_histogramMaxLogLuminance - minLogLuminance, 1e-3f);
+
+			// Clear the histogram
+			const GLuint zero = 0;
+			Scene::bindBuffer(scene, "ToneMapLuminanceHistogram");
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, scene.m_genericBuffers["ToneMapLuminanceHistogram"].m_buffer);
+			glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+			glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+			// Build the histogram
+			{
+				// Bind the scene texture
+				glActiveTexture(GPU::TextureEnums::TEXTURE_ALBEDO_MAP_ENUM);
+				glBindTexture(GL_TEXTURE_2D_ARRAY, scene.m_gbuffer[renderSettings->component<RenderSettings::RenderSettingsComponent>().m_gbufferWrite].m_colorTextures[scene.m_gbuffer[renderSettings->component<RenderSettings::RenderSettingsComponent>().m_gbufferWrite].m_readBuffer]);
+
+				// Bind the shader
+				Scene::bindShader(scene, "ToneMap", "luminance_histogram");
+
+				// Set the necessary uniforms
+				glUniform2iv(0, 1, glm::value_ptr(renderResolution));
+				glUniform1f(1, minLogLuminance);
+				glUniform1f(2, logLuminanceRange);
+
+				// Dispatch the shader
+				const glm::ivec2 workGroups = (renderResolution + 15) / 16;
+				glDispatchCompute(workGroups.x, workGroups.y, 1);
+
+				// sync barrier
+				glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+			}
+
+			// Evaluate the histogram into the top luminance mip level
+			{
+				// Top mip level and its dimensions
+				const unsigned mipLevel = unsigned(toneMapData.m_numMipLevels);
+				const glm::ivec2 mipDimension = glm::max(glm::ivec2(scene.m_textures[currLuminanceName].m_dimensions) >> int(mipLevel), glm::ivec2(1));
+
+				// Bind the previous luminance texture for adaptation
+				glActiveTexture(GPU::TextureEnums::TEXTURE_POST_PROCESS_1_ENUM);
+				glBindTexture(GL_TEXTURE_2D, scene.m_textures[prevLuminanceName].m_texture);
+
+				// Bind the target image
+				glBindImageTexture(0, scene.m_textures[currLuminanceName].m_texture, mipLevel, GL_TRUE, 0, GL_WRITE_ONLY, getLuminanceTextureFormat(scene, object));
+
+				// Bind the shader
+				Scene::bindShader(scene, "ToneMap", "luminance_histogram_average");
+
+				// Set the necessary uniforms
+				glUniform2iv(0, 1, glm::value_ptr(mipDimension));
+				glUniform1ui(1, mipLevel);
+				glUniform1f(2, minLogLuminance);
+				glUniform1f(3, logLuminanceRange);
+				glUniform1f(4, object->component<ToneMap::TonemapComponent>().m_histogramLowPercentile);
+				glUniform1f(5, object->component<ToneMap::TonemapComponent>().m_histogramHighPercentile);
+
+				// Dispatch the shader
+				glDispatchCompute(1, 1, 1);
+
+				// sync barrier
+				glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+			}
+		}
+
 		// Apply the tonemap operator
 		{
 			Profiler::ScopedGpuPerfCounter perfCounter(scene, "Operator Apply");
@@ -642,6 +728,108 @@ namespace ToneMap
 		RenderSettings::swapGbufferBuffers(scene, simulationSettings, renderSettings);
 	}
 
+	////////////////////////////////////////////////////////////////////////////////
+	size_t getLuminanceHistogramBin(const float luminance, const float minLogLuminance, const float logLuminanceRange)
+	{
+		if (luminance < 1e-5f) return 0;
+		const float t = glm::clamp((glm::log2(luminance) - minLogLuminance) / logLuminanceRange, 0.0f, 1.0f);
+		return glm::clamp(size_t(t * float(LUMINANCE_HISTOGRAM_BINS - 1)) + 1, size_t(1), LUMINANCE_HISTOGRAM_BINS - 1);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	float getLuminanceHistogramBinLogLuminance(const size_t bin, const float minLogLuminance, const float logLuminanceRange)
+	{
+		if (bin == 0) return minLogLuminance;
+		return minLogLuminance + (float(bin) - 0.5f) / float(LUMINANCE_HISTOGRAM_BINS - 1) * logLuminanceRange;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	LuminanceHistogram computeLuminanceHistogram(Scene::Scene& scene, Scene::Object* object, float const* pixels, const glm::ivec2 resolution, const int numChannels)
+	{
+		const float minLogLuminance = object->component<ToneMap::TonemapComponent>().m_histogramMinLogLuminance;
+		const float logLuminanceRange = glm::max(object->component<ToneMap::TonemapComponent>().m_histogramMaxLogLuminance - minLogLuminance, 1e-3f);
+
+		// Each block of rows is binned into its own histogram, which are merged afterwards
+		static constexpr int s_rowsPerWorkItem = 16;
+		const size_t numWorkItems = (resolution.y + s_rowsPerWorkItem - 1) / s_rowsPerWorkItem;
+		std::vector<LuminanceHistogram> partialHistograms(numWorkItems, LuminanceHistogram{});
+
+		Threading::threadedExecuteIndices(Threading::numThreads(),
+			[&](Threading::ThreadedExecuteEnvironment const& environment, const size_t workItemID)
+			{
+				LuminanceHistogram& histogram = partialHistograms[workItemID];
+				const int firstRow = int(workItemID) * s_rowsPerWorkItem;
+				const int lastRow = glm::min(firstRow + s_rowsPerWorkItem, resolution.y);
+				for (int y = firstRow; y < lastRow; ++y)
+				for (int x = 0; x < resolution.x; ++x)
+				{
+					float const* pixel = pixels + (size_t(y) * resolution.x + x) * numChannels;
+					const float luminance = glm::max(0.2125f * pixel[0] + 0.7154f * pixel[1] + 0.0721f * pixel[2], 0.0f);
+					++histogram[getLuminanceHistogramBin(luminance, minLogLuminance, logLuminanceRange)];
+				}
+			},
+			numWorkItems);
+
+		// Merge the partial histograms
+		LuminanceHistogram result{};
+		for (auto const& histogram : partialHistograms)
+		for (size_t bin = 0; bin < LUMINANCE_HISTOGRAM_BINS; ++bin)
+			result[bin] += histogram[bin];
+		return result;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	glm::vec2 evaluateLuminanceHistogram(Scene::Scene& scene, Scene::Object* object, LuminanceHistogram const& histogram)
+	{
+		const float minLogLuminance = object->component<ToneMap::TonemapComponent>().m_histogramMinLogLuminance;
+		const float logLuminanceRange = glm::max(object->component<ToneMap::TonemapComponent>().m_histogramMaxLogLuminance - minLogLuminance, 1e-3f);
+
+		float numPixels = 0.0f;
+		for (size_t bin = 0; bin < LUMINANCE_HISTOGRAM_BINS; ++bin)
+			numPixels += float(histogram[bin]);
+
+		// Average the log luminance of the pixels between the two percentiles
+		const float lowCount = numPixels * object->component<ToneMap::TonemapComponent>().m_histogramLowPercentile;
+		const float highCount = numPixels * object->component<ToneMap::TonemapComponent>().m_histogramHighPercentile;
+		float accumulated = 0.0f;
+		float logLuminanceSum = 0.0f;
+		float weightSum = 0.0f;
+		float maxLogLuminance = minLogLuminance;
+		for (size_t bin = 0; bin < LUMINANCE_HISTOGRAM_BINS; ++bin)
+		{
+			const float count = float(histogram[bin]);
+			const float binLogLuminance = getLuminanceHistogramBinLogLuminance(bin, minLogLuminance, logLuminanceRange);
+			const float weight = glm::max(glm::min(accumulated + count, highCount) - glm::max(accumulated, lowCount), 0.0f);
+			logLuminanceSum += weight * binLogLuminance;
+			weightSum += weight;
+			if (count > 0.0f && accumulated < highCount) maxLogLuminance = binLogLuminance;
+			accumulated += count;
+		}
+
+		return glm::vec2(
+			glm::exp2(weightSum > 0.0f ? logLuminanceSum / weightSum : minLogLuminance),
+			glm::exp2(maxLogLuminance));
+	}
+
+	////////////////////////////////////////////////////////////////////////////////
+	float computeAutoExposure(Scene::Scene& scene, Scene::Object* object, const float avgLuminance)
+	{
+		// Fixed exposure
+		if (object->component<ToneMap::TonemapComponent>().m_exposureMethod == ToneMap::TonemapComponent::FixedExposure)
+			return glm::max(object->component<ToneMap::TonemapComponent>().m_fixedExposure, 0.0001f);
+
+		const float luminance = glm::max(avgLuminance, object->component<ToneMap::TonemapComponent>().m_minAvgLuminance);
+
+		// Compute the key value
+		const float keyValue = object->component<ToneMap::TonemapComponent>().m_keyMethod == ToneMap::TonemapComponent::AutoKey ?
+			1.03f - (2.0f / (2.0f + glm::log(luminance + 1.0f) / glm::log(10.0f))) :
+			object->component<ToneMap::TonemapComponent>().m_fixedKey;
+
+		// Compute the linear exposure
+		const float linearExposure = keyValue / luminance;
+		return glm::exp2(glm::log2(glm::max(linearExposure, 0.0001f)) + object->component<ToneMap::TonemapComponent>().m_exposureBias);
+	}
+
 	////////////////////////////////////////////////////////////////////////////////
 	void clearLuminanceMaps(Scene::Scene& scene, Scene::Object* object)
 	{
@@ -18,6 +18,14 @@ namespace ToneMap
 	static constexpr const char* DISPLAY_NAME = "Tonemap";
 	static constexpr const char* CATEGORY = "Post Processing";
 
+	////////////////////////////////////////////////////////////////////////////////
+	/** Number of bins in the luminance histogram. */
+	static constexpr size_t LUMINANCE_HISTOGRAM_BINS = 128;
+
+	////////////////////////////////////////////////////////////////////////////////
+	/** Pixel counts of a luminance histogram. */
+	using LuminanceHistogram = std::array<uint32_t, LUMINANCE_HISTOGRAM_BINS>;
+
 	////////////////////////////////////////////////////////////////////////////////
 	/** Reinhard tone map settings. */
 	struct ReinhardToneMapSettings
@@ -87,6 +95,9 @@ namespace ToneMap
 		// What components to store in the luminance texture
 		meta_enum(LuminanceComponents, int, AvgLuminance, AvgMaxLuminance);
 
+		// How the global average luminance is computed
+		meta_enum(AverageLuminanceMethod, int, MipmapAverage, HistogramAverage);
+
 		// Luminance update method
 		AdaptationMethod m_adaptationMethod = Lerp;
 
@@ -96,6 +107,17 @@ namespace ToneMap
 		// Which luminance components to store
 		LuminanceComponents m_luminanceComponents = AvgLuminance;
 
+		// Global average luminance method
+		AverageLuminanceMethod m_averageLuminanceMethod = MipmapAverage;
+
+		// Log2 luminance range covered by the luminance histogram
+		float m_histogramMinLogLuminance = -10.0f;
+		float m_histogramMaxLogLuminance = 10.0f;
+
+		// Pixels below the low and above the high percentile are ignored by the histogram average
+		float m_histogramLowPercentile = 0.5f;
+		float m_histogramHighPercentile = 0.95f;
+
 		// The fixed key exposure
 		float m_fixedExposure = 10.0f;
 
@@ -182,6 +204,18 @@ namespace ToneMap
 
 	////////////////////////////////////////////////////////////////////////////////
 	void clearLuminanceMaps(Scene::Scene& scene, Scene::Object* object);
+
+	////////////////////////////////////////////////////////////////////////////////
+	/** Builds the luminance histogram of an interleaved float image on the CPU, matching the GPU histogram pass. */
+	LuminanceHistogram computeLuminanceHistogram(Scene::Scene& scene, Scene::Object* object, float const* pixels, const glm::ivec2 resolution, const int numChannels);
+
+	////////////////////////////////////////////////////////////////////////////////
+	/** Returns the percentile-trimmed average and the high-percentile luminance of a luminance histogram. */
+	glm::vec2 evaluateLuminanceHistogram(Scene::Scene& scene, Scene::Object* object, LuminanceHistogram const& histogram);
+
+	////////////////////////////////////////////////////////////////////////////////
+	/** Returns the auto exposure multiplier for the parameter average luminance, matching the tonemap shader. */
+	float computeAutoExposure(Scene::Scene& scene, Scene::Object* object, const float avgLuminance);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
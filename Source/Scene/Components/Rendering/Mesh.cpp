@@ -145,6 +145,10 @@ namespace Mesh
 			Asset::loadMesh(scene, object->component<Mesh::MeshComponent>().m_meshName);
 			updateMaterialList(scene, object);
 		}
+		if (ImGui::Checkbox("Static", &object->component<Mesh::MeshComponent>().m_static))
+		{
+			RenderSettings::updateVoxelGrid(scene);
+		}
 
 		if (ImGui::TreeNode("Materials"))
 		{
@@ -464,7 +468,8 @@ namespace Mesh
 	////////////////////////////////////////////////////////////////////////////////
 	bool voxelBasePassObjectCondition(Scene::Scene& scene, Scene::Object* simulationSettings, Scene::Object* renderSettings, Scene::Object* camera, std::string const& functionName, Scene::Object* object)
 	{
-		return isMeshValid(scene, object) && RenderSettings::firstCallObjectCondition(scene, simulationSettings, renderSettings, camera, functionName, object);
+		return isMeshValid(scene, object) && !VoxelGlobalIllumination::isMeshVoxelizedOnCpu(scene, object) &&
+			RenderSettings::firstCallObjectCondition(scene, simulationSettings, renderSettings, camera, functionName, object);
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -23,6 +23,9 @@ namespace Mesh
 		// Name of the mesh.
 		std::string m_meshName = "sphere.obj";
 
+		// Whether the mesh is static; static meshes can be voxelized once and cached, but must not move
+		bool m_static = false;
+
 		// ---- Private members
 
 		std::string m_lastMeshName;
@@ -1725,6 +1725,7 @@ namespace GuiSettings
 				ImGui::SameLine();
 				if (ImGui::Button("Clear"))
 				{
+					auto logLock = Debug::lockLogDevices();
 					Debug::logger_impl::debug_only_inmemory_buffer.clear();
 					Debug::logger_impl::debug_full_inmemory_buffer.clear();
 					Debug::logger_impl::trace_only_inmemory_buffer.clear();
@@ -1776,6 +1777,9 @@ namespace GuiSettings
 				// Set it to two column mode
 				ImGui::Columns(numCols, 0, ImGuiColumnsFlags_NoBorder | ImGuiColumnsFlags_NoResize);
 
+				// Keep the log writer out of the buffers while they are being displayed
+				auto logLock = Debug::lockLogDevices();
+
 				// Generate the log messages
 				if (guiSettings->component<GuiSettings::GuiSettingsComponent>().m_logOutputSettings.m_longMessages)
 					generateLogMessagesSlow(scene, guiSettings, buffer);
@@ -1805,6 +1809,7 @@ namespace GuiSettings
 				ImGui::SameLine();
 				if (ImGui::Button("Clear"))
 				{
+					auto logLock = Debug::lockLogDevices();
 					Debug::logger_impl::debug_only_inmemory_buffer.clear();
 					Debug::logger_impl::debug_full_inmemory_buffer.clear();
 					Debug::logger_impl::trace_only_inmemory_buffer.clear();
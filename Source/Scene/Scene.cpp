@@ -1767,6 +1767,8 @@ namespace Scene
 	////////////////////////////////////////////////////////////////////////////////
 	void teardownScene(Scene& scene)
 	{
+		// Make sure all the pending image writes are finished
+		Asset::waitForImageWrites(scene);
 	}
 
 	////////////////////////////////////////////////////////////////////////////////
@@ -115,6 +115,12 @@ namespace Scene
 		// Imgui styles.
 		std::unordered_map<std::string, ImGuiStyle> m_guiStyles;
 
+		// Image writes still being encoded and written on worker threads; only accessed from the main thread.
+		std::vector<std::future<bool>> m_pendingImageWrites;
+
+		// Number of image writes that failed since the last Asset::waitForImageWrites call.
+		size_t m_numFailedImageWrites = 0;
+
 		////////////////////////////////////////////////////////////////////////////////
 
 		struct ResourceInitializer